@@ -0,0 +1,405 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: Bench.cpp
+ * --------------------------
+ * This file is a headless benchmark of the solvers. It runs every disaster map and matchmaker graph
+ * bundled in Data/ through every solver that can answer it and reports the median and 95th
+ * percentile time of each as CSV or JSON. It links only the solvers and FastMatching, so it builds
+ * on a server without Qt's GUI or the Stanford library and gives every change a number to compare.
+ *
+ *      - Every run builds its solver from the network and then solves, and both are timed. Solvers
+ *        keep what they learn between searches, so reusing one would time a warm cache instead.
+ *      - Warmup runs are not reported. Repetitions are sorted and the 95th percentile is the
+ *        nearest rank.
+ *      - The minimum supply and perfect matching searches stop at the timeout and are reported as
+ *        aborted. The virtually impossible maps need this. Other solvers have no limits to give.
+ *      - Parallel variants also report the nodes each thread entered in the last run so the load
+ *        balance of work stealing can be checked. Serial solvers leave that column empty.
+ *      - The parallel disaster variants only decide if a cover beats the greedy cover. When none
+ *        does their status is "greedy optimal" rather than "infeasible", which would read as if
+ *        the solver failed.
+ *
+ * Usage: Bench [--data DIR] [--filter TEXT] [--warmup N] [--reps N] [--timeout SECONDS]
+ *              [--format csv|json] [--output FILE]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GUI/SimpleTest.h"
+#include "Src/DisasterBits.h"
+#include "Src/DisasterHeuristic.h"
+#include "Src/DisasterLinks.h"
+#include "Src/DisasterTags.h"
+#include "Src/PartnerLinks.h"
+#include "FastMatching/FastMatchmaker.h"
+#include "BenchCorpus.h"
+
+#ifndef DLX_BENCH_DATA
+#define DLX_BENCH_DATA "../Data"
+#endif
+
+namespace Dx = DancingLinks;
+
+// The matchmaker GUI prints pairs for the solvers. Without the GUI the benchmark must do it.
+std::ostream& operator<< (std::ostream& out, const Pair& pair) {
+    return out << "{ \"" << pair.first() << "\", \"" << pair.second() << "\" }";
+}
+
+namespace {
+
+struct BenchOptions {
+    std::string dataDirectory = DLX_BENCH_DATA;
+    std::string filter = "";
+    int warmup = 1;
+    int repetitions = 5;
+    double timeoutSeconds = 10.0;
+    std::string format = "csv";
+    std::string output = "";
+};
+
+// What one run of a solver found. The answer is a number of supplies, pairs, or a total weight.
+struct Outcome {
+    Dx::SearchStatus status;
+    long long answer;
+    // The nodes each thread entered. Empty for a serial solver.
+    std::vector<long long> workerNodes;
+    // Reported instead of the status when a variant asks a question of its own. Null otherwise.
+    const char* statusLabel = nullptr;
+};
+
+struct BenchResult {
+    std::string corpus;
+    std::string instance;
+    std::string solver;
+    Outcome outcome;
+    int runs;
+    double medianMs;
+    double p95Ms;
+    double minMs;
+};
+
+using Run = std::function<Outcome(const Dx::SearchLimits&)>;
+
+const char* statusName(const Outcome& outcome) {
+    if (outcome.statusLabel) {
+        return outcome.statusLabel;
+    }
+    switch (outcome.status) {
+        case Dx::SearchStatus::FOUND:
+            return "found";
+        case Dx::SearchStatus::INFEASIBLE:
+            return "infeasible";
+        default:
+            return "aborted";
+    }
+}
+
+BenchOptions parseOptions(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if (flag == "--help") {
+            std::cout << "Usage: " << argv[0] << " [--data DIR] [--filter TEXT] [--warmup N]"
+                      << " [--reps N] [--timeout SECONDS] [--format csv|json] [--output FILE]\n";
+            std::exit(0);
+        }
+        if (i + 1 == argc) {
+            error("Missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--data") {
+            options.dataDirectory = value;
+        } else if (flag == "--filter") {
+            options.filter = value;
+        } else if (flag == "--warmup") {
+            options.warmup = std::stoi(value);
+        } else if (flag == "--reps") {
+            options.repetitions = std::stoi(value);
+        } else if (flag == "--timeout") {
+            options.timeoutSeconds = std::stod(value);
+        } else if (flag == "--format") {
+            options.format = value;
+        } else if (flag == "--output") {
+            options.output = value;
+        } else {
+            error("Unknown option " + flag);
+        }
+    }
+    if (options.warmup < 0 || options.repetitions < 1) {
+        error("Need zero or more warmup runs and at least one repetition.");
+    }
+    if (options.format != "csv" && options.format != "json") {
+        error("The format must be csv or json.");
+    }
+    return options;
+}
+
+
+/* * * * * * * * * * * * * * * * * * *    Timing the Solvers    * * * * * * * * * * * * * * * * * * */
+
+
+Outcome timeRun(const BenchOptions& options, const Run& run, double& elapsedMs) {
+    Dx::SearchLimits limits;
+    auto start = std::chrono::steady_clock::now();
+    limits.deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(options.timeoutSeconds));
+    Outcome outcome = run(limits);
+    auto stop = std::chrono::steady_clock::now();
+    elapsedMs = std::chrono::duration<double, std::milli>(stop - start).count();
+    return outcome;
+}
+
+BenchResult measure(const BenchOptions& options,
+                    const std::string& corpus,
+                    const std::string& instance,
+                    const std::string& solver,
+                    const Run& run) {
+    BenchResult result = {corpus, instance, solver, {Dx::SearchStatus::FOUND, 0, {}}, 0, 0, 0, 0};
+    std::vector<double> samples = {};
+    double elapsedMs = 0;
+    for (int i = 0; i < options.warmup; i++) {
+        result.outcome = timeRun(options, run, elapsedMs);
+        // Every repetition would run into the same timeout so report the one we saw.
+        if (result.outcome.status == Dx::SearchStatus::ABORTED) {
+            samples.push_back(elapsedMs);
+            break;
+        }
+    }
+    if (result.outcome.status != Dx::SearchStatus::ABORTED) {
+        for (int i = 0; i < options.repetitions; i++) {
+            result.outcome = timeRun(options, run, elapsedMs);
+            samples.push_back(elapsedMs);
+            if (result.outcome.status == Dx::SearchStatus::ABORTED) {
+                break;
+            }
+        }
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    result.runs = n;
+    result.medianMs = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    result.p95Ms = samples[std::max<size_t>(1, std::ceil(0.95 * n)) - 1];
+    result.minMs = samples.front();
+    return result;
+}
+
+
+/* * * * * * * * * * * * * * * * * * *    Solver Variants     * * * * * * * * * * * * * * * * * * */
+
+
+template <typename Solver>
+Run minimumSupplies(const std::map<std::string, std::set<std::string>>& roadNetwork) {
+    return [&roadNetwork](const Dx::SearchLimits& limits) -> Outcome {
+        Solver solver(roadNetwork);
+        std::set<std::string> supplies = {};
+        Dx::SearchStatus status = solver.findMinimumSupplies(supplies, limits);
+        return {status, (long long)supplies.size(), {}};
+    };
+}
+
+// The two work stealing solvers name their threaded decision search differently.
+Dx::SearchStatus decideInParallel(Dx::DisasterLinks& links, int numSupplies,
+                                  std::set<std::string>& supplies, const Dx::SearchLimits& limits) {
+    return links.isDisasterReady(numSupplies, supplies, 0, limits);
+}
+
+Dx::SearchStatus decideInParallel(Dx::DisasterTags& tags, int numSupplies,
+                                  std::set<std::string>& supplies, const Dx::SearchLimits& limits) {
+    return tags.hasDisasterCoverage(numSupplies, supplies, 0, limits);
+}
+
+// The parallel search only decides, so it asks whether any cover beats the greedy cover.
+template <typename Solver>
+Run beatGreedyParallel(const std::map<std::string, std::set<std::string>>& roadNetwork) {
+    return [&roadNetwork](const Dx::SearchLimits& limits) -> Outcome {
+        std::set<std::string> greedy = {};
+        int greedyCount = Dx::DisasterHeuristic(roadNetwork).getSupplies(greedy);
+        Solver solver(roadNetwork);
+        std::set<std::string> supplies = {};
+        Dx::SearchStatus status = decideInParallel(solver, std::max(0, greedyCount - 1),
+                                                   supplies, limits);
+        if (status == Dx::SearchStatus::INFEASIBLE) {
+            // No cover beats the greedy one, which proves the greedy cover optimal.
+            return {status, greedyCount, solver.getWorkerNodes(), "greedy optimal"};
+        }
+        long long answer = status == Dx::SearchStatus::FOUND ? supplies.size() : greedyCount;
+        return {status, answer, solver.getWorkerNodes()};
+    };
+}
+
+std::vector<std::pair<std::string, Run>> disasterSolvers(const Bench::DisasterInstance& map) {
+    return {
+        {"DisasterLinks", minimumSupplies<Dx::DisasterLinks>(map.roadNetwork)},
+        {"DisasterTags", minimumSupplies<Dx::DisasterTags>(map.roadNetwork)},
+        {"DisasterBits", minimumSupplies<Dx::DisasterBits>(map.roadNetwork)},
+        {"DisasterLinks-parallel", beatGreedyParallel<Dx::DisasterLinks>(map.roadNetwork)},
+        {"DisasterTags-parallel", beatGreedyParallel<Dx::DisasterTags>(map.roadNetwork)},
+        {"DisasterHeuristic", [&map](const Dx::SearchLimits&) -> Outcome {
+            std::set<std::string> supplies = {};
+            Dx::DisasterHeuristic heuristic(map.roadNetwork);
+            return {Dx::SearchStatus::FOUND, heuristic.getSupplies(supplies), {}};
+        }},
+    };
+}
+
+long long totalWeight(const Bench::MatchingInstance& graph, const std::set<Pair>& matching) {
+    long long weight = 0;
+    for (const Pair& pair : matching) {
+        weight += graph.weightedLinks.at(pair.first()).at(pair.second());
+    }
+    return weight;
+}
+
+std::vector<std::pair<std::string, Run>> matchingSolvers(const Bench::MatchingInstance& graph) {
+    return {
+        {"PartnerLinks-perfect", [&graph](const Dx::SearchLimits& limits) -> Outcome {
+            Dx::PartnerLinks links(graph.possibleLinks);
+            std::set<Pair> matching = {};
+            Dx::SearchStatus status = links.hasPerfectLinks(matching, limits);
+            return {status, (long long)matching.size(), {}};
+        }},
+        {"PartnerLinks-perfect-parallel", [&graph](const Dx::SearchLimits& limits) -> Outcome {
+            Dx::PartnerLinks links(graph.possibleLinks);
+            std::set<Pair> matching = {};
+            Dx::SearchStatus status = links.hasPerfectLinks(matching, 0, limits);
+            return {status, (long long)matching.size(), links.getWorkerNodes()};
+        }},
+        {"FastMatching-perfect", [&graph](const Dx::SearchLimits&) -> Outcome {
+            std::set<Pair> matching = {};
+            bool isPerfect = hasFastPerfectMatching(graph.possibleLinks, matching);
+            return {isPerfect ? Dx::SearchStatus::FOUND : Dx::SearchStatus::INFEASIBLE,
+                    isPerfect ? (long long)matching.size() : 0, {}};
+        }},
+        {"PartnerLinks-maxweight", [&graph](const Dx::SearchLimits&) -> Outcome {
+            Dx::PartnerLinks links(graph.weightedLinks);
+            return {Dx::SearchStatus::FOUND, totalWeight(graph, links.getMaxWeightMatching()), {}};
+        }},
+        {"FastMatching-maxweight", [&graph](const Dx::SearchLimits&) -> Outcome {
+            return {Dx::SearchStatus::FOUND,
+                    totalWeight(graph, fastMaxWeightMatching(graph.weightedLinks)), {}};
+        }},
+    };
+}
+
+
+/* * * * * * * * * * * * * * * * * * * *    Reporting     * * * * * * * * * * * * * * * * * * * * */
+
+
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text) {
+        quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+    }
+    return quoted + "\"";
+}
+
+std::string joinNodes(const std::vector<long long>& nodes, const std::string& separator) {
+    std::string joined = "";
+    for (size_t i = 0; i < nodes.size(); i++) {
+        joined += (i ? separator : "") + std::to_string(nodes[i]);
+    }
+    return joined;
+}
+
+void printCsv(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "corpus,instance,solver,status,answer,runs,median_ms,p95_ms,min_ms,worker_nodes\n";
+    for (const BenchResult& r : results) {
+        out << csvField(r.corpus) << ',' << csvField(r.instance) << ',' << csvField(r.solver)
+            << ',' << statusName(r.outcome) << ',' << r.outcome.answer << ',' << r.runs
+            << ',' << r.medianMs << ',' << r.p95Ms << ',' << r.minMs
+            << ',' << joinNodes(r.outcome.workerNodes, ";") << '\n';
+    }
+}
+
+void printJson(std::ostream& out, const BenchOptions& options,
+               const std::vector<BenchResult>& results) {
+    out << "{\n  \"warmup\": " << options.warmup << ",\n  \"repetitions\": "
+        << options.repetitions << ",\n  \"timeout_seconds\": " << options.timeoutSeconds
+        << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"corpus\": " << jsonString(r.corpus)
+            << ", \"instance\": " << jsonString(r.instance)
+            << ", \"solver\": " << jsonString(r.solver)
+            << ", \"status\": " << jsonString(statusName(r.outcome))
+            << ", \"answer\": " << r.outcome.answer << ", \"runs\": " << r.runs
+            << ", \"median_ms\": " << r.medianMs << ", \"p95_ms\": " << r.p95Ms
+            << ", \"min_ms\": " << r.minMs
+            << ", \"worker_nodes\": [" << joinNodes(r.outcome.workerNodes, ", ") << "]}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+bool isSelected(const BenchOptions& options, const std::string& name) {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        BenchOptions options = parseOptions(argc, argv);
+        std::vector<BenchResult> results = {};
+        // Progress goes to the error stream so the report on the output stream stays clean.
+        for (const auto& map : Bench::loadDisasterMaps(options.dataDirectory
+                                                        + "/disaster-planning")) {
+            for (const auto& solver : disasterSolvers(map)) {
+                if (isSelected(options, map.name + "/" + solver.first)) {
+                    std::cerr << map.name << " " << solver.first << std::endl;
+                    results.push_back(measure(options, "disaster-planning", map.name,
+                                              solver.first, solver.second));
+                }
+            }
+        }
+        for (const auto& graph : Bench::loadMatchmakerGraphs(options.dataDirectory
+                                                             + "/matchmaker")) {
+            for (const auto& solver : matchingSolvers(graph)) {
+                if (isSelected(options, graph.name + "/" + solver.first)) {
+                    std::cerr << graph.name << " " << solver.first << std::endl;
+                    results.push_back(measure(options, "matchmaker", graph.name,
+                                              solver.first, solver.second));
+                }
+            }
+        }
+
+        std::ofstream file;
+        if (!options.output.empty()) {
+            file.open(options.output);
+            if (!file) {
+                error("Could not open " + options.output);
+            }
+        }
+        std::ostream& out = options.output.empty() ? std::cout : file;
+        out << std::fixed << std::setprecision(3);
+        if (options.format == "json") {
+            printJson(out, options, results);
+        } else {
+            printCsv(out, results);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Bench: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+###############################################################################
+# Project file for the headless benchmark of the dancing links solvers
+#
+# Builds a console program from the solvers in Src/ and FastMatching/ alone.
+# It needs neither Qt's GUI modules nor the CS106 library, so any machine
+# with qmake and a C++17 compiler can build it:
+#
+#   qmake Bench.pro && make
+#   ./Bench --format json --output results.json
+###############################################################################
+
+TEMPLATE    =   app
+TARGET      =   Bench
+CONFIG      +=  console c++17 release thread warn_on
+CONFIG      -=  qt app_bundle debug
+
+# Bench/ comes first so "GUI/SimpleTest.h" finds the stand-in for the CS106
+# header. The project root follows for the Src/ and FastMatching/ includes.
+INCLUDEPATH +=  $$PWD $$PWD/..
+
+# The corpora bundled with the project are the default data to run.
+DEFINES     +=  DLX_BENCH_DATA=\\\"$$PWD/../Data\\\"
+# Uncomment to build the solvers with their search statistics counted.
+# DEFINES   +=  DLX_SEARCH_STATS
+
+SOURCES     +=  \
+    Bench.cpp \
+    BenchCorpus.cpp \
+    $$files($$PWD/../Src/*.cpp) \
+    $$files($$PWD/../FastMatching/*.cpp)
+HEADERS     +=  \
+    BenchCorpus.h \
+    GUI/SimpleTest.h \
+    $$files($$PWD/../Src/*.h) \
+    $$files($$PWD/../FastMatching/*.h)
+
+QMAKE_CXXFLAGS_RELEASE      -=  -O2
+QMAKE_CXXFLAGS_RELEASE      +=  -O3
+QMAKE_CXXFLAGS_WARN_ON      +=  -Wno-sign-compare
+QMAKE_CXXFLAGS_WARN_ON      +=  -Wno-unused-parameter
+
+# Older g++ keeps std::filesystem in a separate library.
+*-g++ {
+    versionAtMost(QMAKE_GCC_MAJOR_VERSION, 8): LIBS += -lstdc++fs
+}
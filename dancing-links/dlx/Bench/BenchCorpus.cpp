@@ -0,0 +1,200 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: BenchCorpus.cpp
+ * --------------------------
+ * This file contains the readers for the disaster maps and matchmaker graphs. The JSON reader is
+ * not general. It finds the arrays of nodes and edges and reads the fields it needs from each
+ * object, which is all the graph editor ever writes.
+ */
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "GUI/SimpleTest.h"
+#include "BenchCorpus.h"
+
+namespace Bench {
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::string readFile(const std::filesystem::path& file) {
+    std::ifstream in(file);
+    if (!in) {
+        error("Could not open " + file.string());
+    }
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+std::vector<std::filesystem::path> listFiles(const std::string& directory,
+                                             const std::string& extension) {
+    std::vector<std::filesystem::path> files = {};
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file()
+                && (extension.empty() || entry.path().extension() == extension)) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+
+/* * * * * * * * * * * * * * * * * * *    Disaster Maps     * * * * * * * * * * * * * * * * * * * */
+
+
+void parseCityLine(const std::string& line,
+                   std::map<std::string, std::set<std::string>>& roadNetwork) {
+    size_t colon = line.find(':');
+    if (colon == std::string::npos || line.find(':', colon + 1) != std::string::npos) {
+        error("Each data line should have exactly one colon on it: " + line);
+    }
+    // The location in parentheses only places the city in the GUI.
+    std::string name = trim(line.substr(0, std::min(line.find('('), colon)));
+    if (name.empty()) {
+        error("City names can't be empty: " + line);
+    }
+    std::set<std::string>& links = roadNetwork[name];
+    std::stringstream linkList(line.substr(colon + 1));
+    for (std::string link; std::getline(linkList, link, ',');) {
+        link = trim(link);
+        if (!link.empty()) {
+            links.insert(link);
+        }
+    }
+}
+
+DisasterInstance loadDisasterMap(const std::filesystem::path& file) {
+    DisasterInstance instance = {file.stem().string(), {}};
+    std::stringstream lines(readFile(file));
+    for (std::string line; std::getline(lines, line);) {
+        if (trim(line).empty() || line[0] == '#') {
+            continue;
+        }
+        parseCityLine(line, instance.roadNetwork);
+    }
+    // Files may list a road in one direction only so we add every road in reverse.
+    for (const auto& city : instance.roadNetwork) {
+        for (const std::string& link : city.second) {
+            if (!instance.roadNetwork.count(link)) {
+                error("Outgoing link found to nonexistent city '" + link + "' in " + file.string());
+            }
+        }
+    }
+    for (const auto& city : instance.roadNetwork) {
+        for (const std::string& link : city.second) {
+            instance.roadNetwork[link].insert(city.first);
+        }
+    }
+    return instance;
+}
+
+
+/* * * * * * * * * * * * * * * * * *     Matchmaker Graphs      * * * * * * * * * * * * * * * * * */
+
+
+// The objects of a top level JSON array as raw text. Objects inside strings are not objects.
+std::vector<std::string> arrayObjects(const std::string& json, const std::string& key) {
+    std::vector<std::string> objects = {};
+    size_t at = json.find("\"" + key + "\"");
+    if (at == std::string::npos || (at = json.find('[', at)) == std::string::npos) {
+        return objects;
+    }
+    int depth = 0;
+    size_t begin = 0;
+    bool isInString = false;
+    for (size_t i = at + 1; i < json.size(); i++) {
+        char c = json[i];
+        if (isInString) {
+            if (c == '\\') {
+                i++;
+            } else if (c == '"') {
+                isInString = false;
+            }
+        } else if (c == '"') {
+            isInString = true;
+        } else if (c == '{' && depth++ == 0) {
+            begin = i;
+        } else if (c == '}' && --depth == 0) {
+            objects.push_back(json.substr(begin, i - begin + 1));
+        } else if (c == ']' && depth == 0) {
+            break;
+        }
+    }
+    return objects;
+}
+
+// The value of a field of a flat JSON object with the quotes of a string value removed.
+std::string field(const std::string& object, const std::string& key) {
+    size_t at = object.find("\"" + key + "\"");
+    if (at == std::string::npos || (at = object.find(':', at)) == std::string::npos) {
+        error("Graph object has no field '" + key + "': " + object);
+    }
+    at = object.find_first_not_of(" \t\r\n", at + 1);
+    if (at != std::string::npos && object[at] == '"') {
+        std::string value = {};
+        for (size_t i = at + 1; i < object.size() && object[i] != '"'; i++) {
+            if (object[i] == '\\' && i + 1 < object.size()) {
+                i++;
+            }
+            value += object[i];
+        }
+        return value;
+    }
+    return trim(object.substr(at, object.find_first_of(",}", at) - at));
+}
+
+MatchingInstance loadMatchmakerGraph(const std::filesystem::path& file) {
+    MatchingInstance instance = {file.filename().string(), {}, {}};
+    const std::string json = readFile(file);
+    std::map<int, std::string> people = {};
+    for (const std::string& node : arrayObjects(json, "nodes")) {
+        std::string name = field(node, "label");
+        people[std::stoi(field(node, "index"))] = name;
+        instance.possibleLinks[name];
+        instance.weightedLinks[name];
+    }
+    for (const std::string& edge : arrayObjects(json, "edges")) {
+        auto from = people.find(std::stoi(field(edge, "from")));
+        auto to = people.find(std::stoi(field(edge, "to")));
+        if (from == people.end() || to == people.end()) {
+            error("Edge joins a node that does not exist in " + file.string());
+        }
+        int weight = std::stoi(field(edge, "label"));
+        instance.possibleLinks[from->second].insert(to->second);
+        instance.possibleLinks[to->second].insert(from->second);
+        instance.weightedLinks[from->second][to->second] = weight;
+        instance.weightedLinks[to->second][from->second] = weight;
+    }
+    return instance;
+}
+
+} // namespace
+
+std::vector<DisasterInstance> loadDisasterMaps(const std::string& directory) {
+    std::vector<DisasterInstance> maps = {};
+    for (const std::filesystem::path& file : listFiles(directory, ".dst")) {
+        maps.push_back(loadDisasterMap(file));
+    }
+    return maps;
+}
+
+std::vector<MatchingInstance> loadMatchmakerGraphs(const std::string& directory) {
+    std::vector<MatchingInstance> graphs = {};
+    for (const std::filesystem::path& file : listFiles(directory, "")) {
+        graphs.push_back(loadMatchmakerGraph(file));
+    }
+    return graphs;
+}
+
+} // namespace Bench
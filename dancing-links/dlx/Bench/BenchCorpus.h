@@ -0,0 +1,51 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: BenchCorpus.h
+ * --------------------------
+ * This file defines the readers for the maps and graphs the benchmark runs. The GUI reads the same
+ * files with the Stanford library, which the benchmark must not depend on, so these readers only
+ * use the standard library. They read just enough of each format to build the networks the solvers
+ * accept. City locations and the positions of people in the matchmaker graphs are ignored.
+ *
+ *      - A disaster map (.dst) has one city per line as "Name (X, Y): Link1, Link2, ..., LinkN".
+ *        Blank lines and lines starting with # are skipped. Roads run in both directions.
+ *      - A matchmaker graph is the JSON the graph editor saves. Every node has an index and a
+ *        label, and every edge joins the indices of two nodes with a label holding its weight.
+ */
+#ifndef BENCHCORPUS_H
+#define BENCHCORPUS_H
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+struct DisasterInstance {
+    std::string name;
+    std::map<std::string, std::set<std::string>> roadNetwork;
+};
+
+struct MatchingInstance {
+    std::string name;
+    std::map<std::string, std::set<std::string>> possibleLinks;
+    std::map<std::string, std::map<std::string, int>> weightedLinks;
+};
+
+/**
+ * @brief loadDisasterMaps  reads every .dst file in a directory in the order of their names.
+ * @param directory         the directory holding the disaster planning maps.
+ * @return                  the road network of every map named by its file.
+ */
+std::vector<DisasterInstance> loadDisasterMaps(const std::string& directory);
+
+/**
+ * @brief loadMatchmakerGraphs  reads every file in a directory in the order of their names.
+ * @param directory             the directory holding the graphs saved by the graph editor.
+ * @return                      the possible and weighted links of every graph named by its file.
+ */
+std::vector<MatchingInstance> loadMatchmakerGraphs(const std::string& directory);
+
+} // namespace Bench
+
+#endif // BENCHCORPUS_H
@@ -0,0 +1,29 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: SimpleTest.h
+ * --------------------------
+ * This file stands in for the SimpleTest header of the Stanford library when the solvers are built
+ * without it. The solvers only need two things from that header: the error function that reports
+ * bad input and the macro that lets tests see private members. The benchmark runs no tests, so the
+ * macro is empty and error throws an exception just as the library's version does.
+ *
+ * The benchmark project lists this directory before the project root so every include of
+ * "GUI/SimpleTest.h" in Src/ finds this file instead of the real one.
+ */
+#ifndef BENCH_SIMPLETEST_H
+#define BENCH_SIMPLETEST_H
+#include <stdexcept>
+#include <string>
+
+class ErrorException : public std::runtime_error {
+public:
+    explicit ErrorException(const std::string& message) : std::runtime_error(message) {}
+};
+
+[[noreturn]] inline void error(const std::string& message) {
+    throw ErrorException(message);
+}
+
+#define ALLOW_TEST_ACCESS()
+
+#endif // BENCH_SIMPLETEST_H
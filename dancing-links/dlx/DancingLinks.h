@@ -172,6 +172,17 @@
  * fields.
  *
  *
+ * DisasterBits
+ * -------------------
+ *
+ * The same search as above without the links. Each row of the matrix is stored as a bitset of the
+ * cities it covers and the cities left to cover are one more bitset. Supplying a city clears its
+ * row from a copy of the uncovered cities for the next level of the search, so backtracking is just
+ * returning to the copy above. Cities are numbered from most to least isolated so the city we
+ * select is the first set bit. For networks of a few hundred cities every bitset is a few machine
+ * words and the vector instructions of the processor do the covering.
+ *
+ *
  * Perfect Matching:
  * -------------------
  *
@@ -274,18 +285,28 @@
  */
 #ifndef DANCINGLINKS_H
 #define DANCINGLINKS_H
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <set>
 #include <vector>
 #include "Src/MatchingUtilities.h"
+#include "Src/DisasterBits.h"
+#include "Src/DisasterHeuristic.h"
 #include "Src/DisasterLinks.h"
+#include "Src/DisasterReduction.h"
+#include "Src/ComponentSearch.h"
 #include "Src/DisasterTags.h"
+#include "Src/IterativeSearch.h"
 #include "Src/PartnerLinks.h"
+#include "Src/SearchLimits.h"
+#include "Src/SolutionGenerator.h"
 
 
 namespace DancingLinks {
 class DisasterLinks;
 class DisasterTags;
+class DisasterBits;
 class PartnerLinks;
 
 /**
@@ -308,6 +329,149 @@ bool hasOverlappingCover(DisasterLinks& links, int depthLimit,
 bool hasOverlappingCover(DisasterTags& links, int depthLimit,
                            std::set<std::string>& selectedOptions);
 
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+bool hasOverlappingCover(DisasterBits& links, int depthLimit,
+                           std::set<std::string>& selectedOptions);
+
+/**
+ * @brief hasOverlappingCover  performs the same cover search as above but shares the search among
+ *                             multiple threads. Every thread searches its own copy of the links,
+ *                             idle threads steal untried options from busy ones, and all stop
+ *                             once one finds a cover.
+ * @param links                the dancing links object we take in to perform our cover search.
+ * @param depthLimit           the limit we place on how many options we can choose.
+ * @param selectedOptions      the options we select as proof of our cover search.
+ * @param numThreads           the number of threads to use. Zero or less uses all hardware threads.
+ * @return                     true if solution false if not. Output param is full for true.
+ */
+bool hasOverlappingCover(DisasterLinks& links, int depthLimit,
+                           std::set<std::string>& selectedOptions, int numThreads);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+bool hasOverlappingCover(DisasterTags& links, int depthLimit,
+                           std::set<std::string>& selectedOptions, int numThreads);
+
+/**
+ * @brief hasOverlappingCover  performs the same cover search as above but gives up once any of the
+ *                             limits is reached. An aborted search is not a proof that no cover
+ *                             exists, so the status tells the three outcomes apart.
+ * @param links                the dancing links object we take in to perform our cover search.
+ * @param depthLimit           the limit we place on how many options we can choose.
+ * @param selectedOptions      the options we select as proof of our cover search.
+ * @param limits               the node, time, and cancellation limits for the search.
+ * @return                     FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+ */
+SearchStatus hasOverlappingCover(DisasterLinks& links, int depthLimit,
+                                 std::set<std::string>& selectedOptions,
+                                 const SearchLimits& limits);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+SearchStatus hasOverlappingCover(DisasterTags& links, int depthLimit,
+                                 std::set<std::string>& selectedOptions,
+                                 const SearchLimits& limits);
+
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+SearchStatus hasOverlappingCover(DisasterBits& links, int depthLimit,
+                                 std::set<std::string>& selectedOptions,
+                                 const SearchLimits& limits);
+
+/**
+ * @brief hasOverlappingCover  performs the threaded cover search within the given limits. The
+ *                             node limit counts the nodes of every thread together.
+ * @param links                the dancing links object we take in to perform our cover search.
+ * @param depthLimit           the limit we place on how many options we can choose.
+ * @param selectedOptions      the options we select as proof of our cover search.
+ * @param numThreads           the number of threads to use. Zero or less uses all hardware threads.
+ * @param limits               the node, time, and cancellation limits for the search.
+ * @return                     FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+ */
+SearchStatus hasOverlappingCover(DisasterLinks& links, int depthLimit,
+                                 std::set<std::string>& selectedOptions, int numThreads,
+                                 const SearchLimits& limits);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+SearchStatus hasOverlappingCover(DisasterTags& links, int depthLimit,
+                                 std::set<std::string>& selectedOptions, int numThreads,
+                                 const SearchLimits& limits);
+
+/**
+ * @brief getMinimumOverlappingCover  finds the fewest options that can cover every item in one
+ *                                    branch and bound search. Each cover found lowers the limit
+ *                                    on options for the rest of the search.
+ * @param links                       the dancing links object on which we perform a cover search.
+ * @param selectedOptions             the output parameter holding the options of a minimum cover.
+ * @return                            the number of options in a minimum cover.
+ */
+int getMinimumOverlappingCover(DisasterLinks& links, std::set<std::string>& selectedOptions);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+int getMinimumOverlappingCover(DisasterTags& links, std::set<std::string>& selectedOptions);
+
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+int getMinimumOverlappingCover(DisasterBits& links, std::set<std::string>& selectedOptions);
+
+/**
+ * @brief getMinimumOverlappingCover  performs the same branch and bound search as above but gives
+ *                                    up once any of the limits is reached. The best cover found
+ *                                    so far is still reported but may not be a minimum.
+ * @param links                       the dancing links object on which we perform a cover search.
+ * @param selectedOptions             the output parameter holding the best cover found.
+ * @param limits                      the node, time, and cancellation limits for the search.
+ * @return                            FOUND if the cover is proven minimum or ABORTED by a limit.
+ */
+SearchStatus getMinimumOverlappingCover(DisasterLinks& links,
+                                        std::set<std::string>& selectedOptions,
+                                        const SearchLimits& limits);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+SearchStatus getMinimumOverlappingCover(DisasterTags& links,
+                                        std::set<std::string>& selectedOptions,
+                                        const SearchLimits& limits);
+
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+SearchStatus getMinimumOverlappingCover(DisasterBits& links,
+                                        std::set<std::string>& selectedOptions,
+                                        const SearchLimits& limits);
+
+/**
+ * @brief getApproximateOverlappingCover  reports the cover a greedy and local search heuristic
+ *                                        found when the links were built. No search is needed, so
+ *                                        this answers at once for callers that accept a cover that
+ *                                        may not be a minimum. The minimum search starts from it.
+ * @param links                           the dancing links object built for the network.
+ * @param selectedOptions                 the output parameter holding the heuristic cover.
+ * @return                                the number of options in the heuristic cover.
+ */
+int getApproximateOverlappingCover(DisasterLinks& links, std::set<std::string>& selectedOptions);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+int getApproximateOverlappingCover(DisasterTags& links, std::set<std::string>& selectedOptions);
+
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+int getApproximateOverlappingCover(DisasterBits& links, std::set<std::string>& selectedOptions);
+
 /**
  * @brief getAllOverlappingCovers  finds every possible way to cover items with the provided options
  *                                 in a DisasterLinks object. Overlapping covers allow for multiple
@@ -323,6 +487,77 @@ std::set<std::set<std::string>> getAllOverlappingCovers(DisasterLinks& links, in
  */
 std::set<std::set<std::string>> getAllOverlappingCovers(DisasterTags& links, int depthLimit);
 
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+std::set<std::set<std::string>> getAllOverlappingCovers(DisasterBits& links, int depthLimit);
+
+/**
+ * @brief getUniqueOverlappingCovers  finds every possible way to cover items with the provided
+ *                                    options, generating each cover exactly once. An option is
+ *                                    forbidden for its siblings once every cover using it has been
+ *                                    found, so the covers need no set to filter out duplicates.
+ * @param links                       the dancing links class on which we perform a cover search.
+ * @param depthLimit                  the limit on the number of options we can choose.
+ * @return                            the vector of distinct sets of options we chose.
+ */
+std::vector<std::set<std::string>> getUniqueOverlappingCovers(DisasterLinks& links, int depthLimit);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+std::vector<std::set<std::string>> getUniqueOverlappingCovers(DisasterTags& links, int depthLimit);
+
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+std::vector<std::set<std::string>> getUniqueOverlappingCovers(DisasterBits& links, int depthLimit);
+
+/**
+ * @brief countOverlappingCovers  counts the covers getUniqueOverlappingCovers would find with the
+ *                                same search. Only a counter grows as covers are found so we can
+ *                                count covers that would exhaust memory if we built them.
+ * @param links                   the dancing links class on which we perform a cover search.
+ * @param depthLimit              the limit on the number of options we can choose.
+ * @return                        the number of distinct sets of options that cover every item.
+ */
+uint64_t countOverlappingCovers(DisasterLinks& links, int depthLimit);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+uint64_t countOverlappingCovers(DisasterTags& links, int depthLimit);
+
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+uint64_t countOverlappingCovers(DisasterBits& links, int depthLimit);
+
+/**
+ * @brief visitOverlappingCovers  streams the covers getUniqueOverlappingCovers would find to a
+ *                                visitor the moment each is found. The visitor receives the option
+ *                                ids of the cover, which getSupplyName turns into names, and
+ *                                returns false to stop the search early.
+ * @param links                   the dancing links class on which we perform a cover search.
+ * @param depthLimit              the limit on the number of options we can choose.
+ * @param visit                   the visitor called with every cover found.
+ * @return                        true if every cover was visited, false if the visitor stopped.
+ */
+bool visitOverlappingCovers(DisasterLinks& links, int depthLimit,
+                            const std::function<bool(const std::vector<int>&)>& visit);
+
+/**
+ * Overloaded version of the above function for a DisasterTags object.
+ */
+bool visitOverlappingCovers(DisasterTags& links, int depthLimit,
+                            const std::function<bool(const std::vector<int>&)>& visit);
+
+/**
+ * Overloaded version of the above function for a DisasterBits object.
+ */
+bool visitOverlappingCovers(DisasterBits& links, int depthLimit,
+                            const std::function<bool(const std::vector<int>&)>& visit);
+
 /**
  * @brief hasExactCover    determines if an exact cover is possible given the items and options
  *                         available to cover those items. An exact cover is one where the options
@@ -335,6 +570,39 @@ std::set<std::set<std::string>> getAllOverlappingCovers(DisasterTags& links, int
  */
 bool hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions);
 
+/**
+ * @brief hasExactCover    performs the same exact cover search as above but shares the search
+ *                         among multiple threads that steal untried options from one another.
+ * @param links            the dancing links class on which we perform an exact cover search.
+ * @param selectedOptions  the options we have selected that satisfy an exact cover of items.
+ * @param numThreads       the number of threads to use. Zero or less uses all hardware threads.
+ * @return                 true if the output parameter is full and we found a cover, false if not.
+ */
+bool hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions, int numThreads);
+
+/**
+ * @brief hasExactCover    performs the same exact cover search as above but gives up once any of
+ *                         the limits is reached.
+ * @param links            the dancing links class on which we perform an exact cover search.
+ * @param selectedOptions  the options we have selected that satisfy an exact cover of items.
+ * @param limits           the node, time, and cancellation limits for the search.
+ * @return                 FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+ */
+SearchStatus hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions,
+                           const SearchLimits& limits);
+
+/**
+ * @brief hasExactCover    performs the threaded exact cover search within the given limits. The
+ *                         node limit counts the nodes of every thread together.
+ * @param links            the dancing links class on which we perform an exact cover search.
+ * @param selectedOptions  the options we have selected that satisfy an exact cover of items.
+ * @param numThreads       the number of threads to use. Zero or less uses all hardware threads.
+ * @param limits           the node, time, and cancellation limits for the search.
+ * @return                 FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+ */
+SearchStatus hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions, int numThreads,
+                           const SearchLimits& limits);
+
 /**
  * @brief getAllExactCovers  finds every possible exact cover of the given items with the provided
  *                           options. Because this is intended for the perfect matching problem on
@@ -345,6 +613,26 @@ bool hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions);
  */
 std::vector<std::set<Pair>> getAllExactCovers(PartnerLinks& links);
 
+/**
+ * @brief countExactCovers  counts the exact covers getAllExactCovers would find without building
+ *                          a single Pair, so even networks with a huge number of perfect matchings
+ *                          can be counted.
+ * @param links             the PartnerLinks object on which we perform an exact cover search.
+ * @return                  the number of exact covers.
+ */
+uint64_t countExactCovers(PartnerLinks& links);
+
+/**
+ * @brief visitExactCovers  streams the exact covers getAllExactCovers would find to a visitor the
+ *                          moment each is found. The visitor receives the pairing ids of the cover,
+ *                          which getPairing turns into Pairs, and returns false to stop early.
+ * @param links             the PartnerLinks object on which we perform an exact cover search.
+ * @param visit             the visitor called with every exact cover found.
+ * @return                  true if every cover was visited, false if the visitor stopped.
+ */
+bool visitExactCovers(PartnerLinks& links,
+                      const std::function<bool(const std::vector<int>&)>& visit);
+
 /**
  * @brief getMaxWeightMatching  finds the maximum possible weight matching of items given the
  *                              options to match or "cover" those items.
@@ -353,6 +641,17 @@ std::vector<std::set<Pair>> getAllExactCovers(PartnerLinks& links);
  */
 std::set<Pair> getMaxWeightMatching(PartnerLinks& links);
 
+/**
+ * @brief getMaxWeightMatching  performs the same search as above but gives up once any of the
+ *                              limits is reached, keeping the heaviest matching found so far.
+ * @param links                 the PartnerLinks object on which we search for max weight matching.
+ * @param pairs                 the output parameter holding the heaviest matching we found.
+ * @param limits                the node, time, and cancellation limits for the search.
+ * @return                      FOUND with the Max Weight Matching or ABORTED by a limit.
+ */
+SearchStatus getMaxWeightMatching(PartnerLinks& links, std::set<Pair>& pairs,
+                                  const SearchLimits& limits);
+
 
 } // namespace DancingLinks
 
@@ -60,6 +60,8 @@ DESTDIR     =   $$PWD
 # to distinguish between the two main() functions and avoid symbol clash
 # Ask Julie if you are curious why main->qMain->studentMain
 DEFINES     +=  main=qMain qMain=studentMain
+# Uncomment to count nodes per depth, updates, mems, and solutions (see Src/SearchStats.h)
+# DEFINES     +=  DLX_SEARCH_STATS
 
 ###############################################################################
 #       Gather files to list in Qt Creator project browser                    #
@@ -71,25 +73,60 @@ DEFINES     +=  main=qMain qMain=studentMain
 # entries, so no worries about duplicates
 SOURCES         *=  "" \
     Demos/MapParser.cpp \
+    Src/CoverProduct.cpp \
+    Src/DisasterBits.cpp \
+    Src/DisasterHeuristic.cpp \
     Src/DisasterLinks.cpp \
+    Src/DisasterReduction.cpp \
     Src/DisasterTags.cpp \
+    Src/NetworkGraph.cpp \
+    Src/NogoodTable.cpp \
     Src/PartnerLinks.cpp \
+    Src/SearchLimits.cpp \
+    Src/SymmetryGroup.cpp \
+    Tests/ComponentSearchTests.cpp \
+    Tests/DisasterBitsTests.cpp \
+    Tests/DisasterHeuristicTests.cpp \
     Tests/DisasterLinksTests.cpp \
+    Tests/DisasterReductionTests.cpp \
     Tests/DisasterTagsTests.cpp \
     Tests/GenericOverloads.cpp \
-    Tests/PartnerLinksTests.cpp
+    Tests/IterativeSearchTests.cpp \
+    Tests/NetworkGraphTests.cpp \
+    Tests/NogoodTableTests.cpp \
+    Tests/PartnerLinksTests.cpp \
+    Tests/SearchLimitsTests.cpp \
+    Tests/SearchStatsTests.cpp \
+    Tests/SolutionGeneratorTests.cpp \
+    Tests/SymmetryGroupTests.cpp
 HEADERS         *=  "" \
     DancingLinks.h \
     Demos/MapParser.h \
+    Src/ComponentSearch.h \
+    Src/CoverProduct.h \
+    Src/DisasterBits.h \
+    Src/DisasterHeuristic.h \
     Src/DisasterLinks.h \
+    Src/DisasterReduction.h \
     Src/DisasterTags.h \
+    Src/IterativeSearch.h \
+    Src/NetworkGraph.h \
+    Src/NogoodTable.h \
+    Src/ParallelSearch.h \
     Src/PartnerLinks.h \
+    Src/SearchLimits.h \
+    Src/SearchStats.h \
+    Src/SolutionGenerator.h \
+    Src/SymmetryGroup.h \
     Tests/GenericOverloads.h
 
 # Gather any .cpp or .h files within the project folder (student/starter code).
 # Second argument true makes search recursive
 SOURCES         *=  $$files(*.cpp, true)
 HEADERS         *=  $$files(*.h, true)
+# The headless benchmark is its own project with its own main() (see Bench/Bench.pro)
+SOURCES         -=  $$files(Bench/*.cpp, true)
+HEADERS         -=  $$files(Bench/*.h, true)
 
 # Gather resource files (image/sound/etc) from res dir, list under "Other files"
 OTHER_FILES     *=  $$files(Data/*, true)
@@ -1,6 +1,7 @@
 #include "GUI/MiniGUI.h"
 #include "MapParser.h"
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <string>
 #include <cmath>
@@ -328,94 +329,60 @@ namespace {
      * with a function pointer. Instead just do the same functions many times.
      */
 
+    /* Pendant towns and dominated supply locations are settled before the search. The solvers
+     * only see the cities that still need a decision and we add the forced supplies back after.
+     * Reduction often leaves separate regions behind, and those are searched concurrently.
+     */
+
     void solveOptimallyWithQuadDLX(const MapTest& test, set<string>& result) {
-        int low = 0, high = test.network.size();
-        Dx::DisasterLinks network(test.network);
-        (void) Dx::hasOverlappingCover(network, high, result);
-        while (low < high) {
-            int mid = low + (high - low) / 2;
-            set<string> thisResult;
-            if (Dx::hasOverlappingCover(network, mid, thisResult)) {
-                high = mid;
-                result = thisResult;
-            }
-            else {
-                low = mid + 1;
-            }
-        }
+        Dx::DisasterReduction reduction(test.network);
+        Dx::ComponentSearch<Dx::DisasterLinks> search(reduction.getReducedNetwork(), 0);
+        (void) search.findMinimumSupplies(result);
+        reduction.restoreSupplies(result);
     }
 
     void solveOptimallyWithSupplyTagDLX(const MapTest& test, set<string>& result) {
-        int low = 0, high = test.network.size();
-        Dx::DisasterTags network(test.network);
-        (void) Dx::hasOverlappingCover(network, high, result);
-        while (low < high) {
-            int mid = low + (high - low) / 2;
-            set<string> thisResult;
-            if (Dx::hasOverlappingCover(network, mid, thisResult)) {
-                high = mid;
-                result = thisResult;
-            }
-            else {
-                low = mid + 1;
-            }
-        }
+        Dx::DisasterReduction reduction(test.network);
+        Dx::ComponentSearch<Dx::DisasterTags> search(reduction.getReducedNetwork(), 0);
+        (void) search.findMinimumSupplies(result);
+        reduction.restoreSupplies(result);
     }
 
-    /* These are all bad and slow. Right now I can only generate all viable configurations by
-     * filtering out duplicate configurations with a set. I then transfer all solutions from the
-     * set to the vector to make it work better with the GUI. I would like to only generate unique
-     * coverage schemes so I can use a vector from the beggining. I haven't figured it out.
+    /* We find how few supplies we need first, which is fast. Then the configurations using that
+     * many supplies are generated from the full map one at a time as the GUI pages to them, so the
+     * first appears at once and we never wait for the rest. The reduction may discard covers that
+     * are just as good so we search the full map here. The generator searches its own copy of the
+     * links and we keep the original only to name the supplies.
      */
 
-
-    void solveAllWithQuadDLX(const MapTest& test,
-                             unique_ptr<vector<set<string>>>& allSolutions) {
-        int low = 0, high = test.network.size();
-        set<string> result = {};
-        Dx::DisasterLinks network(test.network);
-        (void) Dx::hasOverlappingCover(network, high, result);
-        while (low < high) {
-            int mid = low + (high - low) / 2;
-            set<string> thisResult;
-
-            if (Dx::hasOverlappingCover(network, mid, thisResult)) {
-                high = mid;
-                result = thisResult;
+    template <typename Links>
+    function<bool(set<string>&)> generateOptimalConfigurations(const MapTest& test, int numSupplies) {
+        shared_ptr<Links> links = make_shared<Links>(test.network);
+        shared_ptr<Dx::SolutionGenerator<Links,int>> generator
+            = make_shared<Dx::SolutionGenerator<Links,int>>(*links, numSupplies);
+        return [links, generator](set<string>& configuration) {
+            vector<int> supplies;
+            if (!generator->next(supplies)) {
+                return false;
             }
-            else {
-                low = mid + 1;
+            configuration.clear();
+            for (int option : supplies) {
+                configuration.insert(links->getSupplyName(option));
             }
-        }
-        int optimalSupplies = result.size();
-        set<set<string>> allFoundConfigs = Dx::getAllOverlappingCovers(network, optimalSupplies);
-        for (const auto& found : allFoundConfigs) {
-            (*allSolutions).push_back(found);
-        }
+            return true;
+        };
     }
 
-    void solveAllWithSupplyTagDLX(const MapTest& test,
-                                  unique_ptr<vector<set<string>>>& allSolutions) {
-        int low = 0, high = test.network.size();
-        set<string> result = {};
-        Dx::DisasterTags network(test.network);
-        (void) Dx::hasOverlappingCover(network, high, result);
-        while (low < high) {
-            int mid = low + (high - low) / 2;
-            set<string> thisResult;
-            if (Dx::hasOverlappingCover(network, mid, thisResult)) {
-                high = mid;
-                result = thisResult;
-            }
-            else {
-                low = mid + 1;
-            }
-        }
-        int optimalSupplies = result.size();
-        set<set<string>> allFoundConfigs = Dx::getAllOverlappingCovers(network, optimalSupplies);
-        for (const auto& found : allFoundConfigs) {
-            (*allSolutions).push_back(found);
-        }
+    void solveAllWithQuadDLX(const MapTest& test, function<bool(set<string>&)>& nextSolution) {
+        set<string> optimal;
+        solveOptimallyWithQuadDLX(test, optimal);
+        nextSolution = generateOptimalConfigurations<Dx::DisasterLinks>(test, optimal.size());
+    }
+
+    void solveAllWithSupplyTagDLX(const MapTest& test, function<bool(set<string>&)>& nextSolution) {
+        set<string> optimal;
+        solveOptimallyWithSupplyTagDLX(test, optimal);
+        nextSolution = generateOptimalConfigurations<Dx::DisasterTags>(test, optimal.size());
     }
 
     class DisasterGUI: public ProblemHandler {
@@ -446,8 +413,10 @@ namespace {
         Temporary<GButton> mPrevSolution;
         Temporary<GButton> mAllSolutions;
         Temporary<GButton> mNextSolution;
-        unique_ptr<vector<set<string>>> mStoredSolutions;
-        int mCurrentSolutionIndex;
+        /* The configurations found so far and the generator of the rest, empty once it runs dry. */
+        vector<set<string>> mStoredSolutions;
+        function<bool(set<string>&)> mFindNextSolution;
+        long long mCurrentSolutionIndex;
         const string mAllSolutionsMessage = "Solutions Found:";
 
         /* Current network and solution. */
@@ -463,6 +432,7 @@ namespace {
         void showPreviousSolution();
         void solveAll();
         void showNextSolution();
+        bool findNextSolution();
     };
 
     DisasterGUI::DisasterGUI(GWindow& window) : ProblemHandler(window) {
@@ -523,7 +493,8 @@ namespace {
 
         mNetwork = loadDisaster(input);
         mSelected.clear();
-        mStoredSolutions.reset();
+        mStoredSolutions.clear();
+        mFindNextSolution = nullptr;
         mPrevSolution->setEnabled(false);
         mNextSolution->setEnabled(false);
         requestRepaint();
@@ -532,7 +503,8 @@ namespace {
     void DisasterGUI::solve() {
         /* Clear out any old solution. We're going to get a new one. */
         mSelected.clear();
-        mStoredSolutions.reset();
+        mStoredSolutions.clear();
+        mFindNextSolution = nullptr;
 
         /* Disable all controls until the operation finishes. */
         mSolve->setEnabled(false);
@@ -560,27 +532,55 @@ namespace {
     }
 
     void DisasterGUI::showPreviousSolution() {
-        if (mStoredSolutions && (*mStoredSolutions).size() > 1) {
-            if (--mCurrentSolutionIndex < 0) {
-                mCurrentSolutionIndex = (*mStoredSolutions).size() - 1;
+        if (mStoredSolutions.size() > 1) {
+            /* We can only wrap around to the last solution once we know which one that is. */
+            if (mCurrentSolutionIndex > 0) {
+                --mCurrentSolutionIndex;
+            } else if (!mFindNextSolution) {
+                mCurrentSolutionIndex = mStoredSolutions.size() - 1;
+            } else {
+                return;
             }
-            mSelected = (*mStoredSolutions)[mCurrentSolutionIndex];
+            mSelected = mStoredSolutions[mCurrentSolutionIndex];
             requestRepaint();
         }
     }
 
     void DisasterGUI::showNextSolution() {
-        if (mStoredSolutions && (*mStoredSolutions).size() > 1) {
-            ++mCurrentSolutionIndex %= (*mStoredSolutions).size();
-            mSelected = (*mStoredSolutions)[mCurrentSolutionIndex];
-            requestRepaint();
+        if (mStoredSolutions.empty()) {
+            return;
         }
+        if (mCurrentSolutionIndex + 1 < (long long)mStoredSolutions.size() || findNextSolution()) {
+            ++mCurrentSolutionIndex;
+        } else if (mStoredSolutions.size() > 1) {
+            mCurrentSolutionIndex = 0;
+        } else {
+            return;
+        }
+        mSelected = mStoredSolutions[mCurrentSolutionIndex];
+        requestRepaint();
+    }
+
+    bool DisasterGUI::findNextSolution() {
+        if (!mFindNextSolution) {
+            return false;
+        }
+        set<string> configuration;
+        if (mFindNextSolution(configuration)) {
+            mStoredSolutions.push_back(configuration);
+            return true;
+        }
+        /* Now that the search is over we finally know how many solutions there are. */
+        mFindNextSolution = nullptr;
+        GOptionPane::showMessageDialog(&window(), to_string(mStoredSolutions.size()), mAllSolutionsMessage);
+        return false;
     }
 
     void DisasterGUI::solveAll() {
         /* Clear out any old solution. We're going to get a new one. */
         mSelected.clear();
-        mStoredSolutions.reset(new vector<set<string>>{});
+        mStoredSolutions.clear();
+        mFindNextSolution = nullptr;
 
         /* Disable all controls until the operation finishes. */
         mSolve->setEnabled(false);
@@ -591,16 +591,18 @@ namespace {
 
         if (mSolver->getSelectedItem() == mQuadDLXSolver) {
             mSolverUsed = QUAD_DLX;
-            solveAllWithQuadDLX(mNetwork, mStoredSolutions);
+            solveAllWithQuadDLX(mNetwork, mFindNextSolution);
         } else if (mSolver->getSelectedItem() == mSupplyTagDLXSolver) {
             mSolverUsed = TAGGED_DLX;
-            solveAllWithSupplyTagDLX(mNetwork, mStoredSolutions);
+            solveAllWithSupplyTagDLX(mNetwork, mFindNextSolution);
         }
 
-        mSelected = (*mStoredSolutions)[mCurrentSolutionIndex];
+        /* Every map can be covered so there is always a first solution. The count is shown once
+         * the user has paged through all of them.
+         */
+        findNextSolution();
+        mSelected = mStoredSolutions[mCurrentSolutionIndex];
 
-        /* Are there other ways to dynamically display messages besides a pop up? */
-        GOptionPane::showMessageDialog(&window(), to_string((*mStoredSolutions).size()), mAllSolutionsMessage);
         /* Enable controls. */
         mSolve->setEnabled(true);
         mProblems->setEnabled(true);
@@ -83,9 +83,12 @@ namespace {
         /* Current matching, if any. */
         unique_ptr<std::set<Pair>> currMatching;
 
-        /* Every perfect matching if requested */
+        /* Every perfect matching found so far if requested. The generator finds the rest on demand
+         * and is released once it runs dry, at which point allMatching holds every matching.
+         */
 
         unique_ptr<std::vector<std::set<Pair>>> allMatching;
+        unique_ptr<Dx::SolutionGenerator<Dx::PartnerLinks,Pair>> matchingGenerator;
         int currMatchingIndex;
 
         /* Panel layout:
@@ -146,6 +149,7 @@ namespace {
 
         void showPrevMatching();
         void showNextMatching();
+        bool findNextMatching();
         void solvePerfectMatching();
         void solveAllPerfectMatching();
         void solveMaxWeightMatching();
@@ -260,6 +264,7 @@ namespace {
         dirty(false);
         currMatching.reset();
         allMatching.reset();
+        matchingGenerator.reset();
         currMatchingIndex = 0;
         graphControls->setEnabled(true);
         requestRepaint();
@@ -308,6 +313,7 @@ namespace {
          */
         currMatching.reset();
         allMatching.reset();
+        matchingGenerator.reset();
         currMatchingIndex = 0;
         prevMatchButton->setEnabled(false);
         nextMatchButton->setEnabled(false);
@@ -513,6 +519,7 @@ namespace {
 
     void MatchmakerGUI::solvePerfectMatching() {
         allMatching.reset();
+        matchingGenerator.reset();
 
         prevMatchButton->setEnabled(false);
         nextMatchButton->setEnabled(false);
@@ -576,8 +583,13 @@ namespace {
 
     void MatchmakerGUI::showPrevMatching() {
         if (allMatching && (*allMatching).size() > 1) {
-            if (--currMatchingIndex < 0) {
+            /* We can only wrap around to the last matching once we know which one that is. */
+            if (currMatchingIndex > 0) {
+                --currMatchingIndex;
+            } else if (!matchingGenerator) {
                 currMatchingIndex = (*allMatching).size() - 1;
+            } else {
+                return;
             }
             currMatching.reset(new std::set<Pair>((*allMatching)[currMatchingIndex]));
             requestRepaint();
@@ -585,11 +597,33 @@ namespace {
     }
 
     void MatchmakerGUI::showNextMatching() {
-        if (allMatching && (*allMatching).size() > 1) {
-            ++currMatchingIndex %= (*allMatching).size();
-            currMatching.reset(new std::set<Pair>((*allMatching)[currMatchingIndex]));
-            requestRepaint();
+        if (!allMatching) {
+            return;
+        }
+        if (currMatchingIndex + 1 < (int)(*allMatching).size() || findNextMatching()) {
+            ++currMatchingIndex;
+        } else if ((*allMatching).size() > 1) {
+            currMatchingIndex = 0;
+        } else {
+            return;
         }
+        currMatching.reset(new std::set<Pair>((*allMatching)[currMatchingIndex]));
+        requestRepaint();
+    }
+
+    bool MatchmakerGUI::findNextMatching() {
+        if (!matchingGenerator) {
+            return false;
+        }
+        std::vector<Pair> pairs = {};
+        if (matchingGenerator->next(pairs)) {
+            (*allMatching).emplace_back(pairs.begin(), pairs.end());
+            return true;
+        }
+        /* Now that the search is over we finally know how many matchings there are. */
+        matchingGenerator.reset();
+        GOptionPane::showMessageDialog(&window(), to_string((*allMatching).size()), kAllMatchesFoundTitle);
+        return false;
     }
 
     void MatchmakerGUI::solveAllPerfectMatching() {
@@ -623,35 +657,42 @@ namespace {
          */
         editor->setActive(nullptr);
 
-        std::vector<std::set<Pair>> allFoundMatchings = {};
+        /* Only the first matching is found now. The rest are found as the user pages to them. */
+        allMatching.reset(new std::vector<std::set<Pair>>());
+        matchingGenerator.reset();
         bool usedRothberg = false;
 
         if (solverDropdown->getSelectedItem() == dlxSolver) {
             selectedSolver = DLX_PAIRS;
             Dx::PartnerLinks links(graph);
-            allFoundMatchings = Dx::getAllExactCovers(links);
+            matchingGenerator.reset(
+                new Dx::SolutionGenerator<Dx::PartnerLinks,Pair>(links, graph.size()));
+            std::vector<Pair> pairs = {};
+            if (matchingGenerator->next(pairs)) {
+                (*allMatching).emplace_back(pairs.begin(), pairs.end());
+            }
         } else if (solverDropdown->getSelectedItem() == fastRothbergSolver){
             usedRothberg = true;
         } else {
             error("something is wrong with the solver dropdown menu. Invalid solver.");
         }
 
-        if (allFoundMatchings.size()) {
-            allMatching.reset(new std::vector<std::set<Pair>>(allFoundMatchings));
+        if ((*allMatching).size()) {
             prevMatchButton->setEnabled(true);
             nextMatchButton->setEnabled(true);
             currMatchingIndex = 0;
             /* Can we just reset this to a set in the vector or do we have to use new everytime?*/
             currMatching.reset(new std::set<Pair>((*allMatching)[currMatchingIndex]));
             requestRepaint();
-            GOptionPane::showMessageDialog(&window(), to_string((*allMatching).size()), kAllMatchesFoundTitle);
         } else if (usedRothberg) {
             allMatching.reset();
+            matchingGenerator.reset();
             currMatching.reset();
             requestRepaint();
             GOptionPane::showMessageDialog(&window(), kNoRothbergAllMatching, kNoRothbergTitle);
         } else {
             allMatching.reset();
+            matchingGenerator.reset();
             currMatching.reset();
             requestRepaint();
             GOptionPane::showMessageDialog(&window(), kNoPerfectMatching, kNoPerfectMatchingTitle);
@@ -663,6 +704,7 @@ namespace {
 
     void MatchmakerGUI::solveMaxWeightMatching() {
         allMatching.reset();
+        matchingGenerator.reset();
         /* For larger graphs this can be a slow function so disable while it thinks. */
         prevMatchButton->setEnabled(false);
         nextMatchButton->setEnabled(false);
@@ -0,0 +1,209 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: ComponentSearch.h
+ * --------------------------
+ * This file contains a driver that splits a disaster network into its connected components before
+ * searching. Island cities or separate rail systems share no supply location with the rest of the
+ * network, yet a single grid makes the search space the product of every region's search space.
+ * Searched on their own, the regions only add. A minimum cover of the network is a minimum cover
+ * of every component, and every optimal cover of the network is one optimal cover per component.
+ *
+ * Components are independent so they are handed to threads whole, largest first. Each thread
+ * builds its own solver for a component, so any class with the following public members may be
+ * used, which today means DisasterLinks, DisasterTags, and DisasterBits.
+ *
+ *      explicit Links(const CoverNetwork& network);
+ *      SearchStatus findMinimumSupplies(std::set<std::string>& suppliedCities,
+ *                                       const SearchLimits& limits);
+ *      bool visitDisasterConfigurations(int numSupplies, const ConfigurationVisitor& visit);
+ *      const std::string& getSupplyName(int option) const;
+ *
+ * Every component is given the same limits, so the cancellation flag and the deadline stop them
+ * all together. Each component counts its own nodes against the node limit.
+ *
+ * Because this is a template it lives entirely in this header.
+ */
+#ifndef COMPONENTSEARCH_H
+#define COMPONENTSEARCH_H
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "NetworkGraph.h"
+#include "CoverProduct.h"
+#include "SearchLimits.h"
+
+namespace DancingLinks {
+
+template <typename Links>
+class ComponentSearch {
+
+public:
+
+
+    /**
+     * @brief ComponentSearch  splits a network into the components we will search one by one.
+     * @param network          the cities to cover and the cities each supply location covers.
+     * @param numWorkers       the number of threads to use. Zero or less uses every core we have.
+     */
+    ComponentSearch(const CoverNetwork& network, int numWorkers)
+        : components_(network.getComponents()),
+          schedule_(),
+          numWorkers_(numWorkers > 0 ? numWorkers
+                                     : std::max(1, (int)std::thread::hardware_concurrency())) {
+        for (int component = 0; component < (int)components_.size(); component++) {
+            schedule_.push_back(component);
+        }
+        // The largest components take the longest so they should not be left for last.
+        std::stable_sort(schedule_.begin(), schedule_.end(), [this](int left, int right) {
+            return components_[left].numItems() > components_[right].numItems();
+        });
+    }
+
+    /**
+     * @brief numComponents  reports how many independent regions the network splits into.
+     * @return               the number of connected components we will search.
+     */
+    int numComponents() const {
+        return components_.size();
+    }
+
+    /**
+     * @brief findMinimumSupplies  finds a minimum cover of every component concurrently. The
+     *                             minimum for the network is the sum of the minimums we find.
+     * @param suppliedCities       the output parameter holding the union of the optimal covers.
+     * @return                     the minimum number of supplies needed to cover every city.
+     */
+    int findMinimumSupplies(std::set<std::string>& suppliedCities) {
+        std::set<std::string> cover = {};
+        findMinimumSupplies(cover, SearchLimits());
+        suppliedCities.insert(cover.begin(), cover.end());
+        // No supply location belongs to two components so the size of the union is the sum.
+        return cover.size();
+    }
+
+    /**
+     * @brief findMinimumSupplies  performs the same search as above but gives up once any limit is
+     *                             reached. A component that aborts still reports the smallest
+     *                             cover it found, so the union always covers the network.
+     * @param suppliedCities       the output parameter holding the union of the best covers found.
+     * @param limits               the node, time, and cancellation limits for every component.
+     * @return                     FOUND if every cover is proven optimal or ABORTED by a limit.
+     */
+    SearchStatus findMinimumSupplies(std::set<std::string>& suppliedCities,
+                                     const SearchLimits& limits) {
+        std::vector<std::set<std::string>> covers(components_.size());
+        std::atomic<bool> isAborted(false);
+        runComponents([&](int component) {
+            Links links(components_[component]);
+            if (links.findMinimumSupplies(covers[component], limits) == SearchStatus::ABORTED) {
+                isAborted = true;
+            }
+        });
+        for (const std::set<std::string>& cover : covers) {
+            suppliedCities.insert(cover.begin(), cover.end());
+        }
+        return isAborted ? SearchStatus::ABORTED : SearchStatus::FOUND;
+    }
+
+    /**
+     * @brief getOptimalConfigurations  finds every optimal cover of every component concurrently.
+     *                                  The covers of the network are never listed. They are the
+     *                                  cross product of these lists and assembled on request.
+     * @return                          every optimal cover of the network.
+     */
+    CoverProduct getOptimalConfigurations() {
+        CoverProduct covers({});
+        getOptimalConfigurations(covers, SearchLimits());
+        return covers;
+    }
+
+    /**
+     * @brief getOptimalConfigurations  performs the same search as above but gives up once any
+     *                                  limit is reached. Listing the covers of a component spends
+     *                                  a budget of its own, one node for every cover listed.
+     * @param covers                    the output parameter holding every optimal cover of the
+     *                                  network. It is left as it was if any component aborts.
+     * @param limits                    the node, time, and cancellation limits for every component.
+     * @return                          FOUND with the output filled or ABORTED by a limit.
+     */
+    SearchStatus getOptimalConfigurations(CoverProduct& covers, const SearchLimits& limits) {
+        std::vector<std::vector<std::set<std::string>>> pieceCovers(components_.size());
+        std::atomic<bool> isAborted(false);
+        runComponents([&](int component) {
+            // Once any component aborts there is no product to build so the rest may skip ahead.
+            if (isAborted) {
+                return;
+            }
+            Links links(components_[component]);
+            std::set<std::string> cover = {};
+            if (links.findMinimumSupplies(cover, limits) == SearchStatus::ABORTED) {
+                isAborted = true;
+                return;
+            }
+            std::vector<std::set<std::string>>& listed = pieceCovers[component];
+            SearchBudget budget(limits);
+            bool isListed = links.visitDisasterConfigurations(cover.size(),
+                                                              [&](const std::vector<int>& supplies) {
+                if (budget.isSpent()) {
+                    return false;
+                }
+                listed.emplace_back();
+                for (int option : supplies) {
+                    listed.back().insert(links.getSupplyName(option));
+                }
+                return true;
+            });
+            if (!isListed) {
+                isAborted = true;
+            }
+        });
+        if (isAborted) {
+            return SearchStatus::ABORTED;
+        }
+        covers = CoverProduct(std::move(pieceCovers));
+        return SearchStatus::FOUND;
+    }
+
+
+private:
+
+
+    std::vector<CoverNetwork> components_;
+    // The order threads take components, largest first.
+    std::vector<int> schedule_;
+    int numWorkers_;
+
+
+    /**
+     * @brief runComponents  runs some work on every component. Threads take the next component on
+     *                       the schedule until none are left. Each component writes only to its
+     *                       own slot of the output so no locking is needed.
+     * @param work           the work to do given the index of a component.
+     */
+    template <typename Work>
+    void runComponents(const Work& work) {
+        std::atomic<int> next(0);
+        auto runWorker = [&]() {
+            for (int i = next++; i < (int)schedule_.size(); i = next++) {
+                work(schedule_[i]);
+            }
+        };
+        int numThreads = std::min(numWorkers_, (int)schedule_.size());
+        std::vector<std::thread> workers = {};
+        for (int id = 1; id < numThreads; id++) {
+            workers.emplace_back(runWorker);
+        }
+        // The calling thread takes components too rather than waiting idle.
+        runWorker();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+};
+
+} // namespace DancingLinks
+
+#endif // COMPONENTSEARCH_H
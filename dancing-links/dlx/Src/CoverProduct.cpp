@@ -0,0 +1,50 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: CoverProduct.cpp
+ * --------------------------
+ * This file contains the implementation of the lazy cross product of covers. Nothing is combined
+ * until a caller asks for a specific cover by its index.
+ */
+#include <climits>
+#include "CoverProduct.h"
+
+namespace DancingLinks {
+
+
+CoverProduct::CoverProduct(std::vector<std::vector<std::set<std::string>>> pieceCovers)
+    : pieceCovers_(std::move(pieceCovers)),
+      size_(1) {
+    for (const std::vector<std::set<std::string>>& covers : pieceCovers_) {
+        if (covers.empty()) {
+            size_ = 0;
+            return;
+        }
+    }
+    for (const std::vector<std::set<std::string>>& covers : pieceCovers_) {
+        // Stop counting before we overflow. Nobody will page this far through the covers.
+        if (size_ > LLONG_MAX / (long long)covers.size()) {
+            size_ = LLONG_MAX;
+            return;
+        }
+        size_ *= covers.size();
+    }
+}
+
+long long CoverProduct::size() const {
+    return size_;
+}
+
+std::set<std::string> CoverProduct::operator[](long long index) const {
+    if (index < 0 || index >= size_) {
+        error("Cover index is outside of the product.");
+    }
+    std::set<std::string> cover = {};
+    for (const std::vector<std::set<std::string>>& covers : pieceCovers_) {
+        const std::set<std::string>& chosen = covers[index % (long long)covers.size()];
+        cover.insert(chosen.begin(), chosen.end());
+        index /= covers.size();
+    }
+    return cover;
+}
+
+} // namespace DancingLinks
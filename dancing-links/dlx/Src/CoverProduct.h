@@ -0,0 +1,61 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: CoverProduct.h
+ * --------------------------
+ * This file defines a lazy cross product of the covers of independent pieces of a network. When a
+ * network falls apart into components every cover of the whole is one cover from each component.
+ * The number of such combinations grows as the product of the number of covers in each piece, so
+ * we only store the covers of each piece and assemble a combination when it is asked for.
+ *
+ * Combinations are numbered like the digits of a mixed radix number where the first piece changes
+ * fastest. Asking for any index is a handful of divisions, so callers may page through the covers
+ * in any order without ever building the full list.
+ */
+#ifndef COVERPRODUCT_H
+#define COVERPRODUCT_H
+#include <set>
+#include <string>
+#include <vector>
+#include "GUI/SimpleTest.h"
+
+namespace DancingLinks {
+
+class CoverProduct {
+
+public:
+
+
+    /**
+     * @brief CoverProduct  combines the covers of independent pieces of a network. A product of no
+     *                      pieces holds exactly one cover, the empty one.
+     * @param pieceCovers   every cover of each piece.
+     */
+    explicit CoverProduct(std::vector<std::vector<std::set<std::string>>> pieceCovers);
+
+    /**
+     * @brief size  the number of covers in the product. A product too large to count is reported
+     *              as the largest number a long long can hold.
+     * @return      the number of ways to choose one cover from every piece.
+     */
+    long long size() const;
+
+    /**
+     * @brief operator[]  assembles one cover of the whole network.
+     * @param index       the number of the combination from zero up to, not including, size().
+     * @return            the union of the covers chosen from each piece.
+     */
+    std::set<std::string> operator[](long long index) const;
+
+
+private:
+
+
+    std::vector<std::vector<std::set<std::string>>> pieceCovers_;
+    long long size_;
+
+    ALLOW_TEST_ACCESS();
+};
+
+} // namespace DancingLinks
+
+#endif // COVERPRODUCT_H
@@ -0,0 +1,643 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: DisasterBits.cpp
+ * --------------------------
+ * This file contains the implementation of the bitset disaster planning solver. The search is the
+ * same one the linked solvers run, so please see DisasterLinks.cpp for the reasoning behind the
+ * choice of city and the order of options. Only the representation changes. Where the links splice
+ * every covered city out of every option, here we clear the bits of one option from a copy of the
+ * uncovered cities and move one level down.
+ */
+#include <algorithm>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "DisasterBits.h"
+
+namespace DancingLinks {
+
+
+/* * * * * * * * * * * * *    Free Functions for DancingLinks Namespace   * * * * * * * * * * * * */
+
+
+bool hasOverlappingCover(DisasterBits& links, int numSupplies, std::set<std::string>& selectedOptions) {
+    return links.isDisasterReady(numSupplies, selectedOptions);
+}
+
+SearchStatus hasOverlappingCover(DisasterBits& links, int numSupplies,
+                                 std::set<std::string>& selectedOptions,
+                                 const SearchLimits& limits) {
+    return links.isDisasterReady(numSupplies, selectedOptions, limits);
+}
+
+int getMinimumOverlappingCover(DisasterBits& links, std::set<std::string>& selectedOptions) {
+    return links.findMinimumSupplies(selectedOptions);
+}
+
+SearchStatus getMinimumOverlappingCover(DisasterBits& links,
+                                        std::set<std::string>& selectedOptions,
+                                        const SearchLimits& limits) {
+    return links.findMinimumSupplies(selectedOptions, limits);
+}
+
+int getApproximateOverlappingCover(DisasterBits& links, std::set<std::string>& selectedOptions) {
+    return links.findApproximateSupplies(selectedOptions);
+}
+
+std::set<std::set<std::string>> getAllOverlappingCovers(DisasterBits& links, int numSupplies) {
+    return links.getAllDisasterConfigurations(numSupplies);
+}
+
+std::vector<std::set<std::string>> getUniqueOverlappingCovers(DisasterBits& links, int numSupplies) {
+    return links.getUniqueDisasterConfigurations(numSupplies);
+}
+
+uint64_t countOverlappingCovers(DisasterBits& links, int numSupplies) {
+    return links.countDisasterConfigurations(numSupplies);
+}
+
+bool visitOverlappingCovers(DisasterBits& links, int numSupplies,
+                            const std::function<bool(const std::vector<int>&)>& visit) {
+    return links.visitDisasterConfigurations(numSupplies, visit);
+}
+
+
+/* * * * * * * * * * * * * * * * * *         Bitset Kernels         * * * * * * * * * * * * * * * */
+
+
+namespace {
+
+const int WORD_BITS = 64;
+
+// Bitsets are padded to a multiple of four words so no kernel needs a loop for leftover words.
+int wordsFor(int numBits) {
+    return (numBits + 4 * WORD_BITS - 1) / (4 * WORD_BITS) * 4;
+}
+
+int countWord(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word; word &= word - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+int lowestBit(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    for (; !(word & 1); word >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// The bits of a that are not in b are written to dest.
+void andNot(uint64_t* dest, const uint64_t* a, const uint64_t* b, int words) {
+#if defined(__AVX2__)
+    for (int i = 0; i < words; i += 4) {
+        __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i difference = _mm256_andnot_si256(right, left);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), difference);
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < words; i += 2) {
+        __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_andnot_si128(right, left));
+    }
+#else
+    for (int i = 0; i < words; i++) {
+        dest[i] = a[i] & ~b[i];
+    }
+#endif
+}
+
+void orInto(uint64_t* dest, const uint64_t* a, int words) {
+#if defined(__AVX2__)
+    for (int i = 0; i < words; i += 4) {
+        __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i));
+        __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_or_si256(left, right));
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < words; i += 2) {
+        __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+        __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_or_si128(left, right));
+    }
+#else
+    for (int i = 0; i < words; i++) {
+        dest[i] |= a[i];
+    }
+#endif
+}
+
+bool intersects(const uint64_t* a, const uint64_t* b, int words) {
+#if defined(__AVX2__)
+    for (int i = 0; i < words; i += 4) {
+        __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        if (!_mm256_testz_si256(left, right)) {
+            return true;
+        }
+    }
+    return false;
+#elif defined(__SSE2__)
+    // SSE2 has no test instruction so we compare every byte of the intersection against zero.
+    const __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < words; i += 2) {
+        __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i both = _mm_and_si128(left, right);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(both, zero)) != 0xFFFF) {
+            return true;
+        }
+    }
+    return false;
+#else
+    for (int i = 0; i < words; i++) {
+        if (a[i] & b[i]) {
+            return true;
+        }
+    }
+    return false;
+#endif
+}
+
+// Neither instruction set can count bits in a vector so the counts stay on whole words.
+int countBits(const uint64_t* a, int words) {
+    int count = 0;
+    for (int i = 0; i < words; i++) {
+        count += countWord(a[i]);
+    }
+    return count;
+}
+
+int countShared(const uint64_t* a, const uint64_t* b, int words) {
+    int count = 0;
+    for (int i = 0; i < words; i++) {
+        count += countWord(a[i] & b[i]);
+    }
+    return count;
+}
+
+int firstBit(const uint64_t* a, int words) {
+    for (int i = 0; i < words; i++) {
+        if (a[i]) {
+            return i * WORD_BITS + lowestBit(a[i]);
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+
+/* * * * * * * * * * * * * * * * *       Bitset Cover Search        * * * * * * * * * * * * * * * */
+
+
+bool DisasterBits::isDisasterReady(int numSupplies, std::set<std::string>& suppliedCities) {
+    return isDisasterReady(numSupplies, suppliedCities, SearchLimits()) == SearchStatus::FOUND;
+}
+
+SearchStatus DisasterBits::isDisasterReady(int numSupplies,
+                                           std::set<std::string>& suppliedCities,
+                                           const SearchLimits& limits) {
+    if (numSupplies < 0) {
+        error("Negative supply quantity is impossible.");
+    }
+    if (numCities_ == 0) {
+        return SearchStatus::FOUND;
+    }
+    cuts_ = {0, 0};
+    nogoods_.prepare();
+    budget_ = SearchBudget(limits);
+    std::vector<int> supplies = {};
+    supplies.reserve(numCities_);
+    if (!isCovered(0, numSupplies, supplies)) {
+        return budget_.isAborted() ? SearchStatus::ABORTED : SearchStatus::INFEASIBLE;
+    }
+    nameSupplies(supplies, suppliedCities);
+    return SearchStatus::FOUND;
+}
+
+bool DisasterBits::isCovered(int depth, int numSupplies, std::vector<int>& supplies) {
+    int chosen = chooseIsolatedCity(depth);
+    if (chosen < 0) {
+        return true;
+    }
+    if (numSupplies <= 0 || budget_.isSpent()
+            || nogoods_.isInfeasible(levelKeys_[depth], numSupplies)
+            || isBeyondBounds(depth, numSupplies)) {
+        return false;
+    }
+    for (int i = tryOffsets_[chosen]; i < tryOffsets_[chosen + 1]; i++) {
+        coverOption(depth, tryOptions_[i]);
+        supplies.push_back(tryOptions_[i]);
+        // Nothing needs to be uncovered on the way back because this level was never changed.
+        if (isCovered(depth + 1, numSupplies - 1, supplies)) {
+            return true;
+        }
+        supplies.pop_back();
+        // An aborted subtree proved nothing so it must not become a nogood.
+        if (budget_.isAborted()) {
+            return false;
+        }
+    }
+    nogoods_.recordInfeasible(levelKeys_[depth], numSupplies);
+    return false;
+}
+
+int DisasterBits::findMinimumSupplies(std::set<std::string>& suppliedCities) {
+    std::set<std::string> bestCities = {};
+    findMinimumSupplies(bestCities, SearchLimits());
+    suppliedCities.insert(bestCities.begin(), bestCities.end());
+    return bestCities.size();
+}
+
+SearchStatus DisasterBits::findMinimumSupplies(std::set<std::string>& suppliedCities,
+                                               const SearchLimits& limits) {
+    if (numCities_ == 0) {
+        return SearchStatus::FOUND;
+    }
+    cuts_ = {0, 0};
+    nogoods_.prepare();
+    budget_ = SearchBudget(limits);
+    /* The heuristic cover is the one to beat so every node only searches for something smaller.
+     * Without one, supplying every city is always a cover.
+     */
+    int bestCount = incumbent_.empty() ? numCities_ + 1 : incumbent_.size();
+    std::vector<int> supplies = {};
+    supplies.reserve(numCities_);
+    std::vector<int> bestSupplies = incumbent_;
+    bestSupplies.reserve(numCities_);
+    fillMinimumSupplies(0, supplies, bestSupplies, bestCount);
+    if (budget_.isAborted()) {
+        nameSupplies(bestSupplies, suppliedCities);
+        return SearchStatus::ABORTED;
+    }
+    if (bestCount > numCities_) {
+        // Only a network built by hand can leave a city that no supply location reaches.
+        error("A city can not be covered by any supply location.");
+    }
+    nameSupplies(bestSupplies, suppliedCities);
+    return SearchStatus::FOUND;
+}
+
+int DisasterBits::findApproximateSupplies(std::set<std::string>& suppliedCities) const {
+    if (numCities_ == 0) {
+        return 0;
+    }
+    if (incumbent_.empty()) {
+        // Only a network built by hand can leave a city that no supply location reaches.
+        error("A city can not be covered by any supply location.");
+    }
+    nameSupplies(incumbent_, suppliedCities);
+    return incumbent_.size();
+}
+
+void DisasterBits::fillMinimumSupplies(int depth,
+                                       std::vector<int>& supplies,
+                                       std::vector<int>& bestSupplies,
+                                       int& bestCount) {
+    int chosen = chooseIsolatedCity(depth);
+    if (chosen < 0) {
+        // We only give out supplies while we can beat the best so this cover is the new best.
+        bestSupplies = supplies;
+        bestCount = supplies.size();
+        return;
+    }
+    int numSupplies = bestCount - 1 - supplies.size();
+    if (numSupplies <= 0 || budget_.isSpent()
+            || nogoods_.isInfeasible(levelKeys_[depth], numSupplies)
+            || isBeyondBounds(depth, numSupplies)) {
+        return;
+    }
+    int previousBest = bestCount;
+
+    for (int i = tryOffsets_[chosen];
+             i < tryOffsets_[chosen + 1] && (int)supplies.size() < bestCount - 1
+                 && !budget_.isAborted();
+             i++) {
+        coverOption(depth, tryOptions_[i]);
+        supplies.push_back(tryOptions_[i]);
+        fillMinimumSupplies(depth + 1, supplies, bestSupplies, bestCount);
+        supplies.pop_back();
+    }
+    // Only a subtree that never beat the best was searched in full with these supplies.
+    if (bestCount == previousBest && !budget_.isAborted()) {
+        nogoods_.recordInfeasible(levelKeys_[depth], numSupplies);
+    }
+}
+
+std::set<std::set<std::string>> DisasterBits::getAllDisasterConfigurations(int numSupplies) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
+    }
+    std::vector<int> supplies = {};
+    supplies.reserve(numCities_);
+    std::set<std::set<std::string>> allConfigurations = {};
+    fillConfigurations(0, numSupplies, supplies, allConfigurations);
+    return allConfigurations;
+}
+
+void DisasterBits::fillConfigurations(int depth,
+                                      int numSupplies,
+                                      std::vector<int>& supplies,
+                                      std::set<std::set<std::string>>& allConfigurations) {
+    int chosen = chooseIsolatedCity(depth);
+    if (chosen < 0) {
+        std::set<std::string> suppliedCities = {};
+        nameSupplies(supplies, suppliedCities);
+        allConfigurations.insert(suppliedCities);
+        return;
+    }
+    if (numSupplies <= 0) {
+        return;
+    }
+    for (int i = tryOffsets_[chosen]; i < tryOffsets_[chosen + 1]; i++) {
+        coverOption(depth, tryOptions_[i]);
+        supplies.push_back(tryOptions_[i]);
+        fillConfigurations(depth + 1, numSupplies - 1, supplies, allConfigurations);
+        supplies.pop_back();
+    }
+}
+
+std::vector<std::set<std::string>> DisasterBits::getUniqueDisasterConfigurations(int numSupplies) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
+    }
+    std::vector<int> supplies = {};
+    supplies.reserve(numCities_);
+    std::vector<std::set<std::string>> allConfigurations = {};
+    visitUniqueConfigurations(0, numSupplies, supplies, [&](const std::vector<int>& found) {
+        allConfigurations.emplace_back();
+        nameSupplies(found, allConfigurations.back());
+        return true;
+    });
+    return allConfigurations;
+}
+
+uint64_t DisasterBits::countDisasterConfigurations(int numSupplies) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
+    }
+    std::vector<int> supplies = {};
+    supplies.reserve(numCities_);
+    uint64_t count = 0;
+    visitUniqueConfigurations(0, numSupplies, supplies, [&](const std::vector<int>&) {
+        count++;
+        return true;
+    });
+    return count;
+}
+
+bool DisasterBits::visitDisasterConfigurations(int numSupplies,
+                                               const ConfigurationVisitor& visit) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
+    }
+    std::vector<int> supplies = {};
+    supplies.reserve(numCities_);
+    return visitUniqueConfigurations(0, numSupplies, supplies, visit);
+}
+
+const std::string& DisasterBits::getSupplyName(int option) const {
+    return supplyNames_[option];
+}
+
+template <typename Visit>
+bool DisasterBits::visitUniqueConfigurations(int depth,
+                                             int numSupplies,
+                                             std::vector<int>& supplies,
+                                             const Visit& visit) {
+    int chosen = chooseIsolatedCity(depth);
+    if (chosen < 0) {
+        return visit(supplies);
+    }
+    if (numSupplies <= 0) {
+        return true;
+    }
+    bool isSearching = true;
+    for (int i = tryOffsets_[chosen]; i < tryOffsets_[chosen + 1] && isSearching; i++) {
+        int option = tryOptions_[i];
+        if (forbiddenAt_[option]) {
+            continue;
+        }
+        coverOption(depth, option);
+        supplies.push_back(option);
+        isSearching = visitUniqueConfigurations(depth + 1, numSupplies - 1, supplies, visit);
+        supplies.pop_back();
+        // Every configuration with this supply location has been found. Siblings may not use it.
+        forbiddenAt_[option] = depth + 1;
+    }
+    // Options forbidden further up the tree stay forbidden for the rest of their own loop.
+    for (int i = tryOffsets_[chosen]; i < tryOffsets_[chosen + 1]; i++) {
+        if (forbiddenAt_[tryOptions_[i]] == depth + 1) {
+            forbiddenAt_[tryOptions_[i]] = 0;
+        }
+    }
+    return isSearching;
+}
+
+DisasterBits::BoundCuts DisasterBits::getBoundCuts() const {
+    return cuts_;
+}
+
+NogoodTable::NogoodStats DisasterBits::getNogoodStats() const {
+    return nogoods_.getStats();
+}
+
+void DisasterBits::coverOption(int depth, int option) {
+    const uint64_t* uncovered = levels_.data() + depth * cityWords_;
+    const uint64_t* cities = optionCities_.data() + option * cityWords_;
+    andNot(levels_.data() + (depth + 1) * cityWords_, uncovered, cities, cityWords_);
+    // The cities this option covers for the first time leave the key of the level below.
+    uint64_t key = levelKeys_[depth];
+    for (int word = 0; word < cityWords_; word++) {
+        for (uint64_t covered = uncovered[word] & cities[word]; covered; covered &= covered - 1) {
+            key ^= cityKeys_[word * WORD_BITS + lowestBit(covered)];
+        }
+    }
+    levelKeys_[depth + 1] = key;
+}
+
+int DisasterBits::chooseIsolatedCity(int depth) const {
+    return firstBit(levels_.data() + depth * cityWords_, cityWords_);
+}
+
+bool DisasterBits::isBeyondBounds(int depth, int numSupplies) {
+    const uint64_t* uncovered = levels_.data() + depth * cityWords_;
+    // Some supply must cover at least this many uncovered cities or we fall short.
+    int needed = (countBits(uncovered, cityWords_) + numSupplies - 1) / numSupplies;
+    bool isReachable = false;
+    for (int i = 0; i < (int)optionsBySize_.size() && !isReachable; i++) {
+        const uint64_t* cities = optionCities_.data() + optionsBySize_[i] * cityWords_;
+        // Options are sorted by size so once one is too small to help none of the rest can.
+        if (countBits(cities, cityWords_) < needed) {
+            break;
+        }
+        isReachable = countShared(cities, uncovered, cityWords_) >= needed;
+    }
+    if (!isReachable) {
+        cuts_.optionSize++;
+        return true;
+    }
+    // Cities that share no option must each be covered by a different supply.
+    if (packCities(depth, numSupplies) > numSupplies) {
+        cuts_.packing++;
+        return true;
+    }
+    return false;
+}
+
+int DisasterBits::packCities(int depth, int limit) {
+    std::fill(packed_.begin(), packed_.end(), 0);
+    const uint64_t* uncovered = levels_.data() + depth * cityWords_;
+    int packed = 0;
+    for (int word = 0; word < cityWords_; word++) {
+        for (uint64_t cities = uncovered[word]; cities; cities &= cities - 1) {
+            int city = word * WORD_BITS + lowestBit(cities);
+            const uint64_t* options = cityOptions_.data() + city * optionWords_;
+            if (!intersects(options, packed_.data(), optionWords_)) {
+                orInto(packed_.data(), options, optionWords_);
+                if (++packed > limit) {
+                    return packed;
+                }
+            }
+        }
+    }
+    return packed;
+}
+
+void DisasterBits::nameSupplies(const std::vector<int>& supplies,
+                                std::set<std::string>& suppliedCities) const {
+    for (int option : supplies) {
+        suppliedCities.insert(supplyNames_[option]);
+    }
+}
+
+
+/* * * * * * * * * * * * * * * * *       Building the Bitsets       * * * * * * * * * * * * * * * */
+
+
+DisasterBits::DisasterBits(const std::map<std::string, std::set<std::string>>& roadNetwork)
+    : DisasterBits(NetworkGraph(roadNetwork)) {}
+
+DisasterBits::DisasterBits(const NetworkGraph& roadNetwork)
+    : DisasterBits(CoverNetwork(roadNetwork)) {}
+
+DisasterBits::DisasterBits(const CoverNetwork& roadNetwork)
+    : numCities_(roadNetwork.numItems()),
+      numOptions_(roadNetwork.numOptions()),
+      cityWords_(wordsFor(roadNetwork.numItems())),
+      optionWords_(wordsFor(roadNetwork.numOptions())),
+      optionCities_(),
+      cityOptions_(),
+      tryOffsets_(),
+      tryOptions_(),
+      optionsBySize_(),
+      supplyNames_(),
+      levels_(),
+      packed_(),
+      forbiddenAt_(),
+      cuts_({0, 0}),
+      cityKeys_(),
+      levelKeys_(),
+      nogoods_(),
+      budget_(),
+      incumbent_() {
+    std::vector<int> internalId = initializeCities(roadNetwork);
+    initializeOptions(roadNetwork, internalId);
+
+    DisasterHeuristic heuristic(roadNetwork);
+    if (heuristic.isComplete()) {
+        incumbent_ = heuristic.getCover();
+    }
+}
+
+std::vector<int> DisasterBits::initializeCities(const CoverNetwork& roadNetwork) {
+    std::vector<int> numCovering(numCities_, 0);
+    for (int entry = 0; entry < roadNetwork.numEntries(); entry++) {
+        numCovering[roadNetwork.item(entry)]++;
+    }
+    /* The linked solvers choose the first city in the order of the network among those with the
+     * fewest options. A stable sort by the number of options gives us that same order, so the city
+     * they would choose is always our first uncovered city.
+     */
+    std::vector<int> order(numCities_);
+    for (int city = 0; city < numCities_; city++) {
+        order[city] = city;
+    }
+    std::stable_sort(order.begin(), order.end(), [&numCovering](int left, int right) {
+        return numCovering[left] < numCovering[right];
+    });
+    std::vector<int> internalId(numCities_);
+    cityKeys_.reserve(numCities_);
+    for (int city = 0; city < numCities_; city++) {
+        internalId[order[city]] = city;
+        cityKeys_.push_back(NogoodTable::itemKey(city + 1));
+    }
+    return internalId;
+}
+
+void DisasterBits::initializeOptions(const CoverNetwork& roadNetwork,
+                                     const std::vector<int>& internalId) {
+    optionCities_.assign((size_t)numOptions_ * cityWords_, 0);
+    cityOptions_.assign((size_t)numCities_ * optionWords_, 0);
+    supplyNames_.reserve(numOptions_);
+    for (int option = 0; option < numOptions_; option++) {
+        supplyNames_.push_back(roadNetwork.optionName(option));
+        // An option that covers nothing can never help so no city will try it.
+        if (roadNetwork.optionSize(option)) {
+            optionsBySize_.push_back(option);
+        }
+    }
+    // Every city tries the most connected supply location nearby first, just as in the links.
+    std::stable_sort(optionsBySize_.begin(), optionsBySize_.end(), [&](int left, int right) {
+        return roadNetwork.optionSize(left) > roadNetwork.optionSize(right);
+    });
+
+    tryOffsets_.assign(numCities_ + 1, 0);
+    for (int entry = 0; entry < roadNetwork.numEntries(); entry++) {
+        tryOffsets_[internalId[roadNetwork.item(entry)] + 1]++;
+    }
+    for (int city = 0; city < numCities_; city++) {
+        tryOffsets_[city + 1] += tryOffsets_[city];
+    }
+    tryOptions_.resize(roadNetwork.numEntries());
+    std::vector<int> next(tryOffsets_.begin(), tryOffsets_.end() - 1);
+    for (int option : optionsBySize_) {
+        uint64_t* cities = optionCities_.data() + option * cityWords_;
+        for (int entry = roadNetwork.optionBegin(option); entry < roadNetwork.optionEnd(option);
+                entry++) {
+            int city = internalId[roadNetwork.item(entry)];
+            cities[city / WORD_BITS] |= uint64_t(1) << (city % WORD_BITS);
+            cityOptions_[city * optionWords_ + option / WORD_BITS]
+                |= uint64_t(1) << (option % WORD_BITS);
+            tryOptions_[next[city]++] = option;
+        }
+    }
+
+    // Every city starts uncovered so the first level and its key hold every city.
+    levels_.assign((size_t)(numCities_ + 1) * cityWords_, 0);
+    levelKeys_.assign(numCities_ + 1, 0);
+    for (int city = 0; city < numCities_; city++) {
+        levels_[city / WORD_BITS] |= uint64_t(1) << (city % WORD_BITS);
+        levelKeys_[0] ^= cityKeys_[city];
+    }
+    packed_.assign(optionWords_, 0);
+    forbiddenAt_.assign(numOptions_, 0);
+}
+
+} // namespace DancingLinks
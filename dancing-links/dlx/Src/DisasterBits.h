@@ -0,0 +1,327 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: DisasterBits.h
+ * --------------------------
+ * This file defines a third solver for the disaster planning problem that trades the dancing links
+ * for bitsets. For the maps in Data/disaster-planning the cities a supply location covers fit in a
+ * handful of 64 bit words. Every option is stored as a bitset of the cities it covers and the
+ * search keeps one bitset of uncovered cities for each level of recursion. Covering a city is then
+ * a single AND NOT of two short bitsets into the next level, and uncovering is free because we
+ * simply return to the level above.
+ *
+ * Cities are numbered internally in the order the linked solvers would choose them, fewest options
+ * first with ties broken by name. Choosing the most isolated city is then a scan for the first set
+ * bit and the counting of uncovered cities and live options is done with popcounts.
+ *
+ * Bitsets are padded to a multiple of four words. The kernels use AVX2 when the compiler targets
+ * it, such as with -mavx2 or -march=native, SSE2 on any other x86-64 build, and plain loops over
+ * 64 bit words everywhere else. All three give the same answers.
+ */
+#ifndef DISASTERBITS_H
+#define DISASTERBITS_H
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "GUI/SimpleTest.h"
+#include "DisasterHeuristic.h"
+#include "NetworkGraph.h"
+#include "NogoodTable.h"
+#include "SearchLimits.h"
+
+namespace DancingLinks {
+
+class DisasterBits {
+
+public:
+
+
+    /**
+     * @brief DisasterBits  turns a std::map representation of a transportation grid into the
+     *                      bitsets we search.
+     * @param roadNetwork   the transportation grid passed in via map form.
+     */
+    explicit DisasterBits(const std::map<std::string, std::set<std::string>>& roadNetwork);
+
+    /**
+     * @brief DisasterBits  builds the bitsets from a compact graph of the transportation grid.
+     * @param roadNetwork   the transportation grid as a graph of city ids.
+     */
+    explicit DisasterBits(const NetworkGraph& roadNetwork);
+
+    /**
+     * @brief DisasterBits  builds the bitsets from the cities that must be covered and the supply
+     *                      options that cover them, such as a reduced network or one component.
+     * @param roadNetwork   the cities to cover and the cities each supply location covers.
+     */
+    explicit DisasterBits(const CoverNetwork& roadNetwork);
+
+    /**
+     * @brief isDisasterReady  determines if the transportation grid can be covered with the given
+     *                         number of supplies. A city is covered if it has supplies or is
+     *                         adjacent to a city with supplies.
+     * @param numSupplies      the limiting number of supplies we must distribute.
+     * @param suppliedCities   the output parameter telling which cities received supplies.
+     * @return                 true if we have found a viable supply scheme, false if not.
+     */
+    bool isDisasterReady(int numSupplies, std::set<std::string>& suppliedCities);
+
+    /**
+     * @brief isDisasterReady  performs the same search as above but gives up once any limit is
+     *                         reached. An aborted search tells us nothing about the network.
+     * @param numSupplies      the limiting number of supplies we must distribute.
+     * @param suppliedCities   the output parameter telling which cities received supplies.
+     * @param limits           the node, time, and cancellation limits for the search.
+     * @return                 FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+     */
+    SearchStatus isDisasterReady(int numSupplies,
+                                 std::set<std::string>& suppliedCities,
+                                 const SearchLimits& limits);
+
+    /**
+     * @brief findMinimumSupplies  finds the fewest supplies that can cover the transportation grid
+     *                             in a single branch and bound search.
+     * @param suppliedCities       the output parameter holding the cities of an optimal cover.
+     * @return                     the minimum number of supplies needed to cover every city.
+     */
+    int findMinimumSupplies(std::set<std::string>& suppliedCities);
+
+    /**
+     * @brief findMinimumSupplies  performs the same search as above but gives up once any limit is
+     *                             reached. An aborted search still reports the smallest cover it
+     *                             found, which is never worse than the heuristic cover.
+     * @param suppliedCities       the output parameter holding the cities of the best cover found.
+     * @param limits               the node, time, and cancellation limits for the search.
+     * @return                     FOUND if the cover is proven optimal or ABORTED by a limit.
+     */
+    SearchStatus findMinimumSupplies(std::set<std::string>& suppliedCities,
+                                     const SearchLimits& limits);
+
+    /**
+     * @brief findApproximateSupplies  reports the cover the greedy and local search heuristic
+     *                                 found when the network was built. It needs no search at all
+     *                                 and is the cover findMinimumSupplies starts out trying to
+     *                                 beat, so it is often optimal but is never guaranteed to be.
+     * @param suppliedCities           the output parameter holding the cities of the cover.
+     * @return                         the number of supplies in the heuristic cover.
+     */
+    int findApproximateSupplies(std::set<std::string>& suppliedCities) const;
+
+    /**
+     * @brief getAllDisasterConfigurations  returns every disaster configuration possible with a
+     *                                      given supply count. Duplicates are filtered by a set
+     *                                      just as the linked solvers do.
+     * @param numSupplies                   the number of supplies we have to distribute.
+     * @return                              all possible distributions of the supplies.
+     */
+    std::set<std::set<std::string>> getAllDisasterConfigurations(int numSupplies);
+
+    /**
+     * @brief getUniqueDisasterConfigurations  returns every disaster configuration possible with a
+     *                                         given supply count, generating each one once. An
+     *                                         option is forbidden below its later siblings once
+     *                                         every configuration that uses it has been found.
+     * @param numSupplies                      the number of supplies we have to distribute.
+     * @return                                 all possible distributions of the supplies.
+     */
+    std::vector<std::set<std::string>> getUniqueDisasterConfigurations(int numSupplies);
+
+    /**
+     * @brief countDisasterConfigurations  counts the configurations getUniqueDisasterConfigurations
+     *                                     would return without building any of them.
+     * @param numSupplies                  the number of supplies we have to distribute.
+     * @return                             the number of distinct distributions of the supplies.
+     */
+    uint64_t countDisasterConfigurations(int numSupplies);
+
+    // A visitor sees the option ids of every configuration as it is found. True keeps searching.
+    using ConfigurationVisitor = std::function<bool(const std::vector<int>& supplies)>;
+
+    /**
+     * @brief visitDisasterConfigurations  hands each configuration getUniqueDisasterConfigurations
+     *                                     would return to a visitor the moment it is found.
+     * @param numSupplies                  the number of supplies we have to distribute.
+     * @param visit                        the visitor called with the option ids of every cover.
+     * @return                             true if every configuration was visited, false if the
+     *                                     visitor stopped the search early.
+     */
+    bool visitDisasterConfigurations(int numSupplies, const ConfigurationVisitor& visit);
+
+    /**
+     * @brief getSupplyName  names the city holding an option id given to a visitor.
+     * @param option         the option id of a supplied city.
+     * @return               the name of the city receiving supplies.
+     */
+    const std::string& getSupplyName(int option) const;
+
+    // The number of nodes each lower bound cut from the tree during the last search.
+    struct BoundCuts {
+        long long optionSize;
+        long long packing;
+    };
+
+    BoundCuts getBoundCuts() const;
+
+    NogoodTable::NogoodStats getNogoodStats() const;
+
+
+private:
+
+
+    int numCities_;
+    int numOptions_;
+    // Words in a bitset of cities and in a bitset of options, each a multiple of four.
+    int cityWords_;
+    int optionWords_;
+    // The cities each option covers, one bitset of cityWords_ after another.
+    std::vector<uint64_t> optionCities_;
+    // The options that cover each city, one bitset of optionWords_ after another.
+    std::vector<uint64_t> cityOptions_;
+    // The options of each city in the order we try them, largest option first, in CSR form.
+    std::vector<int> tryOffsets_;
+    std::vector<int> tryOptions_;
+    // Every option that covers a city, largest first, for the bound on the largest live option.
+    std::vector<int> optionsBySize_;
+    std::vector<std::string> supplyNames_;
+
+    /* The uncovered cities at every depth of the search. Depth d starts at d * cityWords_. Every
+     * supply covers the city we chose so there is never a deeper level than there are cities.
+     */
+    std::vector<uint64_t> levels_;
+    // The options already claimed by a city while packing cities for the lower bound.
+    std::vector<uint64_t> packed_;
+    // The depth plus one at which an option was forbidden while listing unique configurations.
+    std::vector<int> forbiddenAt_;
+    BoundCuts cuts_;
+    // A Zobrist key per city and the key of the uncovered cities at every depth.
+    std::vector<uint64_t> cityKeys_;
+    std::vector<uint64_t> levelKeys_;
+    NogoodTable nogoods_;
+    // The decision and minimum searches spend this budget so a caller may bound them.
+    SearchBudget budget_;
+    // The heuristic cover of the network as option ids. Empty if some city can not be covered.
+    std::vector<int> incumbent_;
+
+
+    /* * * * * * * * * * * * * * *        Bitset Cover Search        * * * * * * * * * * * * * * */
+
+
+    /**
+     * @brief isCovered    searches for a cover of the cities left uncovered at a depth.
+     * @param depth        the level of the uncovered cities we must cover.
+     * @param numSupplies  the number of supplies we have left.
+     * @param supplies     the stack of options we supply. Holds the cover if we succeed.
+     * @return             true if the remaining cities can be covered, false if not.
+     */
+    bool isCovered(int depth, int numSupplies, std::vector<int>& supplies);
+
+    /**
+     * @brief fillMinimumSupplies  searches for a cover smaller than the best found so far.
+     * @param depth                the level of the uncovered cities we must cover.
+     * @param supplies             the stack of options we have supplied on the way to this point.
+     * @param bestSupplies         the output parameter holding the smallest cover found so far.
+     * @param bestCount            the size of the smallest cover found so far.
+     */
+    void fillMinimumSupplies(int depth,
+                             std::vector<int>& supplies,
+                             std::vector<int>& bestSupplies,
+                             int& bestCount);
+
+    /**
+     * @brief fillConfigurations  finds all distributions of the given number of supplies.
+     * @param depth               the level of the uncovered cities we must cover.
+     * @param numSupplies         the number of supplies we have to distribute.
+     * @param supplies            the stack of options supplied in the configuration we build.
+     * @param allConfigurations   the set that records all configurations found.
+     */
+    void fillConfigurations(int depth,
+                            int numSupplies,
+                            std::vector<int>& supplies,
+                            std::set<std::set<std::string>>& allConfigurations);
+
+    /**
+     * @brief visitUniqueConfigurations  finds all distributions of the given number of supplies
+     *                                   without duplicates by forbidding explored options.
+     * @param depth                      the level of the uncovered cities we must cover.
+     * @param numSupplies                the number of supplies we have to distribute.
+     * @param supplies                   the stack of options supplied in the configuration so far.
+     * @param visit                      called with the stack at every cover. False stops the search.
+     * @return                           true if the search ran to the end, false if it was stopped.
+     */
+    template <typename Visit>
+    bool visitUniqueConfigurations(int depth,
+                                   int numSupplies,
+                                   std::vector<int>& supplies,
+                                   const Visit& visit);
+
+    /**
+     * @brief coverOption  writes the cities still uncovered after supplying an option into the
+     *                     next level. The current level is left alone for the next sibling.
+     * @param depth        the level we are covering from.
+     * @param option       the option we supply.
+     */
+    void coverOption(int depth, int option);
+
+    /**
+     * @brief chooseIsolatedCity  finds the uncovered city with the fewest options. Cities are
+     *                            numbered in that order so it is the first uncovered city.
+     * @param depth               the level of the uncovered cities.
+     * @return                    the internal number of the city or -1 if every city is covered.
+     */
+    int chooseIsolatedCity(int depth) const;
+
+    /**
+     * @brief isBeyondBounds  checks if the uncovered cities need more supplies than we have left,
+     *                        using the same largest option and packing bounds as the linked
+     *                        solvers.
+     * @param depth           the level of the uncovered cities.
+     * @param numSupplies     the number of supplies we have left to distribute.
+     * @return                true if either bound exceeds our supplies and we may stop searching.
+     */
+    bool isBeyondBounds(int depth, int numSupplies);
+
+    /**
+     * @brief packCities  greedily collects uncovered cities that share no option. Each of them
+     *                    needs its own supply so their count is a lower bound on supplies needed.
+     * @param depth       the level of the uncovered cities.
+     * @param limit       the number of supplies left. We stop counting once we pass it.
+     * @return            the number of cities packed, at most one more than the limit.
+     */
+    int packCities(int depth, int limit);
+
+    /**
+     * @brief nameSupplies     resolves the options on a stack of supplies to the names of the
+     *                         cities holding them.
+     * @param supplies         the option ids of the cities we supplied.
+     * @param suppliedCities   the output parameter to which we add the names of supplied cities.
+     */
+    void nameSupplies(const std::vector<int>& supplies,
+                      std::set<std::string>& suppliedCities) const;
+
+
+    /* * * * * * * * * * * * * *         Building the Bitsets           * * * * * * * * * * * * * */
+
+
+    /**
+     * @brief initializeCities  numbers the cities fewest options first and gives each a key.
+     * @param roadNetwork       the cities to cover and the cities each option covers.
+     * @return                  the internal number of every city indexed by its network id.
+     */
+    std::vector<int> initializeCities(const CoverNetwork& roadNetwork);
+
+    /**
+     * @brief initializeOptions  fills the bitsets of every option and city and the order in which
+     *                           we try the options of each city.
+     * @param roadNetwork        the cities to cover and the cities each option covers.
+     * @param internalId         the internal number of every city indexed by its network id.
+     */
+    void initializeOptions(const CoverNetwork& roadNetwork, const std::vector<int>& internalId);
+
+    ALLOW_TEST_ACCESS();
+};
+
+} // namespace DancingLinks
+
+#endif // DISASTERBITS_H
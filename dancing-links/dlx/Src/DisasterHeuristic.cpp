@@ -0,0 +1,211 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: DisasterHeuristic.cpp
+ * --------------------------
+ * This file contains the implementation of the greedy and local search heuristic for the disaster
+ * planning problem. Every stage only needs to know how many supplies cover each city, so we keep
+ * that count current as supplies come and go and read everything else from the network.
+ */
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include "DisasterHeuristic.h"
+
+namespace DancingLinks {
+
+
+/* * * * * * * * * * * * * * * *    Greedy Cover and Local Search     * * * * * * * * * * * * * * */
+
+
+DisasterHeuristic::DisasterHeuristic(const std::map<std::string,
+                                     std::set<std::string>>& roadNetwork)
+    : DisasterHeuristic(NetworkGraph(roadNetwork)) {}
+
+DisasterHeuristic::DisasterHeuristic(const NetworkGraph& roadNetwork)
+    : DisasterHeuristic(CoverNetwork(roadNetwork)) {}
+
+DisasterHeuristic::DisasterHeuristic(const CoverNetwork& roadNetwork)
+    : network_(roadNetwork),
+      itemOffsets_(roadNetwork.numItems() + 1, 0),
+      itemOptions_(roadNetwork.numEntries()),
+      coverCount_(roadNetwork.numItems(), 0),
+      isChosen_(roadNetwork.numOptions(), false),
+      cover_(),
+      itemStamp_(roadNetwork.numItems(), 0),
+      stamp_(0),
+      isComplete_(true),
+      counts_({0, 0, 0}) {
+    for (int entry = 0; entry < network_.numEntries(); entry++) {
+        itemOffsets_[network_.item(entry) + 1]++;
+    }
+    for (int item = 0; item < network_.numItems(); item++) {
+        itemOffsets_[item + 1] += itemOffsets_[item];
+    }
+    // Options are visited in order so the options of every item are listed in ascending order.
+    std::vector<int> next(itemOffsets_.begin(), itemOffsets_.end() - 1);
+    for (int option = 0; option < network_.numOptions(); option++) {
+        int end = network_.optionEnd(option);
+        for (int entry = network_.optionBegin(option); entry < end; entry++) {
+            itemOptions_[next[network_.item(entry)]++] = option;
+        }
+    }
+
+    greedyCover();
+    counts_.greedySupplies = cover_.size();
+    // An exchange can leave more than one supply redundant so we drop again after every trade.
+    do {
+        dropRedundant();
+    } while (exchangeTwoForOne());
+    std::sort(cover_.begin(), cover_.end());
+}
+
+void DisasterHeuristic::greedyCover() {
+    int numUncovered = 0;
+    for (int item = 0; item < network_.numItems(); item++) {
+        if (itemOffsets_[item] == itemOffsets_[item + 1]) {
+            isComplete_ = false;
+        } else {
+            numUncovered++;
+        }
+    }
+    // The largest gain comes out first and ties go to the lowest option id.
+    std::priority_queue<std::pair<int,int>> gains = {};
+    for (int option = 0; option < network_.numOptions(); option++) {
+        if (network_.optionSize(option)) {
+            gains.push({network_.optionSize(option), -option});
+        }
+    }
+    while (numUncovered && !gains.empty()) {
+        int gain = gains.top().first;
+        int option = -gains.top().second;
+        gains.pop();
+        int fresh = 0;
+        int end = network_.optionEnd(option);
+        for (int entry = network_.optionBegin(option); entry < end; entry++) {
+            fresh += coverCount_[network_.item(entry)] == 0;
+        }
+        // Gains only shrink, so an option that still has its old gain beats every other option.
+        if (fresh < gain) {
+            if (fresh) {
+                gains.push({fresh, -option});
+            }
+            continue;
+        }
+        chooseOption(option);
+        cover_.push_back(option);
+        numUncovered -= fresh;
+    }
+}
+
+bool DisasterHeuristic::dropRedundant() {
+    bool isDropped = false;
+    for (int i = cover_.size() - 1; i >= 0; i--) {
+        if (isRedundant(cover_[i])) {
+            unchooseOption(cover_[i]);
+            cover_.erase(cover_.begin() + i);
+            counts_.droppedSupplies++;
+            isDropped = true;
+        }
+    }
+    return isDropped;
+}
+
+bool DisasterHeuristic::exchangeTwoForOne() {
+    std::vector<int> onlyHere = {};
+    for (int i = 0; i < (int)cover_.size(); i++) {
+        int out = cover_[i];
+        onlyHere.clear();
+        for (int entry = network_.optionBegin(out); entry < network_.optionEnd(out); entry++) {
+            if (coverCount_[network_.item(entry)] == 1) {
+                onlyHere.push_back(network_.item(entry));
+            }
+        }
+        if (onlyHere.empty()) {
+            continue;
+        }
+        // Any replacement must cover the first city only this supply covers, so it is a neighbor.
+        int city = onlyHere[0];
+        for (int k = itemOffsets_[city]; k < itemOffsets_[city + 1]; k++) {
+            int in = itemOptions_[k];
+            if (isChosen_[in]) {
+                continue;
+            }
+            stamp_++;
+            for (int entry = network_.optionBegin(in); entry < network_.optionEnd(in); entry++) {
+                itemStamp_[network_.item(entry)] = stamp_;
+            }
+            if (!std::all_of(onlyHere.begin(), onlyHere.end(), [this](int item) {
+                    return itemStamp_[item] == stamp_;
+                })) {
+                continue;
+            }
+            unchooseOption(out);
+            chooseOption(in);
+            // Only supplies that share a city with the new supply can have become redundant.
+            for (int entry = network_.optionBegin(in); entry < network_.optionEnd(in); entry++) {
+                int item = network_.item(entry);
+                for (int j = itemOffsets_[item]; j < itemOffsets_[item + 1]; j++) {
+                    int other = itemOptions_[j];
+                    if (other != in && isChosen_[other] && isRedundant(other)) {
+                        unchooseOption(other);
+                        cover_[i] = in;
+                        cover_.erase(std::find(cover_.begin(), cover_.end(), other));
+                        counts_.exchanges++;
+                        return true;
+                    }
+                }
+            }
+            unchooseOption(in);
+            chooseOption(out);
+        }
+    }
+    return false;
+}
+
+bool DisasterHeuristic::isRedundant(int option) const {
+    for (int entry = network_.optionBegin(option); entry < network_.optionEnd(option); entry++) {
+        if (coverCount_[network_.item(entry)] < 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DisasterHeuristic::chooseOption(int option) {
+    isChosen_[option] = true;
+    for (int entry = network_.optionBegin(option); entry < network_.optionEnd(option); entry++) {
+        coverCount_[network_.item(entry)]++;
+    }
+}
+
+void DisasterHeuristic::unchooseOption(int option) {
+    isChosen_[option] = false;
+    for (int entry = network_.optionBegin(option); entry < network_.optionEnd(option); entry++) {
+        coverCount_[network_.item(entry)]--;
+    }
+}
+
+
+/* * * * * * * * * * * * * * * * * *    Reporting the Cover     * * * * * * * * * * * * * * * * * */
+
+
+int DisasterHeuristic::getSupplies(std::set<std::string>& suppliedCities) const {
+    for (int option : cover_) {
+        suppliedCities.insert(network_.optionName(option));
+    }
+    return cover_.size();
+}
+
+const std::vector<int>& DisasterHeuristic::getCover() const {
+    return cover_;
+}
+
+bool DisasterHeuristic::isComplete() const {
+    return isComplete_;
+}
+
+DisasterHeuristic::HeuristicCounts DisasterHeuristic::getCounts() const {
+    return counts_;
+}
+
+} // namespace DancingLinks
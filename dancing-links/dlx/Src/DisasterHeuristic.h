@@ -0,0 +1,149 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: DisasterHeuristic.h
+ * --------------------------
+ * This file defines a fast heuristic for the disaster planning problem. A minimum supply search
+ * can only prune a branch once it holds a cover to beat, and until it finds a good one it wanders
+ * through branches a tight bound would have cut at once. A heuristic cover costs almost nothing to
+ * find, so the exact searches start with it as their best cover and only search for smaller ones.
+ * Callers that accept an approximate answer may take the heuristic cover and never search at all.
+ *
+ *      - Greedy selection supplies the location that covers the most uncovered cities until every
+ *        city is covered.
+ *      - A drop removes a supply location whose cities are all covered by other supplies.
+ *      - A 2-for-1 exchange swaps one supply location for another that covers every city only the
+ *        first one covered. If that leaves some other supply redundant we drop it and have traded
+ *        two supplies for one.
+ *
+ * The local search repeats drops and exchanges until neither finds anything. The cover it returns
+ * is always a cover but is not always a minimum.
+ */
+#ifndef DISASTERHEURISTIC_H
+#define DISASTERHEURISTIC_H
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "GUI/SimpleTest.h"
+#include "NetworkGraph.h"
+
+namespace DancingLinks {
+
+class DisasterHeuristic {
+
+public:
+
+
+    /**
+     * @brief DisasterHeuristic  covers a transportation grid given in the map form the solvers
+     *                           have always accepted.
+     * @param roadNetwork        the map of each city to the cities it is connected to.
+     */
+    explicit DisasterHeuristic(const std::map<std::string, std::set<std::string>>& roadNetwork);
+
+    /**
+     * @brief DisasterHeuristic  covers a transportation grid given as a graph of city ids.
+     * @param roadNetwork        the graph of cities connected to other cities.
+     */
+    explicit DisasterHeuristic(const NetworkGraph& roadNetwork);
+
+    /**
+     * @brief DisasterHeuristic  runs greedy selection and then the local search on the network.
+     *                           All of the work happens here so the cover is ready at once.
+     * @param roadNetwork        the cities to cover and the cities each supply location covers.
+     */
+    explicit DisasterHeuristic(const CoverNetwork& roadNetwork);
+
+    /**
+     * @brief getSupplies     reports the names of the supply locations in the heuristic cover.
+     * @param suppliedCities  the output parameter holding the cities that received supplies.
+     * @return                the number of supplies in the cover.
+     */
+    int getSupplies(std::set<std::string>& suppliedCities) const;
+
+    /**
+     * @brief getCover  the heuristic cover as option ids of the network, in ascending order.
+     * @return          the options we supplied.
+     */
+    const std::vector<int>& getCover() const;
+
+    /**
+     * @brief isComplete  reports if the cover reaches every city. Only a network built by hand can
+     *                    have a city no supply location reaches.
+     * @return            true if every city is covered.
+     */
+    bool isComplete() const;
+
+    // How much each stage contributed to the cover.
+    struct HeuristicCounts {
+        int greedySupplies;
+        int droppedSupplies;
+        int exchanges;
+    };
+
+    HeuristicCounts getCounts() const;
+
+
+private:
+
+
+    CoverNetwork network_;
+    // The options that cover each item in CSR form, the mirror image of the network's arrays.
+    std::vector<int> itemOffsets_;
+    std::vector<int> itemOptions_;
+    // How many chosen options cover each item.
+    std::vector<int> coverCount_;
+    std::vector<bool> isChosen_;
+    std::vector<int> cover_;
+    // An exchange marks the items of the option it tries. Stamps save us from clearing marks.
+    std::vector<int> itemStamp_;
+    int stamp_;
+    bool isComplete_;
+    HeuristicCounts counts_;
+
+
+    /**
+     * @brief greedyCover  supplies the location covering the most uncovered cities until no
+     *                     location covers anything new. Stale gains are refreshed lazily.
+     */
+    void greedyCover();
+
+    /**
+     * @brief dropRedundant  removes every supply whose cities are all covered by other supplies.
+     *                       The latest greedy choices covered the least so they go first.
+     * @return               true if any supply was dropped.
+     */
+    bool dropRedundant();
+
+    /**
+     * @brief exchangeTwoForOne  finds one swap of a supplied location for an unsupplied one that
+     *                           leaves another supply redundant and makes the trade.
+     * @return                   true if the cover shrank by one.
+     */
+    bool exchangeTwoForOne();
+
+    /**
+     * @brief isRedundant  checks if every city of a supplied location is covered by another supply.
+     * @param option       the supplied location.
+     * @return             true if we could remove it without uncovering anything.
+     */
+    bool isRedundant(int option) const;
+
+    /**
+     * @brief chooseOption  supplies a location and counts the cities it covers.
+     * @param option        the location we supply.
+     */
+    void chooseOption(int option);
+
+    /**
+     * @brief unchooseOption  removes the supplies from a location and its cities' counts.
+     * @param option          the location that no longer has supplies.
+     */
+    void unchooseOption(int option);
+
+    ALLOW_TEST_ACCESS();
+};
+
+} // namespace DancingLinks
+
+#endif // DISASTERHEURISTIC_H
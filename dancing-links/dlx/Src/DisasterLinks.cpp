@@ -7,9 +7,11 @@
  * the DancingLinks.h file or the readme. Comments are detailed for my own understanding and because
  * some of the implementation is complicated, especially the building of the dancing links grid.
  */
-#include <cmath>
-#include <limits.h>
+#include <algorithm>
+#include <climits>
+#include <limits>
 #include "DisasterLinks.h"
+#include "ParallelSearch.h"
 
 namespace DancingLinks {
 
@@ -21,54 +23,154 @@ bool hasOverlappingCover(DisasterLinks& links, int numSupplies, std::set<std::st
     return links.isDisasterReady(numSupplies, selectedOptions);
 }
 
+bool hasOverlappingCover(DisasterLinks& links, int numSupplies,
+                           std::set<std::string>& selectedOptions, int numThreads) {
+    return links.isDisasterReady(numSupplies, selectedOptions, numThreads);
+}
+
+SearchStatus hasOverlappingCover(DisasterLinks& links, int numSupplies,
+                                 std::set<std::string>& selectedOptions,
+                                 const SearchLimits& limits) {
+    return links.isDisasterReady(numSupplies, selectedOptions, limits);
+}
+
+SearchStatus hasOverlappingCover(DisasterLinks& links, int numSupplies,
+                                 std::set<std::string>& selectedOptions, int numThreads,
+                                 const SearchLimits& limits) {
+    return links.isDisasterReady(numSupplies, selectedOptions, numThreads, limits);
+}
+
+int getMinimumOverlappingCover(DisasterLinks& links, std::set<std::string>& selectedOptions) {
+    return links.findMinimumSupplies(selectedOptions);
+}
+
+SearchStatus getMinimumOverlappingCover(DisasterLinks& links,
+                                        std::set<std::string>& selectedOptions,
+                                        const SearchLimits& limits) {
+    return links.findMinimumSupplies(selectedOptions, limits);
+}
+
+int getApproximateOverlappingCover(DisasterLinks& links, std::set<std::string>& selectedOptions) {
+    return links.findApproximateSupplies(selectedOptions);
+}
+
 std::set<std::set<std::string>> getAllOverlappingCovers(DisasterLinks& links, int numSupplies) {
     return links.getAllDisasterConfigurations(numSupplies);
 }
 
+std::vector<std::set<std::string>> getUniqueOverlappingCovers(DisasterLinks& links, int numSupplies) {
+    return links.getUniqueDisasterConfigurations(numSupplies);
+}
+
+uint64_t countOverlappingCovers(DisasterLinks& links, int numSupplies) {
+    return links.countDisasterConfigurations(numSupplies);
+}
+
+bool visitOverlappingCovers(DisasterLinks& links, int numSupplies,
+                            const std::function<bool(const std::vector<int>&)>& visit) {
+    return links.visitDisasterConfigurations(numSupplies, visit);
+}
+
 
 /* * * * * * * * * * * * *  Algorithm X via Dancing Links Implementation  * * * * * * * * * * * * */
 
 
 bool DisasterLinks::isDisasterReady(int numSupplies, std::set<std::string>& suppliedCities) {
+    return isDisasterReady(numSupplies, suppliedCities, SearchLimits()) == SearchStatus::FOUND;
+}
+
+bool DisasterLinks::isDisasterReady(int numSupplies,
+                                    std::set<std::string>& suppliedCities,
+                                    int numThreads) {
+    return isDisasterReady(numSupplies, suppliedCities, numThreads, SearchLimits())
+           == SearchStatus::FOUND;
+}
+
+SearchStatus DisasterLinks::isDisasterReady(int numSupplies,
+                                            std::set<std::string>& suppliedCities,
+                                            const SearchLimits& limits) {
     if (numSupplies < 0) {
         error("Negative supply quantity is impossible.");
     }
     if (numItemsAndOptions_ == 0) {
-        return true;
+        return SearchStatus::FOUND;
     }
-    return isCovered(numSupplies, suppliedCities);
+    cuts_ = {0, 0};
+    nogoods_.prepare();
+    budget_ = SearchBudget(limits);
+    std::vector<int> supplies = {};
+    IterativeSearch<DisasterLinks,int> search(numSupplies, SearchMode::DECIDE);
+    if (!search.findCover(*this, supplies, budget_)) {
+        return budget_.isAborted() ? SearchStatus::ABORTED : SearchStatus::INFEASIBLE;
+    }
+    nameSupplies(supplies, suppliedCities);
+    return SearchStatus::FOUND;
 }
 
-bool DisasterLinks::isCovered(int numSupplies, std::set<std::string>& suppliedCities) {
-    if (table_[0].right == 0 && numSupplies >= 0) {
-        return true;
+SearchStatus DisasterLinks::isDisasterReady(int numSupplies,
+                                            std::set<std::string>& suppliedCities,
+                                            int numThreads,
+                                            const SearchLimits& limits) {
+    if (numSupplies < 0) {
+        error("Negative supply quantity is impossible.");
+    }
+    if (numItemsAndOptions_ == 0) {
+        return SearchStatus::FOUND;
     }
-    if (numSupplies <= 0) {
-        return false;
+    ParallelSearch<DisasterLinks,int> search(*this, numThreads);
+    std::set<int> supplies = {};
+    SearchStatus status = search.findCover(numSupplies, supplies, limits);
+    workerNodes_ = search.nodesPerWorker();
+    if (status == SearchStatus::FOUND) {
+        nameSupplies(std::vector<int>(supplies.begin(), supplies.end()), suppliedCities);
     }
+    return status;
+}
 
-    // Choose the city that appears the least across all sets because that will be hard to cover.
-    int chosenIndex = chooseIsolatedCity();
+int DisasterLinks::findMinimumSupplies(std::set<std::string>& suppliedCities) {
+    std::set<std::string> bestCities = {};
+    findMinimumSupplies(bestCities, SearchLimits());
+    suppliedCities.insert(bestCities.begin(), bestCities.end());
+    return bestCities.size();
+}
 
-    /* Try to cover this city by first supplying the most connected city nearby. Try cities with
-     * successively fewer connections then if all else fails supply the isolated city itself.
+SearchStatus DisasterLinks::findMinimumSupplies(std::set<std::string>& suppliedCities,
+                                                const SearchLimits& limits) {
+    if (numItemsAndOptions_ == 0) {
+        return SearchStatus::FOUND;
+    }
+    cuts_ = {0, 0};
+    nogoods_.prepare();
+    budget_ = SearchBudget(limits);
+    /* The heuristic cover is the one to beat so every node only searches for something smaller.
+     * Without one, supplying every city is always a cover.
      */
-    for (int cur = grid_[chosenIndex].down; cur != chosenIndex; cur = grid_[cur].down) {
-
-        std::string supplyLocation = coverCity(cur);
-
-        if (isCovered(numSupplies - 1, suppliedCities)) {
-            // Only add to the output if successful and be sure to cleanup in case it runs again.
-            suppliedCities.insert(supplyLocation);
-            uncoverCity(cur);
-            return true;
-        }
-
-        // This cleanup is in case of failed choices. Try another starting supply location.
-        uncoverCity(cur);
+    int bestCount = incumbent_.empty() ? numItemsAndOptions_ + 1 : incumbent_.size();
+    std::vector<int> bestSupplies = incumbent_;
+    // The supplies we may give out are always one fewer than the best so the bounds prune more.
+    IterativeSearch<DisasterLinks,int> search(bestCount - 1, SearchMode::DECIDE);
+    if (!search.improveCover(*this, bestSupplies, budget_)) {
+        nameSupplies(bestSupplies, suppliedCities);
+        return SearchStatus::ABORTED;
+    }
+    if (bestSupplies.empty()) {
+        // Only a network built by hand can leave a city that no supply location reaches.
+        error("A city can not be covered by any supply location.");
     }
+    nameSupplies(bestSupplies, suppliedCities);
+    return SearchStatus::FOUND;
+}
 
-    return false;
+int DisasterLinks::findApproximateSupplies(std::set<std::string>& suppliedCities) const {
+    if (numItemsAndOptions_ == 0) {
+        return 0;
+    }
+    if (incumbent_.empty()) {
+        // Only a network built by hand can leave a city that no supply location reaches.
+        error("A city can not be covered by any supply location.");
+    }
+    nameSupplies(incumbent_, suppliedCities);
+    return incumbent_.size();
 }
 
 std::set<std::set<std::string>> DisasterLinks::getAllDisasterConfigurations(int numSupplies) {
@@ -76,154 +178,515 @@ std::set<std::set<std::string>> DisasterLinks::getAllDisasterConfigurations(int
         error("Negative supply count.");
     }
 
-    std::set<std::string> suppliedCities {};
     std::set<std::set<std::string>> allConfigurations = {};
-    fillConfigurations(numSupplies, suppliedCities, allConfigurations);
+    // Every path to a cover is walked, so the set filters a configuration reached more than once.
+    IterativeSearch<DisasterLinks,int> search(numSupplies, SearchMode::EVERY_PATH);
+    search.visitCovers(*this, [&](const std::vector<int>& supplies) {
+        std::set<std::string> suppliedCities = {};
+        nameSupplies(supplies, suppliedCities);
+        allConfigurations.insert(suppliedCities);
+        return true;
+    });
     return allConfigurations;
 }
 
-void DisasterLinks::fillConfigurations(int numSupplies,
-                                       std::set<std::string>& suppliedCities,
-                                       std::set<std::set<std::string>>& allConfigurations) {
+DisasterLinks::BoundCuts DisasterLinks::getBoundCuts() const {
+    return cuts_;
+}
 
-    if (table_[0].right == 0 && numSupplies >= 0) {
-        allConfigurations.insert(suppliedCities);
-        return;
+NogoodTable::NogoodStats DisasterLinks::getNogoodStats() const {
+    return nogoods_.getStats();
+}
+
+const SearchStats& DisasterLinks::getSearchStats() const {
+    return stats_;
+}
+
+void DisasterLinks::resetSearchStats() {
+    stats_ = SearchStats();
+}
+
+const std::vector<long long>& DisasterLinks::getWorkerNodes() const {
+    return workerNodes_;
+}
+
+std::vector<std::set<std::string>> DisasterLinks::getUniqueDisasterConfigurations(int numSupplies) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
     }
-    if (numSupplies <= 0) {
-        return;
+
+    std::vector<std::set<std::string>> allConfigurations = {};
+    IterativeSearch<DisasterLinks,int> search(numSupplies, SearchMode::UNIQUE);
+    search.visitCovers(*this, [&](const std::vector<int>& found) {
+        allConfigurations.emplace_back();
+        nameSupplies(found, allConfigurations.back());
+        return true;
+    });
+    return allConfigurations;
+}
+
+uint64_t DisasterLinks::countDisasterConfigurations(int numSupplies) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
     }
-    int chosenIndex = chooseIsolatedCity();
 
-    for (int cur = grid_[chosenIndex].down; cur != chosenIndex; cur = grid_[cur].down) {
+    uint64_t count = 0;
+    IterativeSearch<DisasterLinks,int> search(numSupplies, SearchMode::UNIQUE);
+    search.visitCovers(*this, [&](const std::vector<int>&) {
+        count++;
+        return true;
+    });
+    return count;
+}
+
+bool DisasterLinks::visitDisasterConfigurations(int numSupplies,
+                                                const ConfigurationVisitor& visit) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
+    }
 
-        std::string supplyLocation = coverCity(cur);
-        suppliedCities.insert(supplyLocation);
+    IterativeSearch<DisasterLinks,int> search(numSupplies, SearchMode::UNIQUE);
+    return search.visitCovers(*this, visit);
+}
 
-        fillConfigurations(numSupplies - 1, suppliedCities, allConfigurations);
+const std::string& DisasterLinks::getSupplyName(int option) const {
+    return supplyNames_[option];
+}
+
+void DisasterLinks::setOptionOrder(OptionOrder order) {
+    optionOrder_ = order;
+}
+
+template <typename Item>
+bool DisasterLinks::isBeyondBounds(const std::vector<Item>& grid, int numSupplies) {
+    // Even if every supply covered as many cities as the largest option we would fall short.
+    if (numUncovered_ > numSupplies * maxLive_) {
+        cuts_.optionSize++;
+        return true;
+    }
+    // Cities that share no option must each be covered by a different supply.
+    if (packCities(grid, numSupplies) > numSupplies) {
+        cuts_.packing++;
+        return true;
+    }
+    return false;
+}
+
+template <typename Item>
+int DisasterLinks::packCities(const std::vector<Item>& grid, int limit) {
+    if (++stamp_ == INT_MAX) {
+        std::fill(packingStamp_.begin(), packingStamp_.end(), 0);
+        stamp_ = 1;
+    }
+    int packed = 0;
+    for (int city = table_[0].right; city != 0; city = table_[city].right) {
+        bool isDisjoint = true;
+        for (int i = grid[city].down; i != city && isDisjoint; i = grid[i].down) {
+            isDisjoint = packingStamp_[optionOf_[i]] != stamp_;
+        }
+        if (isDisjoint) {
+            for (int i = grid[city].down; i != city; i = grid[i].down) {
+                packingStamp_[optionOf_[i]] = stamp_;
+            }
+            if (++packed > limit) {
+                return packed;
+            }
+        }
+    }
+    return packed;
+}
+
+template <typename Item>
+void DisasterLinks::rankOptions(const std::vector<Item>& grid,
+                                int header,
+                                std::vector<int>& ranked) {
+    int first = ranked.size();
+    for (int i = grid[header].down; i != header; i = grid[i].down) {
+        int k = ranked.size();
+        ranked.push_back(i);
+        if (optionOrder_ == OptionOrder::MOST_UNCOVERED) {
+            // Columns are short so an insertion sort that stops at equal options is enough.
+            int live = liveCities_[optionOf_[i]];
+            for (; k > first && liveCities_[optionOf_[ranked[k - 1]]] < live; k--) {
+                ranked[k] = ranked[k - 1];
+            }
+            ranked[k] = i;
+        }
+    }
+}
+
+void DisasterLinks::loseLiveCity(int option) {
+    optionsWithLive_[liveCities_[option]]--;
+    optionsWithLive_[--liveCities_[option]]++;
+    // The largest option can only shrink by one city at a time so one step down is enough.
+    if (!optionsWithLive_[maxLive_]) {
+        maxLive_--;
+    }
+}
+
+void DisasterLinks::regainLiveCity(int option) {
+    optionsWithLive_[liveCities_[option]]--;
+    optionsWithLive_[++liveCities_[option]]++;
+    maxLive_ = std::max(maxLive_, liveCities_[option]);
+}
 
-        suppliedCities.erase(supplyLocation);
-        // This cleanup is in case of failed choices. Try another starting supply location.
-        uncoverCity(cur);
+void DisasterLinks::nameSupplies(const std::vector<int>& supplies,
+                                 std::set<std::string>& suppliedCities) const {
+    for (int option : supplies) {
+        suppliedCities.insert(supplyNames_[option]);
     }
 }
 
 int DisasterLinks::chooseIsolatedCity() const {
-    int min = INT_MAX;
-    int chosenIndex = 0;
-    int head = 0;
-    for (int cur = table_[0].right; cur != head; cur = table_[cur].right) {
-        if (grid_[cur].topOrLen < min) {
-            chosenIndex = cur;
-            min = grid_[cur].topOrLen;
+    // Buckets keep the order of the table so ties go to the first city as they always have.
+    for (int head = numItemsAndOptions_ + 1; head < (int)lengthLinks_.size(); head++) {
+        DLX_STATS(stats_.mems++);
+        if (lengthLinks_[head].right != head) {
+            return lengthLinks_[head].right;
         }
     }
-    return chosenIndex;
+    return 0;
+}
+
+void DisasterLinks::leaveLengthBucket(int city) {
+    cityHeader links = lengthLinks_[city];
+    lengthLinks_[links.left].right = links.right;
+    lengthLinks_[links.right].left = links.left;
 }
 
-std::string DisasterLinks::coverCity(int indexInOption) {
+void DisasterLinks::returnToLengthBucket(int city) {
+    cityHeader links = lengthLinks_[city];
+    lengthLinks_[links.left].right = city;
+    lengthLinks_[links.right].left = city;
+}
+
+void DisasterLinks::shortenColumn(int city, int length) {
+    movedFrom_.push_back(lengthLinks_[city]);
+    leaveLengthBucket(city);
+    // Buckets stay in the order of the table so the city we choose never depends on the moves.
+    int head = numItemsAndOptions_ + 1 + length;
+    int next = lengthLinks_[head].right;
+    while (next != head && next < city) {
+        next = lengthLinks_[next].right;
+    }
+    lengthLinks_[city] = {lengthLinks_[next].left, next};
+    lengthLinks_[lengthLinks_[next].left].right = city;
+    lengthLinks_[next].left = city;
+}
+
+void DisasterLinks::lengthenColumn(int city) {
+    leaveLengthBucket(city);
+    // Every move since this city left its bucket has been undone so its old neighbors are linked.
+    lengthLinks_[city] = movedFrom_.back();
+    movedFrom_.pop_back();
+    returnToLengthBucket(city);
+}
+
+template <typename Item>
+int DisasterLinks::coverCity(std::vector<Item>& grid, int indexInOption) {
     /* Be sure to leave the row of the option we supply unchanged. Splice these cities out of all
      * other options in which they can be found above and below the current row.
      */
     int i = indexInOption;
-    std::string result = "";
+    int result = 0;
     do {
-        int top = grid_[i].topOrLen;
+        int top = grid[i].topOrLen;
+        DLX_STATS(stats_.mems++);
         if (top <= 0) {
-            /* We are always guaranteed to pass the spacer tile so we will collect the name of the
-             * city we have chosen to supply to prove our algorithm chose correctly.
+            /* We are always guaranteed to pass the spacer tile so we will collect the option id of
+             * the city we have chosen to supply. Its name is only needed for the output.
             */
-            result = table_[std::abs(top)].name;
+            result = -top - 1;
         } else {
-            hideCityCol(i);
+            DLX_STATS(stats_.mems += 6; stats_.updates++);
+            hideCityCol(grid, i);
+            loseLiveCity(optionOf_[i]);
             table_[table_[top].left].right = table_[top].right;
             table_[table_[top].right].left = table_[top].left;
+            leaveLengthBucket(top);
+            uncoveredKey_ ^= cityKeys_[top];
+            numUncovered_--;
         }
-        i = grid_[i].right;
+        i = grid[i].right;
     } while (i != indexInOption);
 
     return result;
 }
 
-void DisasterLinks::uncoverCity(int indexInOption) {
+template <typename Item>
+void DisasterLinks::uncoverCity(std::vector<Item>& grid, int indexInOption) {
     /* To uncover a city we take the supplies away from the option in which we found this city. We
      * then must go up and down for every city covered by this supply location and put the cities
      * back in all the other sets. Original row was not altered so no other restoration necessary.
      */
-    indexInOption = grid_[indexInOption].left;
+    indexInOption = grid[indexInOption].left;
     int i = indexInOption;
     do {
-        int top = grid_[i].topOrLen;
+        int top = grid[i].topOrLen;
+        DLX_STATS(stats_.mems++);
         if (top > 0) {
+            DLX_STATS(stats_.mems += 6);
+            numUncovered_++;
             table_[table_[top].left].right = top;
             table_[table_[top].right].left = top;
-            unhideCityCol(i);
+            returnToLengthBucket(top);
+            uncoveredKey_ ^= cityKeys_[top];
+            regainLiveCity(optionOf_[i]);
+            unhideCityCol(grid, i);
         }
-        i = grid_[i].left;
+        i = grid[i].left;
     } while (i != indexInOption);
 }
 
-void DisasterLinks::hideCityCol(int indexInCol) {
-    for (int i = grid_[indexInCol].down; i != indexInCol; i = grid_[i].down) {
-        cityItem cur = grid_[i];
-        grid_[cur.right].left = cur.left;
-        grid_[cur.left].right = cur.right;
+template <typename Item>
+void DisasterLinks::hideCityCol(std::vector<Item>& grid, int indexInCol) {
+    for (int i = grid[indexInCol].down; i != indexInCol; i = grid[i].down) {
+        Item cur = grid[i];
+        grid[cur.right].left = cur.left;
+        grid[cur.left].right = cur.right;
+        DLX_STATS(stats_.mems += 3; stats_.updates++);
+        // The column header belongs to no option so it has no live cities to lose.
+        if (i > numItemsAndOptions_) {
+            loseLiveCity(optionOf_[i]);
+        }
+    }
+}
+
+template <typename Item>
+void DisasterLinks::unhideCityCol(std::vector<Item>& grid, int indexInCol) {
+    for (int i = grid[indexInCol].up; i != indexInCol; i = grid[i].up) {
+        Item cur = grid[i];
+        DLX_STATS(stats_.mems += 3);
+        if (i > numItemsAndOptions_) {
+            regainLiveCity(optionOf_[i]);
+        }
+        grid[cur.right].left = i;
+        grid[cur.left].right = i;
     }
 }
 
-void DisasterLinks::unhideCityCol(int indexInCol) {
-    for (int i = grid_[indexInCol].up; i != indexInCol; i = grid_[i].up) {
-        cityItem cur = grid_[i];
-        grid_[cur.right].left = i;
-        grid_[cur.left].right = i;
+template <typename Item>
+void DisasterLinks::forbidOption(std::vector<Item>& grid, int indexInOption) {
+    for (int i = grid[indexInOption].right; i != indexInOption; i = grid[i].right) {
+        int top = grid[i].topOrLen;
+        DLX_STATS(stats_.mems++);
+        if (top > 0) {
+            Item cur = grid[i];
+            grid[cur.up].down = cur.down;
+            grid[cur.down].up = cur.up;
+            grid[top].topOrLen--;
+            shortenColumn(top, grid[top].topOrLen);
+            DLX_STATS(stats_.mems += 9; stats_.updates++);
+        }
     }
 }
 
+template <typename Item>
+void DisasterLinks::permitOption(std::vector<Item>& grid, int indexInOption) {
+    for (int i = grid[indexInOption].left; i != indexInOption; i = grid[i].left) {
+        int top = grid[i].topOrLen;
+        DLX_STATS(stats_.mems++);
+        if (top > 0) {
+            Item cur = grid[i];
+            grid[cur.up].down = i;
+            grid[cur.down].up = i;
+            grid[top].topOrLen++;
+            lengthenColumn(top);
+            DLX_STATS(stats_.mems += 9);
+        }
+    }
+}
+
+
+/* * * * * * * * * * * * *     Hooks for the Parallel Search Driver      * * * * * * * * * * * * */
+
+
+template <typename Item>
+DisasterLinks::GridHooks<Item>::GridHooks(DisasterLinks& links, std::vector<Item>& grid)
+    : links_(links),
+      grid_(grid) {}
+
+template <typename Item>
+bool DisasterLinks::GridHooks<Item>::isSolved() const {
+    return links_.table_[0].right == 0;
+}
+
+template <typename Item>
+int DisasterLinks::GridHooks<Item>::chooseItem() const {
+    return links_.chooseIsolatedCity();
+}
+
+template <typename Item>
+int DisasterLinks::GridHooks<Item>::nextOption(int indexInOption) const {
+    return grid_[indexInOption].down;
+}
+
+template <typename Item>
+int DisasterLinks::GridHooks<Item>::coverOption(int indexInOption, int depthTag) {
+    // Supplies are not tagged in this implementation so the depth does not matter.
+    (void)depthTag;
+    return links_.coverCity(grid_, indexInOption);
+}
+
+template <typename Item>
+void DisasterLinks::GridHooks<Item>::uncoverOption(int indexInOption) {
+    links_.uncoverCity(grid_, indexInOption);
+}
+
+template <typename Item>
+bool DisasterLinks::GridHooks<Item>::isPruned(int depthTag) {
+    // A set of cities we failed to cover before is skipped without touching the grid.
+    return links_.nogoods_.isInfeasible(links_.uncoveredKey_, depthTag)
+           || links_.isBeyondBounds(grid_, depthTag);
+}
+
+template <typename Item>
+int DisasterLinks::GridHooks<Item>::chooseOptions(std::vector<int>& options) {
+    // Choose the city that appears the least across all sets because that will be hard to cover.
+    int chosenIndex = links_.chooseIsolatedCity();
+
+    /* Try to cover this city by first supplying the most connected city nearby. Try cities with
+     * successively fewer connections then if all else fails supply the isolated city itself.
+     */
+    links_.rankOptions(grid_, chosenIndex, options);
+    return chosenIndex;
+}
+
+template <typename Item>
+void DisasterLinks::GridHooks<Item>::recordNogood(int depthTag) {
+    links_.nogoods_.recordInfeasible(links_.uncoveredKey_, depthTag);
+}
+
+template <typename Item>
+SearchStats& DisasterLinks::GridHooks<Item>::stats() const {
+    return links_.stats_;
+}
+
+template <typename Item>
+void DisasterLinks::GridHooks<Item>::retireOption(int indexInOption) {
+    links_.forbidOption(grid_, indexInOption);
+}
+
+template <typename Item>
+void DisasterLinks::GridHooks<Item>::restoreOption(int indexInOption) {
+    links_.permitOption(grid_, indexInOption);
+}
+
+// The stack is compiled in other files so both widths of the hooks are compiled here.
+template class DisasterLinks::GridHooks<DisasterLinks::cityItem>;
+template class DisasterLinks::GridHooks<DisasterLinks::compactCityItem>;
+
 
 /* * * * * * * * * * *  Constructor and Building of Dancing Links Network   * * * * * * * * * * * */
 
 
 DisasterLinks::DisasterLinks(const std::map<std::string, std::set<std::string>>& roadNetwork)
+    : DisasterLinks(NetworkGraph(roadNetwork)) {}
+
+DisasterLinks::DisasterLinks(const NetworkGraph& roadNetwork)
+    : DisasterLinks(CoverNetwork(roadNetwork)) {}
+
+DisasterLinks::DisasterLinks(const CoverNetwork& roadNetwork)
     : table_(),
+      cityNames_(),
       grid_(),
-      numItemsAndOptions_(0) {
+      compactGrid_(),
+      supplyNames_(),
+      numItemsAndOptions_(0),
+      optionOf_(),
+      liveCities_(),
+      optionsWithLive_(),
+      maxLive_(0),
+      numUncovered_(0),
+      packingStamp_(),
+      stamp_(0),
+      lengthLinks_(),
+      movedFrom_(),
+      optionOrder_(OptionOrder::MOST_CONNECTED),
+      cuts_({0, 0}),
+      cityKeys_(),
+      uncoveredKey_(0),
+      nogoods_(),
+      budget_(),
+      incumbent_(),
+      stats_(),
+      workerNodes_() {
+
+    // Headers, then a spacer for each option, the cities each option covers, and a last spacer.
+    int numNodes = roadNetwork.numItems() + roadNetwork.numOptions() + roadNetwork.numEntries() + 2;
+    // Indices count up from zero so the grid fits in 16 bits if its last index does.
+    if (numNodes <= std::numeric_limits<int16_t>::max()) {
+        buildGrid(roadNetwork, compactGrid_);
+    } else {
+        buildGrid(roadNetwork, grid_);
+    }
 
+    DisasterHeuristic heuristic(roadNetwork);
+    if (heuristic.isComplete()) {
+        incumbent_ = heuristic.getCover();
+    }
+}
+
+template <typename Item>
+void DisasterLinks::buildGrid(const CoverNetwork& roadNetwork, std::vector<Item>& grid) {
     // We will set this up for a reverse build of column links for a given item.
-    std::unordered_map<std::string,int> columnBuilder = {};
-    std::vector<std::pair<std::string,int>> connectionSizes = {};
+    std::vector<int> columnBuilder = {};
+    std::vector<std::pair<int,int>> connectionSizes = {};
 
     // We need to start preparing items in the grid immediately after the headers.
-    initializeHeaders(roadNetwork, connectionSizes, columnBuilder);
+    initializeHeaders(roadNetwork, grid, connectionSizes, columnBuilder);
 
     /* The second pass will fill in the columns and keep the headers and all elements appropriately
      * updated. We can hang on to helpful index info.
      */
-    initializeItems(roadNetwork, connectionSizes, columnBuilder);
+    initializeItems(roadNetwork, grid, connectionSizes, columnBuilder);
+
+    initializeBounds(grid);
+
+    initializeLengthBuckets(grid);
 }
 
-void DisasterLinks::initializeHeaders(const std::map<std::string, std::set<std::string>>& roadNetwork,
-                                      std::vector<std::pair<std::string,int>>& connectionSizes,
-                                      std::unordered_map<std::string,int>& columnBuilder) {
-    table_.push_back({"", 0, 1});
-    grid_.push_back({0,0,0,0,1});
+template <typename Item>
+void DisasterLinks::initializeHeaders(const CoverNetwork& roadNetwork,
+                                      std::vector<Item>& grid,
+                                      std::vector<std::pair<int,int>>& connectionSizes,
+                                      std::vector<int>& columnBuilder) {
+    int numCities = roadNetwork.numItems();
+    int numOptions = roadNetwork.numOptions();
+    // Headers, then a spacer for each option, the cities each option covers, and a last spacer.
+    table_.reserve(numCities + 1);
+    cityNames_.reserve(numCities + 1);
+    grid.reserve(numCities + numOptions + roadNetwork.numEntries() + 2);
+    connectionSizes.reserve(numOptions);
+    columnBuilder.reserve(numCities);
+    supplyNames_.reserve(numOptions);
+
+    table_.push_back({0, 1});
+    cityNames_.push_back("");
+    grid.push_back(makeItem<Item>(0, 0, 0, 0, 1));
     int index = 1;
     // The first pass will set up the name headers and the column headers in the two vectors.
-    for (const auto& city : roadNetwork) {
-
-        // Add one to the connection size because we will add a city to its own connections later.
-        connectionSizes.push_back({city.first, roadNetwork.at(city.first).size() + 1});
+    for (int city = 0; city < numCities; city++) {
 
         // We need to set up multiple columns, so begin tracking the previous item for a column.
-        columnBuilder[city.first] = index;
+        columnBuilder.push_back(index);
 
-        table_.push_back({city.first, index - 1, index + 1});
+        table_.push_back({index - 1, index + 1});
+        cityNames_.push_back(roadNetwork.itemName(city));
         table_[0].left++;
-        grid_[0].left++;
+        grid[0].left++;
         // Add the first headers for the item vector. They need count up and down.
-        grid_.push_back({0, index, index, index - 1, index + 1});
+        grid.push_back(makeItem<Item>(0, index, index, index - 1, index + 1));
         numItemsAndOptions_++;
         index++;
     }
+    for (int option = 0; option < numOptions; option++) {
+        supplyNames_.push_back(roadNetwork.optionName(option));
+        // An option that covers nothing can never help so it does not need a row.
+        if (roadNetwork.optionSize(option)) {
+            connectionSizes.push_back({option, roadNetwork.optionSize(option)});
+        }
+    }
 
     /* We want the most isolated cities to try to cover themselves by supplying adjacent neighbor
      * with the most other connections. This is not garunteed to work every time, but most times
@@ -235,78 +698,162 @@ void DisasterLinks::initializeHeaders(const std::map<std::string, std::set<std::
     });
 
     table_[table_.size() - 1].right = 0;
-    grid_[grid_.size() - 1].right = 0;
+    grid[grid.size() - 1].right = 0;
 }
 
-void DisasterLinks::initializeItems(const std::map<std::string, std::set<std::string>>& roadNetwork,
-                                    const std::vector<std::pair<std::string,int>>& connectionSizes,
-                                    std::unordered_map<std::string,int>& columnBuilder) {
-    int previousSetSize = grid_.size();
-    int index = grid_.size();
-
-    for (const auto& [city, connectionSize] : connectionSizes) {
-        // This algorithm includes a city in its own set of connections.
-        std::set<std::string> connections = roadNetwork.at(city);
-        connections.insert(city);
-        int setSize = connections.size();
-
-        /* We will know which supplying city option an item is in by the spacerTitle.
-         * lookupTable[abs(-grid_[columnBuilder[city]].down)] will give us the name of the option
-         * of that row. This accesses the last city in a column's down field to get the header.
+template <typename Item>
+void DisasterLinks::initializeItems(const CoverNetwork& roadNetwork,
+                                    std::vector<Item>& grid,
+                                    const std::vector<std::pair<int,int>>& connectionSizes,
+                                    std::vector<int>& columnBuilder) {
+    int previousSetSize = grid.size();
+    int index = grid.size();
+
+    for (const auto& [option, setSize] : connectionSizes) {
+        /* We will know which supplying city option an item is in by the spacerTitle. The option
+         * id is shifted by one so that every spacer is negative, even the spacer of option zero.
+         * In a network built from a graph this is the negative header index of the city supplied.
          */
-        grid_.push_back({-grid_[columnBuilder[city]].down,  // Negative index of city as option.
-                         index - previousSetSize,           // First item in previous option
-                         index + setSize,                   // Last item in current option
-                         index,
-                         index + 1});
+        grid.push_back(makeItem<Item>(-(option + 1),           // Negative option id plus one.
+                                      index - previousSetSize, // First item in previous option
+                                      index + setSize,         // Last item in current option
+                                      index,
+                                      index + 1));
 
         // Manage column pointers for items connected across options. Update index.
-        index = initializeColumns(connections, columnBuilder, index);
+        index = initializeColumns(roadNetwork, grid, option, columnBuilder, index);
 
         previousSetSize = setSize;
     }
-    grid_.push_back({INT_MIN, index - previousSetSize, 0, index - 1, INT_MIN});
+    // The end marker is the smallest index of either width so it never looks like an option.
+    int endMarker = std::numeric_limits<decltype(Item::topOrLen)>::min();
+    grid.push_back(makeItem<Item>(endMarker, index - previousSetSize, 0, index - 1, endMarker));
 }
 
-int DisasterLinks::initializeColumns(const std::set<std::string>& connections,
-                                     std::unordered_map<std::string,int>& columnBuilder,
+template <typename Item>
+int DisasterLinks::initializeColumns(const CoverNetwork& roadNetwork,
+                                     std::vector<Item>& grid,
+                                     int option,
+                                     std::vector<int>& columnBuilder,
                                      int index) {
     int spacerIndex = index;
-    for (const auto& c : connections) {
-        // Circular lists give us access to header with down field of last city in a column.
-        grid_[grid_[columnBuilder[c]].down].topOrLen++;
-        index++;
-
-        // A single item in a circular doubly linked list points to itself.
-        grid_.push_back({grid_[columnBuilder[c]].down, index, index, index - 1, index + 1});
-
-        /* Now we need to handle building the up and down pointers for a column of items.
-         * We also must make sure to keep the most recent element pointing down to the
-         * first of a column because this is circular. The first elem in the column must
-         * also point up to the most recently added element because this is circular.
-         */
-
-        // This is the necessary adjustment to the column header's up field for a given item.
-        grid_[grid_[columnBuilder[c]].down].up = index;
-
-        // The current node is now the new tail in a vertical circular linked list for an item.
-        grid_[index].up = columnBuilder[c];
-        grid_[index].down = grid_[columnBuilder[c]].down;
-
-        // Update the old tail to reflect the new addition of an item in its option.
-        grid_[columnBuilder[c]].down = index;
-
-        // Similar to a previous/current coding pattern but in an above/below column.
-        columnBuilder[c] = index;
+    // The cities of an option arrive sorted by id so the row stays in order of city id.
+    int end = roadNetwork.optionEnd(option);
+    for (int entry = roadNetwork.optionBegin(option); entry < end; entry++) {
+        appendToColumn(grid, roadNetwork.item(entry), columnBuilder, ++index);
     }
     /* Every option "row" is a left-right circular linked list. This is how we recursively cover
      * Cities by removing them as items only. A city that is adjacent to a supplied city may still
      * receive supplies to cover other cities as an option. This is how we achieve that. This is
      * a significant variation from Knuth's DLX.
      */
-    grid_[index].right = spacerIndex;
-    grid_[spacerIndex].left = index;
+    grid[index].right = spacerIndex;
+    grid[spacerIndex].left = index;
     return ++index;
 }
 
+template <typename Item>
+void DisasterLinks::appendToColumn(std::vector<Item>& grid,
+                                   int city,
+                                   std::vector<int>& columnBuilder,
+                                   int index) {
+    // Circular lists give us access to header with down field of last city in a column.
+    grid[grid[columnBuilder[city]].down].topOrLen++;
+
+    // A single item in a circular doubly linked list points to itself.
+    int top = grid[columnBuilder[city]].down;
+    grid.push_back(makeItem<Item>(top, index, index, index - 1, index + 1));
+
+    /* Now we need to handle building the up and down pointers for a column of items.
+     * We also must make sure to keep the most recent element pointing down to the
+     * first of a column because this is circular. The first elem in the column must
+     * also point up to the most recently added element because this is circular.
+     */
+
+    // This is the necessary adjustment to the column header's up field for a given item.
+    grid[grid[columnBuilder[city]].down].up = index;
+
+    // The current node is now the new tail in a vertical circular linked list for an item.
+    grid[index].up = columnBuilder[city];
+    grid[index].down = grid[columnBuilder[city]].down;
+
+    // Update the old tail to reflect the new addition of an item in its option.
+    grid[columnBuilder[city]].down = index;
+
+    // Similar to a previous/current coding pattern but in an above/below column.
+    columnBuilder[city] = index;
+}
+
+template <typename Item>
+void DisasterLinks::initializeBounds(const std::vector<Item>& grid) {
+    optionOf_.assign(grid.size(), -1);
+    // Options begin right after the headers and the final spacer belongs to no option.
+    int option = -1;
+    for (int i = numItemsAndOptions_ + 1; i < (int)grid.size() - 1; i++) {
+        if (grid[i].topOrLen <= 0) {
+            option++;
+            liveCities_.push_back(0);
+        } else {
+            liveCities_[option]++;
+        }
+        optionOf_[i] = option;
+    }
+    maxLive_ = 0;
+    for (int live : liveCities_) {
+        maxLive_ = std::max(maxLive_, live);
+    }
+    optionsWithLive_.assign(maxLive_ + 1, 0);
+    for (int live : liveCities_) {
+        optionsWithLive_[live]++;
+    }
+    numUncovered_ = numItemsAndOptions_;
+    // Every city starts uncovered so the hash of the whole network includes every key.
+    cityKeys_.assign(numItemsAndOptions_ + 1, 0);
+    for (int city = 1; city <= numItemsAndOptions_; city++) {
+        cityKeys_[city] = NogoodTable::itemKey(city);
+        uncoveredKey_ ^= cityKeys_[city];
+    }
+    packingStamp_.assign(liveCities_.size(), 0);
+}
+
+template <typename Item>
+void DisasterLinks::initializeLengthBuckets(const std::vector<Item>& grid) {
+    int maxLength = 0;
+    for (int city = 1; city <= numItemsAndOptions_; city++) {
+        maxLength = std::max(maxLength, (int)grid[city].topOrLen);
+    }
+    // Every bucket head starts alone and cities join at the back of their bucket.
+    lengthLinks_.resize(numItemsAndOptions_ + maxLength + 2);
+    for (int head = numItemsAndOptions_ + 1; head < (int)lengthLinks_.size(); head++) {
+        lengthLinks_[head] = {head, head};
+    }
+    for (int city = 1; city <= numItemsAndOptions_; city++) {
+        int head = numItemsAndOptions_ + 1 + grid[city].topOrLen;
+        lengthLinks_[city] = {lengthLinks_[head].left, head};
+        lengthLinks_[lengthLinks_[head].left].right = city;
+        lengthLinks_[head].left = city;
+    }
+}
+
+template <typename Item>
+Item DisasterLinks::makeItem(int topOrLen, int up, int down, int left, int right) {
+    using Index = decltype(Item::topOrLen);
+    return {(Index)topOrLen, (Index)up, (Index)down, (Index)left, (Index)right};
+}
+
+std::vector<DisasterLinks::cityItem> DisasterLinks::getGrid() const {
+    if (compactGrid_.empty()) {
+        return grid_;
+    }
+    std::vector<cityItem> grid = {};
+    grid.reserve(compactGrid_.size());
+    for (const compactCityItem& item : compactGrid_) {
+        grid.push_back({item.topOrLen, item.up, item.down, item.left, item.right});
+    }
+    // Only the end marker of the last spacer changes value when it is widened.
+    grid.back().topOrLen = INT_MIN;
+    grid.back().right = INT_MIN;
+    return grid;
+}
+
 } // namespace DancingLinks
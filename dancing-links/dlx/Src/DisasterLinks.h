@@ -11,9 +11,16 @@
 #define DISASTERLINKS_H
 #include <vector>
 #include "GUI/SimpleTest.h"
+#include "DisasterHeuristic.h"
+#include "NetworkGraph.h"
+#include "NogoodTable.h"
+#include "SearchLimits.h"
+#include "SearchStats.h"
+#include <cstdint>
+#include <functional>
 #include <map>
-#include <unordered_map>
 #include <set>
+#include <utility>
 
 namespace DancingLinks {
 
@@ -31,7 +38,24 @@ public:
     explicit DisasterLinks(const std::map<std::string, std::set<std::string>>& roadNetwork);
 
     /**
-     * @brief isDisasterReady  performs a recursive search to determine if a transportation grid
+     * @brief DisasterLinks  builds the grid by walking the arrays of a compact graph. Only the
+     *                       lookup table touches city names so no string is hashed or copied.
+     *                       The map constructor above simply builds this graph first.
+     * @param roadNetwork    the transportation grid as a graph of city ids.
+     */
+    explicit DisasterLinks(const NetworkGraph& roadNetwork);
+
+    /**
+     * @brief DisasterLinks  builds the grid from the cities that must be covered and the supply
+     *                       options that cover them. A graph is turned into one of these networks
+     *                       before building, but a reduced network may have fewer options than
+     *                       cities. Supplied options are reported by their option names.
+     * @param roadNetwork    the cities to cover and the cities each supply location covers.
+     */
+    explicit DisasterLinks(const CoverNetwork& roadNetwork);
+
+    /**
+     * @brief isDisasterReady  performs a depth first search to determine if a transportation grid
      *                         can be covered with the specified number of emergency supplies. It
      *                         will also place the found cities in the output parameter if there
      *                         exists a solution. A city is covered or safe if it has supplies or
@@ -43,6 +67,46 @@ public:
      */
     bool isDisasterReady(int numSupplies, std::set<std::string>& suppliedCities);
 
+    /**
+     * @brief isDisasterReady  performs the same search as above but shares the search tree among
+     *                         multiple threads. Each thread searches its own copy of the network,
+     *                         idle threads steal untried options from busy ones, and all threads
+     *                         stop once any of them finds a viable supply scheme. The cities found
+     *                         may differ from the serial search but will always cover the network.
+     * @param numSupplies      the limiting number of supplies we must distribute.
+     * @param suppliedCities   the output parameter telling which cities received supplies.
+     * @param numThreads       the number of threads to use. Zero or less uses all hardware threads.
+     * @return                 true if we have found a viable supply scheme, false if not.
+     */
+    bool isDisasterReady(int numSupplies, std::set<std::string>& suppliedCities, int numThreads);
+
+    /**
+     * @brief isDisasterReady  performs the same search as above but gives up once any limit is
+     *                         reached. An aborted search unwinds every choice it made and tells us
+     *                         nothing about whether the network can be covered.
+     * @param numSupplies      the limiting number of supplies we must distribute.
+     * @param suppliedCities   the output parameter telling which cities received supplies.
+     * @param limits           the node, time, and cancellation limits for the search.
+     * @return                 FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+     */
+    SearchStatus isDisasterReady(int numSupplies,
+                                 std::set<std::string>& suppliedCities,
+                                 const SearchLimits& limits);
+
+    /**
+     * @brief isDisasterReady  performs the threaded search within the given limits. The node limit
+     *                         counts the nodes of every thread together.
+     * @param numSupplies      the limiting number of supplies we must distribute.
+     * @param suppliedCities   the output parameter telling which cities received supplies.
+     * @param numThreads       the number of threads to use. Zero or less uses all hardware threads.
+     * @param limits           the node, time, and cancellation limits for the search.
+     * @return                 FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+     */
+    SearchStatus isDisasterReady(int numSupplies,
+                                 std::set<std::string>& suppliedCities,
+                                 int numThreads,
+                                 const SearchLimits& limits);
+
     /**
      * @brief getAllDisasterConfigurations  returns every possible disaster configuration possible
      *                                      with a given supply count. I advise finding the optimal
@@ -53,32 +117,173 @@ public:
      */
     std::set<std::set<std::string>> getAllDisasterConfigurations(int numSupplies);
 
+    /**
+     * @brief findMinimumSupplies  finds the fewest supplies that can cover the transportation grid
+     *                             in a single branch and bound search. Every time we cover the
+     *                             grid we tighten the supply limit to one less than that cover, so
+     *                             we never repeat the failed searches of trying one limit at a time.
+     * @param suppliedCities       the output parameter holding the cities of an optimal cover.
+     * @return                     the minimum number of supplies needed to cover every city.
+     */
+    int findMinimumSupplies(std::set<std::string>& suppliedCities);
+
+    /**
+     * @brief findMinimumSupplies  performs the same search as above but gives up once any limit is
+     *                             reached. An aborted search still reports the smallest cover it
+     *                             found, which is never worse than the heuristic cover.
+     * @param suppliedCities       the output parameter holding the cities of the best cover found.
+     * @param limits               the node, time, and cancellation limits for the search.
+     * @return                     FOUND if the cover is proven optimal or ABORTED by a limit.
+     */
+    SearchStatus findMinimumSupplies(std::set<std::string>& suppliedCities,
+                                     const SearchLimits& limits);
+
+    /**
+     * @brief findApproximateSupplies  reports the cover the greedy and local search heuristic
+     *                                 found when the network was built. It needs no search at all
+     *                                 and is the cover findMinimumSupplies starts out trying to
+     *                                 beat, so it is often optimal but is never guaranteed to be.
+     * @param suppliedCities           the output parameter holding the cities of the cover.
+     * @return                         the number of supplies in the heuristic cover.
+     */
+    int findApproximateSupplies(std::set<std::string>& suppliedCities) const;
+
+    /**
+     * @brief getUniqueDisasterConfigurations  returns every disaster configuration possible with a
+     *                                         given supply count, generating each one exactly once.
+     *                                         Once we have tried every configuration that supplies
+     *                                         an option we forbid that option for its siblings, so
+     *                                         no set needs to filter out duplicates. At the optimal
+     *                                         supply count this finds exactly the configurations of
+     *                                         getAllDisasterConfigurations. With extra supplies both
+     *                                         find every configuration that wastes no supply but
+     *                                         may differ in which wasteful ones they include.
+     * @param numSupplies                      the number of supplies we have to distribute.
+     * @return                                 all possible distributions of the supplies.
+     */
+    std::vector<std::set<std::string>> getUniqueDisasterConfigurations(int numSupplies);
+
+    /**
+     * @brief countDisasterConfigurations  counts the configurations getUniqueDisasterConfigurations
+     *                                     would return with the same search, but only increments a
+     *                                     counter at every cover. No configuration is ever built so
+     *                                     we can count far more of them than would fit in memory.
+     * @param numSupplies                  the number of supplies we have to distribute.
+     * @return                             the number of distinct distributions of the supplies.
+     */
+    uint64_t countDisasterConfigurations(int numSupplies);
+
+    /* A visitor sees every configuration the moment it is found as the option ids on the stack of
+     * supplies, valid only for the duration of the call. It returns true to keep searching.
+     */
+    using ConfigurationVisitor = std::function<bool(const std::vector<int>& supplies)>;
+
+    /**
+     * @brief visitDisasterConfigurations  runs the search of getUniqueDisasterConfigurations but
+     *                                     hands each configuration to a visitor instead of keeping
+     *                                     it. The visitor may stream, filter, or stop the search.
+     * @param numSupplies                  the number of supplies we have to distribute.
+     * @param visit                        the visitor called with the option ids of every cover.
+     * @return                             true if every configuration was visited, false if the
+     *                                     visitor stopped the search early.
+     */
+    bool visitDisasterConfigurations(int numSupplies, const ConfigurationVisitor& visit);
+
+    /**
+     * @brief getSupplyName  names the city holding an option id given to a visitor.
+     * @param option         the option id of a supplied city.
+     * @return               the name of the city receiving supplies.
+     */
+    const std::string& getSupplyName(int option) const;
+
+    /* The decision and minimum searches try the options covering a city in one of two orders. By
+     * default options that covered the most cities when the network was built come first. Deep in
+     * the search many of those cities are covered, so we may instead rank the options at every
+     * node by the uncovered cities each would cover now. Enumeration must try every option anyway
+     * so it always uses the order of the columns.
+     */
+    enum class OptionOrder {
+        MOST_CONNECTED,
+        MOST_UNCOVERED
+    };
+
+    /**
+     * @brief setOptionOrder  chooses the order in which later searches try the options of a city.
+     * @param order           MOST_CONNECTED to follow the columns or MOST_UNCOVERED to rank them.
+     */
+    void setOptionOrder(OptionOrder order);
+
+    /* Every node of the search checks two lower bounds on the supplies we still need. These are
+     * the number of nodes each bound cut from the tree during the last serial decision or minimum
+     * search. The threaded searches count in the copies their workers own and never report them.
+     */
+    struct BoundCuts {
+        long long optionSize;
+        long long packing;
+    };
+
+    /**
+     * @brief getBoundCuts  reports how many nodes each lower bound eliminated in the last search.
+     * @return              the cuts made by the largest option bound and the packing bound.
+     */
+    BoundCuts getBoundCuts() const;
+
+    /**
+     * @brief getNogoodStats  reports how often the last decision or minimum search found a set of
+     *                        uncovered cities it had already failed to cover.
+     * @return                the hits, misses, stores, and evictions of the table of nogoods.
+     */
+    NogoodTable::NogoodStats getNogoodStats() const;
+
+    /**
+     * @brief getSearchStats  reports the nodes, updates, mems, and solutions of every serial
+     *                        search since the last reset. Empty unless built with DLX_SEARCH_STATS.
+     * @return                the statistics Knuth keeps for his own dancing links programs.
+     */
+    const SearchStats& getSearchStats() const;
+
+    /**
+     * @brief resetSearchStats  clears the statistics so the next search is counted on its own.
+     */
+    void resetSearchStats();
+
+    /**
+     * @brief getWorkerNodes  reports how many nodes each thread entered in the last parallel search
+     *                        so callers can check how evenly work stealing spread the search.
+     * @return                the node count of each worker, empty before any parallel search.
+     */
+    const std::vector<long long>& getWorkerNodes() const;
+
 
 private:
 
 
     /* The cityItem will carry most of the logic of our problem. These nodes are in the grid we
      * set up in order for the links to "dance" as we recurse and leave the data structure in place.
+     * The width of an index is left open so that small grids can be searched with small nodes.
      */
-    struct cityItem {
+    template <typename Index>
+    struct basicCityItem {
         /* If this item is a column header, this is the number of items in a column.
          * If this item is in the grid, this is the index of the header for an item.
          */
-        int topOrLen;
+        Index topOrLen;
         // We traverse through options to cover one item with the up down field.
-        int up;
-        int down;
+        Index up;
+        Index down;
         // We cut an item within an option out of the world with the left right field to recurse.
-        int left;
-        int right;
+        Index left;
+        Index right;
     };
 
-    /* The cityHeader helps us track what items still need to be covered. We also use this as a
-     * lookup table for the names of the options in which we find an item. This option is the city
-     * we have given supplies to.
+    using cityItem = basicCityItem<int>;
+    using compactCityItem = basicCityItem<int16_t>;
+
+    /* The cityHeader helps us track what items still need to be covered. Choosing a city walks
+     * these links at every node of the search, so they hold nothing else. The names of the cities
+     * are kept apart in cityNames_ because the search never reads them.
      */
     struct cityHeader {
-        std::string name;
         int left;
         int right;
     };
@@ -91,44 +296,120 @@ private:
      * to this problem.
      */
     std::vector<cityHeader> table_;
+    // The name of the city at each header index. Only printing and debugging need these.
+    std::vector<std::string> cityNames_;
+    /* Most networks build fewer than 32768 nodes. Those are built with 16 bit indices so twice as
+     * many nodes fit in a cache line. Only larger networks are built with full size indices. One
+     * of these two grids is built and the other is always empty.
+     */
     std::vector<cityItem> grid_;
-    /* In this application, the number of colums equals the number of rows. Cities are both
-     * items that need to be covered and cities that can receive supplies.
+    std::vector<compactCityItem> compactGrid_;
+    // Spacers hold the negative option id plus one. This is the name we report for each option.
+    std::vector<std::string> supplyNames_;
+    /* In a graph the number of colums equals the number of rows. Cities are both items that need
+     * to be covered and cities that can receive supplies. A reduced network may have fewer options
+     * but a cover never needs more supplies than there are cities, so this counts the columns.
      */
     int numItemsAndOptions_;
 
+    /* We bound the search by how many uncovered cities the best remaining option could still cover.
+     * Every grid index knows the option it belongs to and every option knows how many of its
+     * cities are uncovered. Options are counted by that number so the largest is always at hand.
+     */
+    std::vector<int> optionOf_;
+    std::vector<int> liveCities_;
+    std::vector<int> optionsWithLive_;
+    int maxLive_;
+    int numUncovered_;
+    // A packing marks every option that covers a packed city. Stamps save us from clearing marks.
+    std::vector<int> packingStamp_;
+    int stamp_;
+    /* Uncovered cities are also linked into buckets by the length of their column so choosing the
+     * most isolated city never walks the table. City headers keep their table index here and the
+     * head of the bucket for length L is at numItemsAndOptions_ + 1 + L. Covering a city only
+     * splices it out of its bucket. A forbidden option moves its cities to a shorter bucket and we
+     * keep the links each city left behind so permitting the option puts it back in place.
+     */
+    std::vector<cityHeader> lengthLinks_;
+    std::vector<cityHeader> movedFrom_;
+    // The order rankOptions lists the options of the chosen city in. The stack keeps the lists.
+    OptionOrder optionOrder_;
+    BoundCuts cuts_;
+    /* The Zobrist hash of the uncovered cities names the sub-problem at every node. Failed nodes
+     * of the decision and minimum searches are remembered so other orders of the same choices
+     * skip them. Enumeration forbids options as it goes so it only reads the table and never
+     * writes to it.
+     */
+    std::vector<uint64_t> cityKeys_;
+    uint64_t uncoveredKey_;
+    NogoodTable nogoods_;
+    // The decision and minimum searches spend this budget so a caller may bound them.
+    SearchBudget budget_;
+    // The heuristic cover of the network as option ids. Empty if some city can not be covered.
+    std::vector<int> incumbent_;
+    // Choosing a city only reads the grid but still spends mems, so the counts may always change.
+    mutable SearchStats stats_;
+    // The nodes each thread entered in the last parallel search, to check the load balance.
+    std::vector<long long> workerNodes_;
+
 
     /* * * * * * * * * * * * * *       Modified Algorithm X via Dancing Links     * * * * * * * * */
 
 
     /**
-     * @brief isCovered       performs a modified exact cover search of a transportation Network.
-     *                        Given a number of supplies for the network, determines if every city
-     *                        is covered. A city is covered if it has received supplies or is
-     *                        adjacent to a city with supplies. If a city has supplies it may not
-     *                        be supplied again. However, if a city is safely covered by an adjacent
-     *                        city with supplies, this safe city may still receive supplies to cover
-     *                        other cities. With infinite supplies this algorithm will find a good
-     *                        solution. For the optimal solution, challenge decrease supply
-     *                        counts until it confirms a network cannot be covered with that amount.
-     * @param numSupplies     the number of supplies that we have to distribute over the network.
-     * @param suppliedCities  the output parameter showing the cities we have chosen to supply.
-     * @return                true if all cities are safe with given supplies, false if not.
+     * @brief isBeyondBounds  checks if the remaining uncovered cities certainly need more supplies
+     *                        than we have left. Any one option covers at most as many uncovered
+     *                        cities as the largest option. Any group of uncovered cities no two of
+     *                        which share an option needs a supply for each city in the group.
+     * @param grid           the grid we search, compact or full size.
+     * @param numSupplies     the number of supplies we have left to distribute.
+     * @return                true if either bound exceeds our supplies and we may stop searching.
+     */
+    template <typename Item>
+    bool isBeyondBounds(const std::vector<Item>& grid, int numSupplies);
+
+    /**
+     * @brief packCities   greedily gathers uncovered cities such that no option covers two of
+     *                     them. We stop early as soon as we have packed more than the limit.
+     * @param grid         the grid we search, compact or full size.
+     * @param limit        the number of supplies we have. Packing more cities proves failure.
+     * @return             the number of cities we packed.
+     */
+    template <typename Item>
+    int packCities(const std::vector<Item>& grid, int limit);
+
+    /**
+     * @brief rankOptions  appends the options covering the chosen city to a list. If we rank them,
+     *                     options covering the most uncovered cities come first and ties keep the
+     *                     order of the column. The options already in the list are not touched.
+     * @param grid         the grid we search, compact or full size.
+     * @param header       the header of the city we chose to cover.
+     * @param ranked       the list of options for every node on our path. We add this node's.
+     */
+    template <typename Item>
+    void rankOptions(const std::vector<Item>& grid, int header, std::vector<int>& ranked);
+
+    /**
+     * @brief loseLiveCity  records that an option has one less uncovered city it could cover.
+     * @param option        the option that lost a city.
+     */
+    void loseLiveCity(int option);
+
+    /**
+     * @brief regainLiveCity  records that an option has one more uncovered city it could cover.
+     * @param option          the option that regained a city.
      */
-    bool isCovered(int numSupplies, std::set<std::string>& suppliedCities);
+    void regainLiveCity(int option);
 
     /**
-     * @brief fillConfigurations  finds all possible distributions of the given number of supplies.
-     *                            It generates duplicate configurations and uses a std::set to filter
-     *                            them out. This is slow and I want to only generate unique
-     *                            configurations but am having trouble finding a way.
-     * @param numSupplies         the number of supplies we have to distribute.
-     * @param suppliedCities      the set that will hold new configurations that work.
-     * @param allConfigurations   the set that records all configurations found.
+     * @brief nameSupplies     resolves the options on a stack of supplies to the names of the cities
+     *                         holding them. The search only deals in indices so this is the one
+     *                         place names are touched, once per cover we report.
+     * @param supplies         the option ids of the cities we supplied.
+     * @param suppliedCities   the output parameter to which we add the names of supplied cities.
      */
-    void fillConfigurations(int numSupplies,
-                              std::set<std::string>& suppliedCities,
-                              std::set<std::set<std::string>>& allConfigurations);
+    void nameSupplies(const std::vector<int>& supplies,
+                      std::set<std::string>& suppliedCities) const;
 
     /**
      * @brief chooseIsolatedCity  selects a city we are trying to cover either by giving it supplies
@@ -139,87 +420,254 @@ private:
      *                                most connections and try that first.
      *                              - If that fails try the next city with most connections.
      *                              - Finally, try actual city in question, not neighbors.
+     *                            The shortest bucket of cities holds the answer so this takes
+     *                            time in the length of the longest column, not the uncovered cities.
      * @return                    the index of the city we are selecting to attempt to cover.
      */
     int chooseIsolatedCity() const;
 
+    /**
+     * @brief leaveLengthBucket  splices a covered city out of the bucket for its column length.
+     * @param city               the header index of the city.
+     */
+    void leaveLengthBucket(int city);
+
+    /**
+     * @brief returnToLengthBucket  undoes leaveLengthBucket for the most recently covered city.
+     * @param city                  the header index of the city.
+     */
+    void returnToLengthBucket(int city);
+
+    /**
+     * @brief shortenColumn  moves a city to the front of the bucket for its shorter column.
+     * @param city           the header index of the city.
+     * @param length         the length of its column after a forbidden option left it.
+     */
+    void shortenColumn(int city, int length);
+
+    /**
+     * @brief lengthenColumn  undoes shortenColumn for the city moved most recently.
+     * @param city            the header index of the city.
+     */
+    void lengthenColumn(int city);
+
     /**
      * @brief coverCity      covers a city in the option indicated by the index. A city in question
      *                       may be covered by supplying a neighbor or supplying the city itself.
+     * @param grid           the grid we search, compact or full size.
      * @param indexInOption  the index we start at for item in the supply option(row) we found it.
-     * @return               the string of the option we used to cover a city, neighbor or city.
+     * @return               the option id of the city we supplied, neighbor or city.
      */
-    std::string coverCity(int indexInOption);
+    template <typename Item>
+    int coverCity(std::vector<Item>& grid, int indexInOption);
 
     /**
      * @brief uncoverCity    uncovers a city if that choice of option did not lead to a covered
      *                       network. Uncovers same option that was selected for coverage if given
      *                       the same index.
+     * @param grid           the grid we search, compact or full size.
      * @param indexInOption  the index we start at for item in the supply option(row) we found it.
      */
-    void uncoverCity(int indexInOption);
+    template <typename Item>
+    void uncoverCity(std::vector<Item>& grid, int indexInOption);
 
     /**
      * @brief hideCityCol  when we supply an option it covers itself and connected cities. We must
      *                     remove these cities from any other sets that contain them to make them
      *                     disappear from the world as uncovered cities. However, we keep them as
      *                     available cities to supply.
+     * @param grid         the grid we search, compact or full size.
      * @param start        the city we start at in a row. We traverse downward to snip city out.
      */
-    void hideCityCol(int indexInCol);
+    template <typename Item>
+    void hideCityCol(std::vector<Item>& grid, int indexInCol);
 
     /**
      * @brief unhideCityCol  when an option fails, we must put the cities it covers back into all
      *                       the sets to which they belong. This puts the cities back in network.
      * @param start          the city in the option we start at. We traverse upward to unhide.
      * @param index          the index we need cities to point to in order to restore network.
+     * @param grid           the grid we search, compact or full size.
      */
-    void unhideCityCol(int indexInCol);
+    template <typename Item>
+    void unhideCityCol(std::vector<Item>& grid, int indexInCol);
+
+    /**
+     * @brief forbidOption   removes an option from every column in which it can still be found so
+     *                       it may not be chosen to cover any other city. The column of the city we
+     *                       chose to cover is left alone because we are traversing it and that city
+     *                       will be covered by a sibling option in any case.
+     * @param grid           the grid we search, compact or full size.
+     * @param indexInOption  the index of the chosen city in the option we forbid.
+     */
+    template <typename Item>
+    void forbidOption(std::vector<Item>& grid, int indexInOption);
+
+    /**
+     * @brief permitOption   restores an option to every column from which it was forbidden. Options
+     *                       must be permitted in the reverse order they were forbidden.
+     * @param grid           the grid we search, compact or full size.
+     * @param indexInOption  the index of the chosen city in the option we permit.
+     */
+    template <typename Item>
+    void permitOption(std::vector<Item>& grid, int indexInOption);
+
+
+    /* * * * * * * * * * * * * *       Hooks for the Parallel Search Driver       * * * * * * * * */
+
+
+    /* The IterativeSearch stack steps every search of this network, ParallelSearch, and the
+     * generators. These small wrappers give it a uniform way to do so across the dancing links
+     * classes. They are bound to the grid we built so its width is settled once per search, not at
+     * every step. A search that decides prunes with our bounds and nogoods and tries the options
+     * we rank. Enumeration walks the column of chooseItem so that it finds every cover.
+     */
+    template <typename Item>
+    class GridHooks {
+    public:
+        GridHooks(DisasterLinks& links, std::vector<Item>& grid);
+        bool isSolved() const;
+        int chooseItem() const;
+        int nextOption(int indexInOption) const;
+        int coverOption(int indexInOption, int depthTag);
+        void uncoverOption(int indexInOption);
+        // The depth tag of a decision search is the number of supplies left at a node.
+        bool isPruned(int depthTag);
+        int chooseOptions(std::vector<int>& options);
+        void recordNogood(int depthTag);
+        SearchStats& stats() const;
+        // The SolutionGenerator also retires options it has exhausted so no solution repeats.
+        void retireOption(int indexInOption);
+        void restoreOption(int indexInOption);
+    private:
+        DisasterLinks& links_;
+        std::vector<Item>& grid_;
+    };
+
+    /**
+     * @brief withHooks  runs a step of the IterativeSearch stack with hooks for the grid we built.
+     * @param step       the step to run given the hooks it should use.
+     * @return           whatever the step returns.
+     */
+    template <typename Step>
+    auto withHooks(const Step& step) -> decltype(step(std::declval<GridHooks<cityItem>&>())) {
+        if (compactGrid_.empty()) {
+            GridHooks<cityItem> hooks(*this, grid_);
+            return step(hooks);
+        }
+        GridHooks<compactCityItem> hooks(*this, compactGrid_);
+        return step(hooks);
+    }
 
 
     /* * * * * * * * * * * * * *    Logic to Build the Dancing Links Structure    * * * * * * * * */
 
 
+    /**
+     * @brief buildGrid    runs every pass that builds the dancing links grid and the tables we use
+     *                     to bound the search and choose cities.
+     * @param roadNetwork  the cities to cover and the cities each option covers.
+     * @param grid         the grid we build, compact or full size.
+     */
+    template <typename Item>
+    void buildGrid(const CoverNetwork& roadNetwork, std::vector<Item>& grid);
+
     /**
      * @brief initializeHeaders  creates the lookup table of city names and the first row of headers
      *                           that are in the dancing links array. This is the first pass on the
-     *                           input map. We will perform a second, much longer pass to build the
+     *                           graph. We will perform a second, much longer pass to build the
      *                           columns later.
-     * @param roadNetwork        the input of cities connected to other cities.
-     * @param connectionSizes    a city and the size of the set of adjacent cities.
-     * @param columnBuilder      the hash map we will use to connect newly added items to a column.
+     * @param roadNetwork        the cities to cover and the cities each option covers.
+     * @param grid               the grid we build, compact or full size.
+     * @param connectionSizes    an option id and the number of cities it covers.
+     * @param columnBuilder      the last index of each city's column so far, indexed by city id.
      */
-    void initializeHeaders(const std::map<std::string, std::set<std::string>>& roadNetwork,
-                            std::vector<std::pair<std::string,int>>& connectionSizes,
-                            std::unordered_map<std::string,int>& columnBuilder);
+    template <typename Item>
+    void initializeHeaders(const CoverNetwork& roadNetwork,
+                           std::vector<Item>& grid,
+                           std::vector<std::pair<int,int>>& connectionSizes,
+                           std::vector<int>& columnBuilder);
 
     /**
      * @brief initializeItems  builds the structure needed to perform the dancing links algorithm.
      *                         This focusses on setting up the grid in the dancing Network struct
      *                         so that all item columns are tallied correctly and the option rows
      *                         represent all the cities that a supply city can cover, self included.
-     * @param roadNetwork      we need to look back at the original map to grab sets to build.
+     * @param roadNetwork      we need to look back at the network to grab the cities to build.
+     * @param grid             the grid we build, compact or full size.
      * @param connectionSizes  we organize rows in descending order top to bottom as a heuristic.
-     * @param columnBuilder    the map we use to help build an accurate column for each city item.
-     * @param index            we are passed in a starting index to begin building
+     * @param columnBuilder    the last index of each city's column so far, indexed by city id.
      */
-    void initializeItems(const std::map<std::string, std::set<std::string>>& roadNetwork,
-                          const std::vector<std::pair<std::string,int>>& connectionSizes,
-                          std::unordered_map<std::string,int>& columnBuilder);
+    template <typename Item>
+    void initializeItems(const CoverNetwork& roadNetwork,
+                         std::vector<Item>& grid,
+                         const std::vector<std::pair<int,int>>& connectionSizes,
+                         std::vector<int>& columnBuilder);
 
     /**
      * @brief initializeColumns  this is the set builder for each row. When a city is given supplies
      *                           it is connected to itself and its adjacent cities. We represent
      *                           this in a row and connect each item to any appearance in a previous
-     *                           row so that each column is built.
-     * @param connections        the set containing the city and all adjacent connections.
-     * @param columnBuilder      the map we use to track the last appearance of an item in a column.
+     *                           row so that each column is built. The cities of an option are
+     *                           sorted so the row stays in order of city id.
+     * @param roadNetwork        the network holding the cities each option covers.
+     * @param grid               the grid we build, compact or full size.
+     * @param option             the id of the option whose row we are building.
+     * @param columnBuilder      the last index of each city's column so far, indexed by city id.
      * @param index              the index of the array at which we start building.
      * @return                   the new index of the grid after adding all items in a row.
      */
-    int initializeColumns(const std::set<std::string>& connections,
-                           std::unordered_map<std::string,int>& columnBuilder,
-                           int index);
+    template <typename Item>
+    int initializeColumns(const CoverNetwork& roadNetwork,
+                          std::vector<Item>& grid,
+                          int option,
+                          std::vector<int>& columnBuilder,
+                          int index);
+
+    /**
+     * @brief appendToColumn  adds one item to the bottom of a city's column at the end of the grid.
+     * @param grid            the grid we build, compact or full size.
+     * @param city            the id of the city we add to its column.
+     * @param columnBuilder   the last index of each city's column so far, indexed by city id.
+     * @param index           the index of the grid at which the new item is placed.
+     */
+    template <typename Item>
+    void appendToColumn(std::vector<Item>& grid,
+                        int city,
+                        std::vector<int>& columnBuilder,
+                        int index);
+
+    /**
+     * @brief initializeBounds  records the option of every grid index and the number of cities
+     *                          each option covers so we can bound the search. Call after the grid
+     *                          is complete.
+     * @param grid              the grid we built, compact or full size.
+     */
+    template <typename Item>
+    void initializeBounds(const std::vector<Item>& grid);
+
+    /**
+     * @brief initializeLengthBuckets  links every city into the bucket for its column length in
+     *                                 the order of the table.
+     * @param grid                     the grid we built, compact or full size.
+     */
+    template <typename Item>
+    void initializeLengthBuckets(const std::vector<Item>& grid);
+
+    /**
+     * @brief makeItem  narrows the fields of a new item to the width of the grid we build. Every
+     *                  value has been checked to fit before we build a compact grid.
+     * @return          the item holding the given fields.
+     */
+    template <typename Item>
+    static Item makeItem(int topOrLen, int up, int down, int left, int right);
+
+    /**
+     * @brief getGrid  copies whichever grid we built with full size indices, so tests and printing
+     *                 read one layout. The end marker of a compact grid is widened to INT_MIN.
+     * @return         the grid as it would be if it had been built at full size.
+     */
+    std::vector<cityItem> getGrid() const;
 
 
     /* The following operators are nothing special. The fields of these types are simple integers.
@@ -236,6 +684,9 @@ private:
     friend std::ostream& operator<<(std::ostream&os, const std::vector<cityItem>& grid);
     friend std::ostream& operator<<(std::ostream&os, const std::vector<cityHeader>& grid);
     friend std::ostream& operator<<(std::ostream&os, const DisasterLinks& network);
+    template <typename Links, typename Option> friend class IterativeSearch;
+    template <typename Links, typename Option> friend class ParallelSearch;
+    template <typename Links, typename Option> friend class SolutionGenerator;
     // I like to test the private internals of a class rather than just unit tests so add this here.
     ALLOW_TEST_ACCESS();
 };
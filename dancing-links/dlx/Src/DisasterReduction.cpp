@@ -0,0 +1,221 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: DisasterReduction.cpp
+ * --------------------------
+ * This file contains the implementation of the domination rules that shrink a transportation grid
+ * before the disaster cover search. The network is small next to the search tree so we simply keep
+ * sorted lists of ids in both directions and sweep the rules over every city and option until a
+ * full sweep changes nothing.
+ */
+#include <algorithm>
+#include "DisasterReduction.h"
+
+namespace DancingLinks {
+
+
+/* * * * * * * * * * * * * * * * *   Applying the Domination Rules   * * * * * * * * * * * * * * * */
+
+
+DisasterReduction::DisasterReduction(const std::map<std::string,
+                                     std::set<std::string>>& roadNetwork)
+    : DisasterReduction(NetworkGraph(roadNetwork)) {}
+
+DisasterReduction::DisasterReduction(const NetworkGraph& roadNetwork)
+    : names_(),
+      optionCities_(),
+      cityOptions_(),
+      isOptionLive_(),
+      isCityLive_(),
+      forced_(),
+      counts_({0, 0, 0}) {
+    CoverNetwork network(roadNetwork);
+    int numCities = network.numItems();
+    names_.reserve(numCities);
+    optionCities_.resize(numCities);
+    cityOptions_.resize(numCities);
+    for (int option = 0; option < numCities; option++) {
+        names_.push_back(network.optionName(option));
+        for (int entry = network.optionBegin(option); entry < network.optionEnd(option); entry++) {
+            int city = network.item(entry);
+            // Options are visited in order so every list of options is built already sorted.
+            optionCities_[option].push_back(city);
+            cityOptions_[city].push_back(option);
+        }
+    }
+    isOptionLive_.assign(numCities, true);
+    isCityLive_.assign(numCities, true);
+
+    // Each rule can expose more work for the others so we only stop once they all agree.
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = forceSupplies();
+        isChanged = removeDominatedOptions() || isChanged;
+        isChanged = removeDominatedCities() || isChanged;
+    }
+}
+
+bool DisasterReduction::forceSupplies() {
+    bool isChanged = false;
+    for (int city = 0; city < (int)cityOptions_.size(); city++) {
+        if (!isCityLive_[city]) {
+            continue;
+        }
+        if (cityOptions_[city].empty()) {
+            error("A city can not be covered by any supply location.");
+        }
+        if (cityOptions_[city].size() == 1) {
+            supplyOption(cityOptions_[city].front());
+            isChanged = true;
+        }
+    }
+    return isChanged;
+}
+
+bool DisasterReduction::removeDominatedOptions() {
+    bool isChanged = false;
+    for (int option = 0; option < (int)optionCities_.size(); option++) {
+        if (!isOptionLive_[option]) {
+            continue;
+        }
+        const std::vector<int>& cities = optionCities_[option];
+        if (cities.empty()) {
+            // Every city this location covers is already safe.
+            removeOption(option);
+            counts_.dominatedOptions++;
+            isChanged = true;
+            continue;
+        }
+        // A location covering all of our cities must cover the rarest one so only look there.
+        int rarest = cities.front();
+        for (int city : cities) {
+            if (cityOptions_[city].size() < cityOptions_[rarest].size()) {
+                rarest = city;
+            }
+        }
+        for (int other : cityOptions_[rarest]) {
+            const std::vector<int>& otherCities = optionCities_[other];
+            if (other != option
+                    && (cities.size() < otherCities.size() || other < option)
+                    && std::includes(otherCities.begin(), otherCities.end(),
+                                     cities.begin(), cities.end())) {
+                removeOption(option);
+                counts_.dominatedOptions++;
+                isChanged = true;
+                break;
+            }
+        }
+    }
+    return isChanged;
+}
+
+bool DisasterReduction::removeDominatedCities() {
+    bool isChanged = false;
+    for (int city = 0; city < (int)cityOptions_.size(); city++) {
+        if (!isCityLive_[city]) {
+            continue;
+        }
+        const std::vector<int>& options = cityOptions_[city];
+        // A city reached by all of our options must be in the smallest one so only look there.
+        int smallest = options.front();
+        for (int option : options) {
+            if (optionCities_[option].size() < optionCities_[smallest].size()) {
+                smallest = option;
+            }
+        }
+        // Removing cities edits the option we are reading so we walk a copy of it.
+        const std::vector<int> candidates = optionCities_[smallest];
+        for (int other : candidates) {
+            const std::vector<int>& otherOptions = cityOptions_[other];
+            if (other != city
+                    && (options.size() < otherOptions.size() || city < other)
+                    && std::includes(otherOptions.begin(), otherOptions.end(),
+                                     options.begin(), options.end())) {
+                removeCity(other);
+                counts_.dominatedCities++;
+                isChanged = true;
+            }
+        }
+    }
+    return isChanged;
+}
+
+void DisasterReduction::supplyOption(int option) {
+    forced_.push_back(option);
+    counts_.forcedSupplies++;
+    const std::vector<int> covered = optionCities_[option];
+    for (int city : covered) {
+        removeCity(city);
+    }
+    removeOption(option);
+}
+
+void DisasterReduction::removeOption(int option) {
+    isOptionLive_[option] = false;
+    for (int city : optionCities_[option]) {
+        eraseSorted(cityOptions_[city], option);
+    }
+    optionCities_[option].clear();
+}
+
+void DisasterReduction::removeCity(int city) {
+    isCityLive_[city] = false;
+    for (int option : cityOptions_[city]) {
+        eraseSorted(optionCities_[option], city);
+    }
+    cityOptions_[city].clear();
+}
+
+void DisasterReduction::eraseSorted(std::vector<int>& ids, int id) {
+    auto found = std::lower_bound(ids.begin(), ids.end(), id);
+    if (found != ids.end() && *found == id) {
+        ids.erase(found);
+    }
+}
+
+
+/* * * * * * * * * * * * * * * * *    Reading the Reduced Network    * * * * * * * * * * * * * * * */
+
+
+CoverNetwork DisasterReduction::getReducedNetwork() const {
+    // The cities that remain are numbered again from zero in their original order.
+    std::vector<int> newId(names_.size(), -1);
+    std::vector<std::string> cityNames = {};
+    for (int city = 0; city < (int)names_.size(); city++) {
+        if (isCityLive_[city]) {
+            newId[city] = cityNames.size();
+            cityNames.push_back(names_[city]);
+        }
+    }
+    std::vector<std::string> optionNames = {};
+    std::vector<int> offsets = {0};
+    std::vector<int> cities = {};
+    for (int option = 0; option < (int)names_.size(); option++) {
+        if (isOptionLive_[option] && !optionCities_[option].empty()) {
+            optionNames.push_back(names_[option]);
+            for (int city : optionCities_[option]) {
+                cities.push_back(newId[city]);
+            }
+            offsets.push_back(cities.size());
+        }
+    }
+    return CoverNetwork(std::move(cityNames),
+                        std::move(optionNames),
+                        std::move(offsets),
+                        std::move(cities));
+}
+
+void DisasterReduction::restoreSupplies(std::set<std::string>& suppliedCities) const {
+    for (int option : forced_) {
+        suppliedCities.insert(names_[option]);
+    }
+}
+
+int DisasterReduction::getNumForced() const {
+    return forced_.size();
+}
+
+DisasterReduction::ReductionCounts DisasterReduction::getCounts() const {
+    return counts_;
+}
+
+} // namespace DancingLinks
@@ -0,0 +1,145 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: DisasterReduction.h
+ * --------------------------
+ * This file defines a preprocessing stage for the disaster planning problem. Many road networks
+ * have pendant towns and supply locations that can never do better than a neighbor. Before we hand
+ * a network to DisasterLinks or DisasterTags we apply safe domination rules until nothing changes.
+ *
+ *      - A city that only one supply location can reach forces that supply location.
+ *      - A supply location that covers a subset of the cities another location covers is never
+ *        needed. Supplying a pendant town is never better than supplying its neighbor.
+ *      - A city reached by a superset of the supply locations that reach another city is covered
+ *        whenever that other city is covered so we do not need to ask for it.
+ *
+ * These rules never change the size of an optimal cover. An optimal cover of the reduced network
+ * together with the forced supplies is an optimal cover of the original network. The rules may
+ * discard covers that are just as good so only the decision and minimum searches should use them.
+ */
+#ifndef DISASTERREDUCTION_H
+#define DISASTERREDUCTION_H
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "GUI/SimpleTest.h"
+#include "NetworkGraph.h"
+
+namespace DancingLinks {
+
+class DisasterReduction {
+
+public:
+
+
+    /**
+     * @brief DisasterReduction  reduces a transportation grid given in the map form the solvers
+     *                           have always accepted.
+     * @param roadNetwork        the map of each city to the cities it is connected to.
+     */
+    explicit DisasterReduction(const std::map<std::string, std::set<std::string>>& roadNetwork);
+
+    /**
+     * @brief DisasterReduction  applies every domination rule to the network until none of them
+     *                           can remove anything else.
+     * @param roadNetwork        the transportation grid as a graph of city ids.
+     */
+    explicit DisasterReduction(const NetworkGraph& roadNetwork);
+
+    /**
+     * @brief getReducedNetwork  builds the cities that still need a decision and the supply
+     *                           locations that may still be useful. Options keep the names of the
+     *                           cities they supply so solver output needs no translation.
+     * @return                   the reduced network ready for DisasterLinks or DisasterTags.
+     */
+    CoverNetwork getReducedNetwork() const;
+
+    /**
+     * @brief restoreSupplies  maps a cover of the reduced network back to the original network by
+     *                         adding the supply locations the reduction forced.
+     * @param suppliedCities   the cover of the reduced network. Holds a cover of the original.
+     */
+    void restoreSupplies(std::set<std::string>& suppliedCities) const;
+
+    /**
+     * @brief getNumForced  the number of supplies the reduction has already placed. Add this to the
+     *                      size of a cover of the reduced network for the size of the full cover.
+     * @return              the number of forced supply locations.
+     */
+    int getNumForced() const;
+
+    // How much each rule removed from the network.
+    struct ReductionCounts {
+        int forcedSupplies;
+        int dominatedOptions;
+        int dominatedCities;
+    };
+
+    ReductionCounts getCounts() const;
+
+
+private:
+
+
+    std::vector<std::string> names_;
+    // The cities each supply location still covers and the locations that still cover each city.
+    std::vector<std::vector<int>> optionCities_;
+    std::vector<std::vector<int>> cityOptions_;
+    std::vector<bool> isOptionLive_;
+    std::vector<bool> isCityLive_;
+    std::vector<int> forced_;
+    ReductionCounts counts_;
+
+
+    /**
+     * @brief forceSupplies  supplies every city that only one supply location can still reach.
+     * @return               true if any supply was forced.
+     */
+    bool forceSupplies();
+
+    /**
+     * @brief removeDominatedOptions  removes every supply location whose cities are all covered by
+     *                                another location. Of two equal locations we keep the first.
+     * @return                        true if any supply location was removed.
+     */
+    bool removeDominatedOptions();
+
+    /**
+     * @brief removeDominatedCities  stops asking for a city when every supply location that covers
+     *                               some other city also covers it. Of two equal cities we keep the
+     *                               first.
+     * @return                       true if any city was removed.
+     */
+    bool removeDominatedCities();
+
+    /**
+     * @brief supplyOption  places supplies at a location for good, covering all of its cities.
+     * @param option        the supply location we must use.
+     */
+    void supplyOption(int option);
+
+    /**
+     * @brief removeOption  removes a supply location from every city it could have covered.
+     * @param option        the supply location that is no longer needed.
+     */
+    void removeOption(int option);
+
+    /**
+     * @brief removeCity  removes a city from every supply location that could have covered it.
+     * @param city        the city that no longer needs a decision.
+     */
+    void removeCity(int city);
+
+    /**
+     * @brief eraseSorted  erases one id from a sorted list of ids if it is present.
+     * @param ids          the sorted list.
+     * @param id           the id to erase.
+     */
+    static void eraseSorted(std::vector<int>& ids, int id);
+
+    ALLOW_TEST_ACCESS();
+};
+
+} // namespace DancingLinks
+
+#endif // DISASTERREDUCTION_H
@@ -6,9 +6,10 @@
  * calling Supply Tags. For more information, see the mini-writeup in the DancingLinks.h file or the
  * detailed write up in the README.md.
  */
-#include <cmath>
+#include <algorithm>
 #include <climits>
 #include "DisasterTags.h"
+#include "ParallelSearch.h"
 
 namespace DancingLinks {
 
@@ -21,53 +22,154 @@ bool hasOverlappingCover(DisasterTags& links, int numSupplies,
     return links.hasDisasterCoverage(numSupplies, selectedOptions);
 }
 
+bool hasOverlappingCover(DisasterTags& links, int numSupplies,
+                           std::set<std::string>& selectedOptions, int numThreads) {
+    return links.hasDisasterCoverage(numSupplies, selectedOptions, numThreads);
+}
+
+SearchStatus hasOverlappingCover(DisasterTags& links, int numSupplies,
+                                 std::set<std::string>& selectedOptions,
+                                 const SearchLimits& limits) {
+    return links.hasDisasterCoverage(numSupplies, selectedOptions, limits);
+}
+
+SearchStatus hasOverlappingCover(DisasterTags& links, int numSupplies,
+                                 std::set<std::string>& selectedOptions, int numThreads,
+                                 const SearchLimits& limits) {
+    return links.hasDisasterCoverage(numSupplies, selectedOptions, numThreads, limits);
+}
+
+int getMinimumOverlappingCover(DisasterTags& links, std::set<std::string>& selectedOptions) {
+    return links.findMinimumSupplies(selectedOptions);
+}
+
+SearchStatus getMinimumOverlappingCover(DisasterTags& links,
+                                        std::set<std::string>& selectedOptions,
+                                        const SearchLimits& limits) {
+    return links.findMinimumSupplies(selectedOptions, limits);
+}
+
+int getApproximateOverlappingCover(DisasterTags& links, std::set<std::string>& selectedOptions) {
+    return links.findApproximateSupplies(selectedOptions);
+}
+
 std::set<std::set<std::string>> getAllOverlappingCovers(DisasterTags& links, int numSupplies) {
     return links.getAllDisasterConfigurations(numSupplies);
 }
 
+std::vector<std::set<std::string>> getUniqueOverlappingCovers(DisasterTags& links, int numSupplies) {
+    return links.getUniqueDisasterConfigurations(numSupplies);
+}
+
+uint64_t countOverlappingCovers(DisasterTags& links, int numSupplies) {
+    return links.countDisasterConfigurations(numSupplies);
+}
+
+bool visitOverlappingCovers(DisasterTags& links, int numSupplies,
+                            const std::function<bool(const std::vector<int>&)>& visit) {
+    return links.visitDisasterConfigurations(numSupplies, visit);
+}
+
 
 /* * * * * * * * * * * * *  Algorithm X via Dancing Links with Depth Tags * * * * * * * * * * * * */
 
 
 bool DisasterTags::hasDisasterCoverage(int numSupplies, std::set<std::string>& supplyLocations) {
+    return hasDisasterCoverage(numSupplies, supplyLocations, SearchLimits()) == SearchStatus::FOUND;
+}
+
+bool DisasterTags::hasDisasterCoverage(int numSupplies,
+                                       std::set<std::string>& supplyLocations,
+                                       int numThreads) {
+    return hasDisasterCoverage(numSupplies, supplyLocations, numThreads, SearchLimits())
+           == SearchStatus::FOUND;
+}
+
+SearchStatus DisasterTags::hasDisasterCoverage(int numSupplies,
+                                               std::set<std::string>& supplyLocations,
+                                               const SearchLimits& limits) {
     if (numSupplies < 0) {
         error("negative supplies");
     }
     if (numItemsAndOptions_ == 0) {
-        return true;
+        return SearchStatus::FOUND;
     }
-    return isDLXCovered(numSupplies, supplyLocations);
+    cuts_ = {0, 0};
+    nogoods_.prepare();
+    budget_ = SearchBudget(limits);
+    std::vector<int> supplies = {};
+    IterativeSearch<DisasterTags,int> search(numSupplies, SearchMode::DECIDE);
+    if (!search.findCover(*this, supplies, budget_)) {
+        return budget_.isAborted() ? SearchStatus::ABORTED : SearchStatus::INFEASIBLE;
+    }
+    nameSupplies(supplies, supplyLocations);
+    return SearchStatus::FOUND;
 }
 
-bool DisasterTags::isDLXCovered(int numSupplies, std::set<std::string>& supplyLocations) {
-    if (table_[0].right == 0 && numSupplies >= 0) {
-        return true;
+SearchStatus DisasterTags::hasDisasterCoverage(int numSupplies,
+                                               std::set<std::string>& supplyLocations,
+                                               int numThreads,
+                                               const SearchLimits& limits) {
+    if (numSupplies < 0) {
+        error("negative supplies");
     }
-    if (numSupplies <= 0) {
-        return false;
+    if (numItemsAndOptions_ == 0) {
+        return SearchStatus::FOUND;
+    }
+    ParallelSearch<DisasterTags,int> search(*this, numThreads);
+    std::set<int> supplies = {};
+    SearchStatus status = search.findCover(numSupplies, supplies, limits);
+    workerNodes_ = search.nodesPerWorker();
+    if (status == SearchStatus::FOUND) {
+        nameSupplies(std::vector<int>(supplies.begin(), supplies.end()), supplyLocations);
     }
+    return status;
+}
 
-    int chosenIndex = chooseIsolatedCity();
+int DisasterTags::findMinimumSupplies(std::set<std::string>& suppliedCities) {
+    std::set<std::string> bestCities = {};
+    findMinimumSupplies(bestCities, SearchLimits());
+    suppliedCities.insert(bestCities.begin(), bestCities.end());
+    return bestCities.size();
+}
 
-    /* Try to cover this city by first supplying the most connected city nearby. Try cities with
-     * successively fewer connections then if all else fails supply the isolated city itself.
+SearchStatus DisasterTags::findMinimumSupplies(std::set<std::string>& suppliedCities,
+                                               const SearchLimits& limits) {
+    if (numItemsAndOptions_ == 0) {
+        return SearchStatus::FOUND;
+    }
+    cuts_ = {0, 0};
+    nogoods_.prepare();
+    budget_ = SearchBudget(limits);
+    /* The heuristic cover is the one to beat so every node only searches for something smaller.
+     * Without one, supplying every city is always a cover.
      */
-    for (int cur = grid_[chosenIndex].down; cur != chosenIndex; cur = grid_[cur].down) {
-
-        // Tag every city with the supply number so we know which cities to uncover if this fails.
-        std::string supplyLocation = coverCity(cur, numSupplies);
-
-        if (isDLXCovered(numSupplies - 1, supplyLocations)) {
-            // Only add to the output if successful and be sure to cleanup in case it runs again.
-            supplyLocations.insert(supplyLocation);
-            uncoverCity(cur);
-            return true;
-        }
+    int bestCount = incumbent_.empty() ? numItemsAndOptions_ + 1 : incumbent_.size();
+    std::vector<int> bestSupplies = incumbent_;
+    // The supplies we may give out are always one fewer than the best so the bounds prune more.
+    IterativeSearch<DisasterTags,int> search(bestCount - 1, SearchMode::DECIDE);
+    if (!search.improveCover(*this, bestSupplies, budget_)) {
+        nameSupplies(bestSupplies, suppliedCities);
+        return SearchStatus::ABORTED;
+    }
+    if (bestSupplies.empty()) {
+        // Only a network built by hand can leave a city that no supply location reaches.
+        error("A city can not be covered by any supply location.");
+    }
+    nameSupplies(bestSupplies, suppliedCities);
+    return SearchStatus::FOUND;
+}
 
-        // We will know which cities to uncover thanks to which we tagged on the way down.
-        uncoverCity(cur);
+int DisasterTags::findApproximateSupplies(std::set<std::string>& suppliedCities) const {
+    if (numItemsAndOptions_ == 0) {
+        return 0;
     }
-    return false;
+    if (incumbent_.empty()) {
+        // Only a network built by hand can leave a city that no supply location reaches.
+        error("A city can not be covered by any supply location.");
+    }
+    nameSupplies(incumbent_, suppliedCities);
+    return incumbent_.size();
 }
 
 std::set<std::set<std::string>> DisasterTags::getAllDisasterConfigurations(int numSupplies) {
@@ -75,42 +177,509 @@ std::set<std::set<std::string>> DisasterTags::getAllDisasterConfigurations(int n
         error("Negative supply count.");
     }
 
-    std::set<std::string> suppliedCities {};
     std::set<std::set<std::string>> allConfigurations = {};
-    fillConfigurations(numSupplies, suppliedCities, allConfigurations);
+    // Every path to a cover is walked, so the set filters a configuration reached more than once.
+    IterativeSearch<DisasterTags,int> search(numSupplies, SearchMode::EVERY_PATH);
+    search.visitCovers(*this, [&](const std::vector<int>& supplies) {
+        std::set<std::string> suppliedCities = {};
+        nameSupplies(supplies, suppliedCities);
+        allConfigurations.insert(suppliedCities);
+        return true;
+    });
     return allConfigurations;
 }
 
-void DisasterTags::fillConfigurations(int numSupplies,
-                                      std::set<std::string>& suppliedCities,
-                                      std::set<std::set<std::string>>& allConfigurations) {
+DisasterTags::BoundCuts DisasterTags::getBoundCuts() const {
+    return cuts_;
+}
 
-    if (table_[0].right == 0 && numSupplies >= 0) {
-        allConfigurations.insert(suppliedCities);
-        return;
+NogoodTable::NogoodStats DisasterTags::getNogoodStats() const {
+    return nogoods_.getStats();
+}
+
+const SearchStats& DisasterTags::getSearchStats() const {
+    return stats_;
+}
+
+void DisasterTags::resetSearchStats() {
+    stats_ = SearchStats();
+}
+
+const std::vector<long long>& DisasterTags::getWorkerNodes() const {
+    return workerNodes_;
+}
+
+std::vector<std::set<std::string>> DisasterTags::getUniqueDisasterConfigurations(int numSupplies) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
+    }
+
+    std::vector<std::set<std::string>> allConfigurations = {};
+    IterativeSearch<DisasterTags,int> search(numSupplies, SearchMode::UNIQUE);
+    search.visitCovers(*this, [&](const std::vector<int>& found) {
+        allConfigurations.emplace_back();
+        nameSupplies(found, allConfigurations.back());
+        return true;
+    });
+    return allConfigurations;
+}
+
+uint64_t DisasterTags::countDisasterConfigurations(int numSupplies) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
     }
-    if (numSupplies <= 0) {
-        return;
+
+    uint64_t count = 0;
+    IterativeSearch<DisasterTags,int> search(numSupplies, SearchMode::UNIQUE);
+    search.visitCovers(*this, [&](const std::vector<int>&) {
+        count++;
+        return true;
+    });
+    return count;
+}
+
+uint64_t DisasterTags::countMinimalConfigurations(int numSupplies) {
+    uint64_t count = 0;
+    countMinimalConfigurations(numSupplies, count, SearchLimits());
+    return count;
+}
+
+SearchStatus DisasterTags::countMinimalConfigurations(int numSupplies,
+                                                      uint64_t& count,
+                                                      const SearchLimits& limits) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
+    }
+    budget_ = SearchBudget(limits);
+    std::vector<int> chosen = {};
+    chosen.reserve(numItemsAndOptions_);
+    count = countMinimalCovers(numSupplies, chosen);
+    return budget_.isAborted() ? SearchStatus::ABORTED : SearchStatus::FOUND;
+}
+
+bool DisasterTags::visitDisasterConfigurations(int numSupplies,
+                                               const ConfigurationVisitor& visit) {
+    if (numSupplies < 0) {
+        error("Negative supply count.");
+    }
+
+    IterativeSearch<DisasterTags,int> search(numSupplies, SearchMode::UNIQUE);
+    return search.visitCovers(*this, visit);
+}
+
+const std::string& DisasterTags::getSupplyName(int option) const {
+    return supplyNames_[option];
+}
+
+void DisasterTags::setOptionOrder(OptionOrder order) {
+    optionOrder_ = order;
+}
+
+void DisasterTags::setSymmetries(const SymmetryGroup& symmetries) {
+    int numRows = liveCities_.size();
+    if (symmetries.numVertices() != numItemsAndOptions_ || numRows != numItemsAndOptions_
+            || (int)supplyNames_.size() != numItemsAndOptions_) {
+        error("Symmetries must act on the graph this network was built from.");
+    }
+    // Rows are sorted by size so the spacers tell us which row holds every option.
+    std::vector<int> optionOfRow(numRows);
+    std::vector<int> rowOfOption(numRows);
+    std::vector<int> rowStart(numRows);
+    for (int i = numItemsAndOptions_ + 1; i < (int)grid_.size() - 1; i++) {
+        if (grid_[i].topOrLen <= 0) {
+            int option = -grid_[i].topOrLen - 1;
+            optionOfRow[optionOf_[i]] = option;
+            rowOfOption[option] = optionOf_[i];
+            rowStart[optionOf_[i]] = i + 1;
+        }
+    }
+    cityImage_.clear();
+    rowImage_.clear();
+    rowPreimage_.clear();
+    for (int index = 1; index < symmetries.size(); index++) {
+        const std::vector<int>& element = symmetries.getElement(index);
+        // Headers count cities from one while the graph counts them from zero.
+        std::vector<int> cities(numItemsAndOptions_ + 1, 0);
+        for (int city = 1; city <= numItemsAndOptions_; city++) {
+            cities[city] = element[city - 1] + 1;
+        }
+        std::vector<int> rows(numRows);
+        std::vector<int> preimages(numRows);
+        for (int row = 0; row < numRows; row++) {
+            int image = rowOfOption[element[optionOfRow[row]]];
+            rows[row] = image;
+            preimages[image] = row;
+            // Both rows list their cities in order of the headers.
+            std::vector<int> mapped = {};
+            for (int i = rowStart[row]; grid_[i].topOrLen > 0; i++) {
+                mapped.push_back(cities[grid_[i].topOrLen]);
+            }
+            std::sort(mapped.begin(), mapped.end());
+            std::vector<int> expected = {};
+            for (int i = rowStart[image]; grid_[i].topOrLen > 0; i++) {
+                expected.push_back(grid_[i].topOrLen);
+            }
+            if (mapped != expected) {
+                error("A symmetry must map the network onto itself.");
+            }
+        }
+        cityImage_.push_back(std::move(cities));
+        rowImage_.push_back(std::move(rows));
+        rowPreimage_.push_back(std::move(preimages));
+    }
+    isGroupComplete_ = symmetries.isComplete();
+    // We are at rest so every uncovered city is in the table and nothing is chosen or forbidden.
+    uncoveredImageKeys_.assign(cityImage_.size(), 0);
+    for (int g = 0; g < (int)cityImage_.size(); g++) {
+        for (int cur = table_[0].right; cur != 0; cur = table_[cur].right) {
+            uncoveredImageKeys_[g] ^= cityKeys_[cityImage_[g][cur]];
+        }
+    }
+    chosenImageKeys_.assign(cityImage_.size(), 0);
+    forbiddenImageKeys_.assign(cityImage_.size(), 0);
+}
+
+uint64_t DisasterTags::countMinimalCovers(int numSupplies, std::vector<int>& chosen) {
+    DLX_STATS(stats_.enterNode(chosen.size()));
+    if (table_[0].right == 0) {
+        DLX_STATS(stats_.solutions++);
+        return isMinimalCover(chosen);
+    }
+    // Forbidding options only shortens columns so the bounds of the other searches still hold.
+    if (numSupplies <= 0 || isBeyondBounds(numSupplies) || budget_.isSpent()) {
+        return 0;
     }
     int chosenIndex = chooseIsolatedCity();
 
+    uint64_t count = 0;
+    if (isGroupComplete_ && !cityImage_.empty()
+            && countSymmetricSubsets(chosenIndex, numSupplies, chosen, count)) {
+        return count;
+    }
     for (int cur = grid_[chosenIndex].down; cur != chosenIndex; cur = grid_[cur].down) {
+        chosen.push_back(cur);
+        toggleChosen(optionOf_[cur]);
+        coverCity(cur, numSupplies);
 
-        std::string supplyLocation = coverCity(cur, numSupplies);
-        suppliedCities.insert(supplyLocation);
+        count += countMinimalCovers(numSupplies - 1, chosen);
 
-        fillConfigurations(numSupplies - 1, suppliedCities, allConfigurations);
-
-        suppliedCities.erase(supplyLocation);
         uncoverCity(cur);
+        toggleChosen(optionOf_[cur]);
+        chosen.pop_back();
+        if (budget_.isAborted()) {
+            // Only the options before this one were forbidden at this level.
+            for (int prev = grid_[cur].up; prev != chosenIndex; prev = grid_[prev].up) {
+                toggleForbidden(optionOf_[prev]);
+                permitOption(prev);
+            }
+            return count;
+        }
+        // Every configuration with this supply location has been counted. Siblings may not use it.
+        forbidOption(cur);
+        toggleForbidden(optionOf_[cur]);
     }
+    for (int cur = grid_[chosenIndex].up; cur != chosenIndex; cur = grid_[cur].up) {
+        toggleForbidden(optionOf_[cur]);
+        permitOption(cur);
+    }
+    return count;
+}
 
+bool DisasterTags::countSymmetricSubsets(int chosenIndex,
+                                         int numSupplies,
+                                         std::vector<int>& chosen,
+                                         uint64_t& count) {
+    // Only symmetries fixing what we chose, what we forbade, and the column map sets to sets.
+    std::vector<int> fixing = {};
+    for (int g = 0; g < (int)rowImage_.size(); g++) {
+        if (chosenImageKeys_[g] == chosenKey_ && forbiddenImageKeys_[g] == forbiddenKey_) {
+            fixing.push_back(g);
+        }
+    }
+    // A column of more options than this has too many subsets to be worth it.
+    if (fixing.empty() || grid_[chosenIndex].topOrLen > 12) {
+        return false;
+    }
+    std::vector<int> column = {};
+    for (int cur = grid_[chosenIndex].down; cur != chosenIndex; cur = grid_[cur].down) {
+        column.push_back(cur);
+    }
+    std::vector<std::vector<int>> moves = {};
+    for (int g : fixing) {
+        std::vector<int> move(column.size(), -1);
+        bool isFixed = true;
+        for (int j = 0; j < (int)column.size() && isFixed; j++) {
+            int image = rowImage_[g][optionOf_[column[j]]];
+            for (int k = 0; k < (int)column.size(); k++) {
+                if (optionOf_[column[k]] == image) {
+                    move[j] = k;
+                }
+            }
+            isFixed = move[j] != -1;
+        }
+        if (isFixed) {
+            moves.push_back(move);
+        }
+    }
+    if (moves.empty()) {
+        return false;
+    }
+    // The identity fixes every set so the symmetries that fix a set are never fewer than one.
+    uint64_t groupSize = moves.size() + 1;
+    for (uint32_t subset = 1; subset < (1u << column.size()); subset++) {
+        int size = 0;
+        for (int j = 0; j < (int)column.size(); j++) {
+            size += (subset >> j) & 1;
+        }
+        if (size > numSupplies) {
+            continue;
+        }
+        bool isLeast = true;
+        uint64_t numFixing = 1;
+        for (const std::vector<int>& move : moves) {
+            uint32_t image = 0;
+            for (int j = 0; j < (int)column.size(); j++) {
+                if ((subset >> j) & 1) {
+                    image |= 1u << move[j];
+                }
+            }
+            if (image < subset) {
+                isLeast = false;
+                break;
+            }
+            numFixing += image == subset;
+        }
+        if (!isLeast) {
+            continue;
+        }
+
+        // Every option in the set takes its own tag so we can take them away in reverse.
+        int supplyTag = numSupplies;
+        for (int j = 0; j < (int)column.size(); j++) {
+            if ((subset >> j) & 1) {
+                chosen.push_back(column[j]);
+                toggleChosen(optionOf_[column[j]]);
+                coverCity(column[j], supplyTag--);
+            } else {
+                forbidOption(column[j]);
+                toggleForbidden(optionOf_[column[j]]);
+            }
+        }
+
+        // The set stands for every image of it, each of which finds as many configurations.
+        count += groupSize / numFixing * countMinimalCovers(numSupplies - size, chosen);
+
+        for (int j = column.size() - 1; j >= 0; j--) {
+            if ((subset >> j) & 1) {
+                uncoverCity(column[j]);
+                toggleChosen(optionOf_[column[j]]);
+                chosen.pop_back();
+            } else {
+                toggleForbidden(optionOf_[column[j]]);
+                permitOption(column[j]);
+            }
+        }
+        if (budget_.isAborted()) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool DisasterTags::isMinimalCover(const std::vector<int>& chosen) {
+    // Rows are laid out contiguously so walk right, wrapping to the start of the row at the spacer.
+    for (int start : chosen) {
+        int i = start;
+        do {
+            int top = grid_[i].topOrLen;
+            if (top <= 0) {
+                i = grid_[i].up;
+            } else {
+                coverCount_[top]++;
+                i++;
+            }
+        } while (i != start);
+    }
+    bool isMinimal = true;
+    for (int start : chosen) {
+        bool isNeeded = false;
+        int i = start;
+        do {
+            int top = grid_[i].topOrLen;
+            if (top <= 0) {
+                i = grid_[i].up;
+            } else {
+                isNeeded = isNeeded || coverCount_[top] == 1;
+                i++;
+            }
+        } while (i != start);
+        isMinimal = isMinimal && isNeeded;
+    }
+    for (int start : chosen) {
+        int i = start;
+        do {
+            int top = grid_[i].topOrLen;
+            if (top <= 0) {
+                i = grid_[i].up;
+            } else {
+                coverCount_[top]--;
+                i++;
+            }
+        } while (i != start);
+    }
+    return isMinimal;
+}
+
+void DisasterTags::toggleChosen(int row) {
+    chosenKey_ ^= rowKeys_[row];
+    for (int g = 0; g < (int)rowImage_.size(); g++) {
+        chosenImageKeys_[g] ^= rowKeys_[rowImage_[g][row]];
+    }
+}
+
+void DisasterTags::toggleForbidden(int row) {
+    forbiddenKey_ ^= rowKeys_[row];
+    for (int g = 0; g < (int)rowImage_.size(); g++) {
+        forbiddenImageKeys_[g] ^= rowKeys_[rowImage_[g][row]];
+    }
+}
+
+bool DisasterTags::isSymmetricOption(int indexInOption, uint64_t node) const {
+    int row = optionOf_[indexInOption];
+    for (int g = 0; g < (int)rowPreimage_.size(); g++) {
+        // Only a symmetry that fixes the uncovered cities maps this node onto itself.
+        if (uncoveredImageKeys_[g] == uncoveredKey_ && triedAt_[rowPreimage_[g][row]] == node) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DisasterTags::recordNogood(int numSupplies) {
+    nogoods_.recordInfeasible(uncoveredKey_, numSupplies);
+    for (uint64_t imageKey : uncoveredImageKeys_) {
+        if (imageKey != uncoveredKey_) {
+            nogoods_.recordInfeasible(imageKey, numSupplies);
+        }
+    }
+}
+
+bool DisasterTags::isBeyondBounds(int numSupplies) {
+    // Even if every supply covered as many cities as the largest option we would fall short.
+    if (numUncovered_ > numSupplies * maxLive_) {
+        cuts_.optionSize++;
+        return true;
+    }
+    // Cities that share no option must each be covered by a different supply.
+    if (packCities(numSupplies) > numSupplies) {
+        cuts_.packing++;
+        return true;
+    }
+    return false;
+}
+
+int DisasterTags::packCities(int limit) {
+    if (++stamp_ == INT_MAX) {
+        std::fill(packingStamp_.begin(), packingStamp_.end(), 0);
+        stamp_ = 1;
+    }
+    int packed = 0;
+    for (int cur = table_[0].right; cur != 0; cur = table_[cur].right) {
+        bool isDisjoint = true;
+        for (int i = grid_[cur].down; i != cur && isDisjoint; i = grid_[i].down) {
+            isDisjoint = packingStamp_[optionOf_[i]] != stamp_;
+        }
+        if (isDisjoint) {
+            for (int i = grid_[cur].down; i != cur; i = grid_[i].down) {
+                packingStamp_[optionOf_[i]] = stamp_;
+            }
+            if (++packed > limit) {
+                return packed;
+            }
+        }
+    }
+    return packed;
+}
+
+void DisasterTags::rankOptions(int header, std::vector<int>& ranked) {
+    int first = ranked.size();
+    for (int i = grid_[header].down; i != header; i = grid_[i].down) {
+        int k = ranked.size();
+        ranked.push_back(i);
+        if (optionOrder_ == OptionOrder::MOST_UNCOVERED) {
+            // Columns are short so an insertion sort that stops at equal options is enough.
+            int live = liveCities_[optionOf_[i]];
+            for (; k > first && liveCities_[optionOf_[ranked[k - 1]]] < live; k--) {
+                ranked[k] = ranked[k - 1];
+            }
+            ranked[k] = i;
+        }
+    }
+}
+
+void DisasterTags::tagLiveCity(int header) {
+    numUncovered_--;
+    for (int i = grid_[header].down; i != header; i = grid_[i].down) {
+        int option = optionOf_[i];
+        optionsWithLive_[liveCities_[option]]--;
+        optionsWithLive_[--liveCities_[option]]++;
+        // The largest option can only shrink by one city at a time so one step down is enough.
+        if (!optionsWithLive_[maxLive_]) {
+            maxLive_--;
+        }
+        // The header is already tagged so the city left in the option is the one it stopped helping.
+        if (liveCities_[option] == 1) {
+            usefulOptions_[findLiveCity(i)]--;
+        }
+    }
+    for (int g = 0; g < (int)cityImage_.size(); g++) {
+        uncoveredImageKeys_[g] ^= cityKeys_[cityImage_[g][header]];
+    }
+}
+
+void DisasterTags::untagLiveCity(int header) {
+    numUncovered_++;
+    for (int g = 0; g < (int)cityImage_.size(); g++) {
+        uncoveredImageKeys_[g] ^= cityKeys_[cityImage_[g][header]];
+    }
+    for (int i = grid_[header].up; i != header; i = grid_[i].up) {
+        int option = optionOf_[i];
+        // Untagging mirrors tagging so the header is still tagged and the same city is left.
+        if (liveCities_[option] == 1) {
+            usefulOptions_[findLiveCity(i)]++;
+        }
+        optionsWithLive_[liveCities_[option]]--;
+        optionsWithLive_[++liveCities_[option]]++;
+        maxLive_ = std::max(maxLive_, liveCities_[option]);
+    }
+}
+
+int DisasterTags::findLiveCity(int indexInOption) const {
+    // Rows are laid out contiguously so walk right, wrapping to the start of the row at the spacer.
+    for (int i = indexInOption + 1; i != indexInOption; i++) {
+        int top = grid_[i].topOrLen;
+        if (top <= 0) {
+            i = grid_[i].up - 1;
+        } else if (!grid_[top].supplyTag) {
+            return top;
+        }
+    }
+    return 0;
+}
+
+void DisasterTags::nameSupplies(const std::vector<int>& supplies,
+                                std::set<std::string>& suppliedCities) const {
+    for (int option : supplies) {
+        suppliedCities.insert(supplyNames_[option]);
+    }
 }
 
 int DisasterTags::chooseIsolatedCity() const {
     int min = INT_MAX;
     int chosenIndex = 0;
     for (int cur = table_[0].right; cur != 0; cur = table_[cur].right) {
+        // One mem for the header in the table and one for its length in the grid.
+        DLX_STATS(stats_.mems += 2);
         if (grid_[cur].topOrLen < min) {
             chosenIndex = cur;
             min = grid_[cur].topOrLen;
@@ -119,26 +688,56 @@ int DisasterTags::chooseIsolatedCity() const {
     return chosenIndex;
 }
 
-std::string DisasterTags::coverCity(int indexInOption, const int supplyTag) {
+int DisasterTags::chooseConstrainedCity() const {
+    int min = INT_MAX;
+    int chosenIndex = 0;
+    for (int cur = table_[0].right; cur != 0; cur = table_[cur].right) {
+        // One mem for the header in the table and one for its count of useful options.
+        DLX_STATS(stats_.mems += 2);
+        if (usefulOptions_[cur] < min) {
+            chosenIndex = cur;
+            min = usefulOptions_[cur];
+            // No city can need fewer choices than the one option we try for this city.
+            if (!min) {
+                break;
+            }
+        }
+    }
+    return chosenIndex;
+}
+
+bool DisasterTags::isDominatedOption(int header, int indexInOption) const {
+    // Without forbidden options the first option in a column is the first the search tries.
+    return liveCities_[optionOf_[indexInOption]] == 1
+           && (usefulOptions_[header] || grid_[indexInOption].up != header);
+}
+
+int DisasterTags::coverCity(int indexInOption, const int supplyTag) {
     int i = indexInOption;
-    std::string result = "";
+    int result = 0;
     do {
         int top = grid_[i].topOrLen;
+        DLX_STATS(stats_.mems++);
         if (top <= 0) {
-            /* We are always guaranteed to pass the spacer tile so we will collect the name of the
-             * city we have chosen to supply to prove our algorithm chose correctly.
+            /* We are always guaranteed to pass the spacer tile so we will collect the option id of
+             * the city we have chosen to supply. Its name is only needed for the output.
             */
             i = grid_[i].up;
-            result = table_[std::abs(grid_[i - 1].topOrLen)].name;
+            result = -grid_[i - 1].topOrLen - 1;
+            DLX_STATS(stats_.mems++);
         } else {
             /* Cities are "tagged" at the recursive depth at which they were given supplies, the
              * number of supplies remaining when distributed. Only give supplies to cities that
              * are still in need and have not been tagged.
              */
+            DLX_STATS(stats_.mems++);
             if (!grid_[top].supplyTag) {
+                DLX_STATS(stats_.mems += 3; stats_.updates++);
                 grid_[top].supplyTag = supplyTag;
                 table_[table_[top].left].right = table_[top].right;
                 table_[table_[top].right].left = table_[top].left;
+                uncoveredKey_ ^= cityKeys_[top];
+                tagLiveCity(top);
             }
             grid_[i++].supplyTag = supplyTag;
         }
@@ -155,6 +754,7 @@ void DisasterTags::uncoverCity(int indexInOption) {
     int i = --indexInOption;
     do {
         int top = grid_[i].topOrLen;
+        DLX_STATS(stats_.mems++);
         if (top < 0) {
             i = grid_[i].down;
         } else {
@@ -163,28 +763,171 @@ void DisasterTags::uncoverCity(int indexInOption) {
              * O(1) check beats an up,down,left,right pointer implementation that needs to splice
              * from a left right doubly linked list for an entire column.
              */
+            DLX_STATS(stats_.mems++);
             if (grid_[top].supplyTag == grid_[i].supplyTag) {
+                DLX_STATS(stats_.mems += 3);
+                untagLiveCity(top);
                 grid_[top].supplyTag = 0;
                 table_[table_[top].left].right = top;
                 table_[table_[top].right].left = top;
+                uncoveredKey_ ^= cityKeys_[top];
             }
             grid_[i--].supplyTag = 0;
         }
     } while (i != indexInOption);
 }
 
+void DisasterTags::forbidOption(int indexInOption) {
+    // Rows are laid out contiguously so walk right, wrapping to the start of the row at the spacer.
+    int i = indexInOption + 1;
+    while (i != indexInOption) {
+        int top = grid_[i].topOrLen;
+        DLX_STATS(stats_.mems++);
+        if (top <= 0) {
+            i = grid_[i].up;
+        } else {
+            city cur = grid_[i];
+            grid_[cur.up].down = cur.down;
+            grid_[cur.down].up = cur.up;
+            grid_[top].topOrLen--;
+            DLX_STATS(stats_.mems += 3; stats_.updates++);
+            i++;
+        }
+    }
+}
+
+void DisasterTags::permitOption(int indexInOption) {
+    int i = indexInOption - 1;
+    while (i != indexInOption) {
+        int top = grid_[i].topOrLen;
+        DLX_STATS(stats_.mems++);
+        if (top <= 0) {
+            i = grid_[i].down;
+        } else {
+            city cur = grid_[i];
+            grid_[cur.up].down = i;
+            grid_[cur.down].up = i;
+            grid_[top].topOrLen++;
+            DLX_STATS(stats_.mems += 3);
+            i--;
+        }
+    }
+}
+
+
+/* * * * * * * * * * * * *     Hooks for the Parallel Search Driver      * * * * * * * * * * * * */
+
+
+bool DisasterTags::isSolved() const {
+    return table_[0].right == 0;
+}
+
+int DisasterTags::chooseItem() const {
+    return chooseIsolatedCity();
+}
+
+int DisasterTags::nextOption(int indexInOption) const {
+    return grid_[indexInOption].down;
+}
+
+int DisasterTags::coverOption(int indexInOption, int depthTag) {
+    return coverCity(indexInOption, depthTag);
+}
+
+void DisasterTags::uncoverOption(int indexInOption) {
+    uncoverCity(indexInOption);
+}
+
+bool DisasterTags::isPruned(int depthTag) {
+    // A set of cities we failed to cover before is skipped without touching the grid.
+    return nogoods_.isInfeasible(uncoveredKey_, depthTag) || isBeyondBounds(depthTag);
+}
+
+int DisasterTags::chooseOptions(std::vector<int>& options) {
+    int chosenIndex = chooseConstrainedCity();
+
+    /* Try to cover this city by first supplying the most connected city nearby. Try cities with
+     * successively fewer connections then if all else fails supply the isolated city itself.
+     */
+    int first = options.size();
+    rankOptions(chosenIndex, options);
+    int kept = first;
+    uint64_t node = ++nodeStamp_;
+    for (int k = first; k < (int)options.size(); k++) {
+        int cur = options[k];
+        if (isDominatedOption(chosenIndex, cur) || isSymmetricOption(cur, node)) {
+            continue;
+        }
+        // Every option listed before this one is searched in full before we reach it.
+        triedAt_[optionOf_[cur]] = node;
+        options[kept++] = cur;
+    }
+    options.resize(kept);
+    return chosenIndex;
+}
+
+SearchStats& DisasterTags::stats() const {
+    return stats_;
+}
+
+void DisasterTags::retireOption(int indexInOption) {
+    forbidOption(indexInOption);
+}
+
+void DisasterTags::restoreOption(int indexInOption) {
+    permitOption(indexInOption);
+}
+
 
 /* * * * * * * * * * *  Constructor and Building of Dancing Links Network   * * * * * * * * * * * */
 
 
 DisasterTags::DisasterTags(const std::map<std::string, std::set<std::string>>& roadNetwork)
+    : DisasterTags(NetworkGraph(roadNetwork)) {}
+
+DisasterTags::DisasterTags(const NetworkGraph& roadNetwork)
+    : DisasterTags(CoverNetwork(roadNetwork)) {}
+
+DisasterTags::DisasterTags(const CoverNetwork& roadNetwork)
     : table_(),
+      cityNames_(),
       grid_(),
-      numItemsAndOptions_(0) {
+      supplyNames_(),
+      numItemsAndOptions_(0),
+      optionOf_(),
+      liveCities_(),
+      optionsWithLive_(),
+      maxLive_(0),
+      numUncovered_(0),
+      usefulOptions_(),
+      optionOrder_(OptionOrder::MOST_CONNECTED),
+      packingStamp_(),
+      stamp_(0),
+      cuts_({0, 0}),
+      cityKeys_(),
+      uncoveredKey_(0),
+      nogoods_(),
+      budget_(),
+      incumbent_(),
+      cityImage_(),
+      rowImage_(),
+      rowPreimage_(),
+      isGroupComplete_(false),
+      uncoveredImageKeys_(),
+      rowKeys_(),
+      chosenKey_(0),
+      forbiddenKey_(0),
+      chosenImageKeys_(),
+      forbiddenImageKeys_(),
+      triedAt_(),
+      nodeStamp_(0),
+      coverCount_(),
+      stats_(),
+      workerNodes_() {
 
     // We will set this up for a reverse build of column links for a given item.
-    std::unordered_map<std::string,int> columnBuilder = {};
-    std::vector<std::pair<std::string,int>> connectionSizes = {};
+    std::vector<int> columnBuilder = {};
+    std::vector<std::pair<int,int>> connectionSizes = {};
 
     // We need to start preparing items in the grid immediately after the headers.
     initializeHeaders(roadNetwork, connectionSizes, columnBuilder);
@@ -193,30 +936,53 @@ DisasterTags::DisasterTags(const std::map<std::string, std::set<std::string>>& r
      * updated. We can hang on to helpful index info.
      */
     initializeItems(roadNetwork, connectionSizes, columnBuilder);
+
+    initializeBounds();
+
+    DisasterHeuristic heuristic(roadNetwork);
+    if (heuristic.isComplete()) {
+        incumbent_ = heuristic.getCover();
+    }
 }
 
-void DisasterTags::initializeHeaders(const std::map<std::string, std::set<std::string>>& roadNetwork,
-                                     std::vector<std::pair<std::string,int>>& connectionSizes,
-                                     std::unordered_map<std::string,int>& columnBuilder) {
-    table_.push_back({"", 0, 1});
+void DisasterTags::initializeHeaders(const CoverNetwork& roadNetwork,
+                                     std::vector<std::pair<int,int>>& connectionSizes,
+                                     std::vector<int>& columnBuilder) {
+    int numCities = roadNetwork.numItems();
+    int numOptions = roadNetwork.numOptions();
+    // Headers, then a spacer for each option, the cities each option covers, and a last spacer.
+    table_.reserve(numCities + 1);
+    cityNames_.reserve(numCities + 1);
+    grid_.reserve(numCities + numOptions + roadNetwork.numEntries() + 2);
+    connectionSizes.reserve(numOptions);
+    columnBuilder.reserve(numCities);
+    supplyNames_.reserve(numOptions);
+
+    table_.push_back({0, 1});
+    cityNames_.push_back("");
     grid_.push_back({0,0,0,0});
     int index = 1;
     // The first pass will set up the name headers and the column headers in the two vectors.
-    for (const auto& city : roadNetwork) {
-
-        // Add one to the connection size because we will add a city to its own connections later.
-        connectionSizes.push_back({city.first, roadNetwork.at(city.first).size() + 1});
+    for (int city = 0; city < numCities; city++) {
 
         // We need to set up multiple columns, so begin tracking the previous item for a column.
-        columnBuilder[city.first] = index;
+        columnBuilder.push_back(index);
 
-        table_.push_back({city.first, index - 1, index + 1});
+        table_.push_back({index - 1, index + 1});
+        cityNames_.push_back(roadNetwork.itemName(city));
         table_[0].left++;
         // Add the first headers for the item vector. They need count up and down.
         grid_.push_back({0, index, index,0});
         numItemsAndOptions_++;
         index++;
     }
+    for (int option = 0; option < numOptions; option++) {
+        supplyNames_.push_back(roadNetwork.optionName(option));
+        // An option that covers nothing can never help so it does not need a row.
+        if (roadNetwork.optionSize(option)) {
+            connectionSizes.push_back({option, roadNetwork.optionSize(option)});
+        }
+    }
 
     /* We want the most isolated cities to try to cover themselves by supplying adjacent neighbor
      * with the most other connections. This is not garunteed to work every time, but most times
@@ -230,66 +996,113 @@ void DisasterTags::initializeHeaders(const std::map<std::string, std::set<std::s
     table_[table_.size() - 1].right = 0;
 }
 
-void DisasterTags::initializeItems(const std::map<std::string, std::set<std::string>>& roadNetwork,
-                                   const std::vector<std::pair<std::string,int>>& connectionSizes,
-                                   std::unordered_map<std::string,int>& columnBuilder) {
+void DisasterTags::initializeItems(const CoverNetwork& roadNetwork,
+                                   const std::vector<std::pair<int,int>>& connectionSizes,
+                                   std::vector<int>& columnBuilder) {
     int previousSetSize = grid_.size();
     int index = grid_.size();
 
-    for (const auto& [city, connectionSize] : connectionSizes) {
-        // This algorithm includes a city in its own set of connections.
-        std::set<std::string> connections = roadNetwork.at(city);
-        connections.insert(city);
-        int setSize = connections.size();
-
-        /* We will know which supplying city option an item is in by the spacerTitle.
-         * lookupTable[abs(-grid_[columnBuilder[city]].down)] will give us the name of the option
-         * of that row. This accesses the last city in a column's down field to get the header.
+    for (const auto& [option, setSize] : connectionSizes) {
+        /* We will know which supplying city option an item is in by the spacerTitle. The option
+         * id is shifted by one so that every spacer is negative, even the spacer of option zero.
+         * In a network built from a graph this is the negative header index of the city supplied.
          */
-        grid_.push_back({-grid_[columnBuilder[city]].down,  // Negative index of city as option.
+        grid_.push_back({-(option + 1),                     // Negative id of the option plus one.
                          index - previousSetSize,           // First item in previous option
                          index + setSize,                   // Last item in current option
                          0});                               // Supply number tag.
 
         // Manage column pointers for items connected across options. Update index.
-        index = initializeColumns(connections, columnBuilder, index);
+        index = initializeColumns(roadNetwork, option, columnBuilder, index);
 
-        previousSetSize = connections.size();
+        previousSetSize = setSize;
     }
     grid_.push_back({INT_MIN, index - previousSetSize, INT_MIN,0});
 }
 
-int DisasterTags::initializeColumns(const std::set<std::string>& connections,
-                                     std::unordered_map<std::string,int>& columnBuilder,
-                                     int index) {
-    for (const auto& c : connections) {
-        // Circular lists give us access to header with down field of last city in a column.
-        grid_[grid_[columnBuilder[c]].down].topOrLen++;
-        index++;
+int DisasterTags::initializeColumns(const CoverNetwork& roadNetwork,
+                                    int option,
+                                    std::vector<int>& columnBuilder,
+                                    int index) {
+    // The cities of an option arrive sorted by id so the row stays in order of city id.
+    int end = roadNetwork.optionEnd(option);
+    for (int entry = roadNetwork.optionBegin(option); entry < end; entry++) {
+        appendToColumn(roadNetwork.item(entry), columnBuilder, ++index);
+    }
+    return ++index;
+}
 
-        // A single item in a circular doubly linked list points to itself.
-        grid_.push_back({grid_[columnBuilder[c]].down, index, index,0});
+void DisasterTags::appendToColumn(int city, std::vector<int>& columnBuilder, int index) {
+    // Circular lists give us access to header with down field of last city in a column.
+    grid_[grid_[columnBuilder[city]].down].topOrLen++;
 
-        /* Now we need to handle building the up and down pointers for a column of items.
-         * We also must make sure to keep the most recent element pointing down to the
-         * first of a column because this is circular. The first elem in the column must
-         * also point up to the most recently added element because this is circular.
-         */
+    // A single item in a circular doubly linked list points to itself.
+    grid_.push_back({grid_[columnBuilder[city]].down, index, index,0});
 
-        // This is the necessary adjustment to the column header's up field for a given item.
-        grid_[grid_[columnBuilder[c]].down].up = index;
+    /* Now we need to handle building the up and down pointers for a column of items.
+     * We also must make sure to keep the most recent element pointing down to the
+     * first of a column because this is circular. The first elem in the column must
+     * also point up to the most recently added element because this is circular.
+     */
 
-        // The current node is now the new tail in a vertical circular linked list for an item.
-        grid_[index].up = columnBuilder[c];
-        grid_[index].down = grid_[columnBuilder[c]].down;
+    // This is the necessary adjustment to the column header's up field for a given item.
+    grid_[grid_[columnBuilder[city]].down].up = index;
 
-        // Update the old tail to reflect the new addition of an item in its option.
-        grid_[columnBuilder[c]].down = index;
+    // The current node is now the new tail in a vertical circular linked list for an item.
+    grid_[index].up = columnBuilder[city];
+    grid_[index].down = grid_[columnBuilder[city]].down;
 
-        // Similar to a previous/current coding pattern but in an above/below column.
-        columnBuilder[c] = index;
+    // Update the old tail to reflect the new addition of an item in its option.
+    grid_[columnBuilder[city]].down = index;
+
+    // Similar to a previous/current coding pattern but in an above/below column.
+    columnBuilder[city] = index;
+}
+
+void DisasterTags::initializeBounds() {
+    optionOf_.assign(grid_.size(), -1);
+    // Options begin right after the headers and the final spacer belongs to no option.
+    int option = -1;
+    for (int i = numItemsAndOptions_ + 1; i < (int)grid_.size() - 1; i++) {
+        if (grid_[i].topOrLen <= 0) {
+            option++;
+            liveCities_.push_back(0);
+        } else {
+            liveCities_[option]++;
+        }
+        optionOf_[i] = option;
+    }
+    maxLive_ = 0;
+    for (int live : liveCities_) {
+        maxLive_ = std::max(maxLive_, live);
+    }
+    optionsWithLive_.assign(maxLive_ + 1, 0);
+    for (int live : liveCities_) {
+        optionsWithLive_[live]++;
+    }
+    numUncovered_ = numItemsAndOptions_;
+    // Every city starts uncovered so the hash of the whole network includes every key.
+    cityKeys_.assign(numItemsAndOptions_ + 1, 0);
+    for (int city = 1; city <= numItemsAndOptions_; city++) {
+        cityKeys_[city] = NogoodTable::itemKey(city);
+        uncoveredKey_ ^= cityKeys_[city];
+    }
+    packingStamp_.assign(liveCities_.size(), 0);
+    // Counting hashes the chosen and forbidden rows with keys past those of the cities.
+    rowKeys_.assign(liveCities_.size(), 0);
+    for (int row = 0; row < (int)liveCities_.size(); row++) {
+        rowKeys_[row] = NogoodTable::itemKey(numItemsAndOptions_ + 1 + row);
+    }
+    triedAt_.assign(liveCities_.size(), 0);
+    coverCount_.assign(numItemsAndOptions_ + 1, 0);
+    usefulOptions_.assign(numItemsAndOptions_ + 1, 0);
+    for (int city = 1; city <= numItemsAndOptions_; city++) {
+        for (int i = grid_[city].down; i != city; i = grid_[i].down) {
+            if (liveCities_[optionOf_[i]] > 1) {
+                usefulOptions_[city]++;
+            }
+        }
     }
-    return ++index;
 }
 
 } // namespace DancingLinks
@@ -9,12 +9,19 @@
  */
 #ifndef DISASTERTAGS_H
 #define DISASTERTAGS_H
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include "GUI/SimpleTest.h"
+#include "DisasterHeuristic.h"
+#include "NetworkGraph.h"
+#include "NogoodTable.h"
+#include "SearchLimits.h"
+#include "SearchStats.h"
+#include "SymmetryGroup.h"
 #include <set>
 #include <map>
-#include <unordered_map>
 
 namespace DancingLinks {
 
@@ -34,8 +41,25 @@ public:
      */
     explicit DisasterTags(const std::map<std::string, std::set<std::string>>& roadNetwork);
 
+    /**
+     * @brief DisasterTags   builds the grid by walking the arrays of a compact graph. Only the
+     *                       lookup table touches city names so no string is hashed or copied.
+     *                       The map constructor above simply builds this graph first.
+     * @param roadNetwork    the transportation grid as a graph of city ids.
+     */
+    explicit DisasterTags(const NetworkGraph& roadNetwork);
+
+    /**
+     * @brief DisasterTags   builds the grid from the cities that must be covered and the supply
+     *                       options that cover them. A graph is turned into one of these networks
+     *                       before building, but a reduced network may have fewer options than
+     *                       cities. Supplied options are reported by their option names.
+     * @param roadNetwork    the cities to cover and the cities each supply location covers.
+     */
+    explicit DisasterTags(const CoverNetwork& roadNetwork);
+
      /**
-     * @brief hasDisasterCoverage  performs a recursive search to determine if a transportation grid
+     * @brief hasDisasterCoverage  performs a search to determine if a transportation grid
      *                             can be covered with the specified number of emergency supplies.
      *                             Places the found cities in the output parameter if there
      *                             exists a solution. A city is covered if it has supplies or
@@ -47,6 +71,47 @@ public:
      */
     bool hasDisasterCoverage(int numSupplies, std::set<std::string>& supplyLocations);
 
+    /**
+     * @brief hasDisasterCoverage  performs the same search as above but shares the search
+     *                             tree among multiple threads. Each thread tags its own copy of the
+     *                             network, idle threads steal untried options from busy ones, and
+     *                             all threads stop once any of them finds a viable supply scheme.
+     *                             The cities found may differ from the serial search but will
+     *                             always cover the network.
+     * @param numSupplies          the limiting number of supplies we must distribute.
+     * @param supplyLocations      the output parameter telling which cities received supplies.
+     * @param numThreads           the number of threads to use. Zero or less uses all of them.
+     * @return                     true if we have found a viable supply scheme, false if not.
+     */
+    bool hasDisasterCoverage(int numSupplies, std::set<std::string>& supplyLocations, int numThreads);
+
+    /**
+     * @brief hasDisasterCoverage  performs the same search as above but gives up once any limit is
+     *                             reached. An aborted search untags every choice it made and tells
+     *                             us nothing about whether the network can be covered.
+     * @param numSupplies          the limiting number of supplies we must distribute.
+     * @param supplyLocations      the output parameter telling which cities received supplies.
+     * @param limits               the node, time, and cancellation limits for the search.
+     * @return                     FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+     */
+    SearchStatus hasDisasterCoverage(int numSupplies,
+                                     std::set<std::string>& supplyLocations,
+                                     const SearchLimits& limits);
+
+    /**
+     * @brief hasDisasterCoverage  performs the threaded search within the given limits. The node
+     *                             limit counts the nodes of every thread together.
+     * @param numSupplies          the limiting number of supplies we must distribute.
+     * @param supplyLocations      the output parameter telling which cities received supplies.
+     * @param numThreads           the number of threads to use. Zero or less uses all of them.
+     * @param limits               the node, time, and cancellation limits for the search.
+     * @return                     FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+     */
+    SearchStatus hasDisasterCoverage(int numSupplies,
+                                     std::set<std::string>& supplyLocations,
+                                     int numThreads,
+                                     const SearchLimits& limits);
+
     /**
      * @brief getAllDisasterConfigurations  returns every possible disaster configuration possible
      *                                      with a given supply count. I advise finding the optimal
@@ -57,6 +122,177 @@ public:
      */
     std::set<std::set<std::string>> getAllDisasterConfigurations(int numSupplies);
 
+    /**
+     * @brief findMinimumSupplies  finds the fewest supplies that can cover the transportation grid
+     *                             in a single branch and bound search. Every time we cover the
+     *                             grid we tighten the supply limit to one less than that cover, so
+     *                             we never repeat the failed searches of trying one limit at a time.
+     * @param suppliedCities       the output parameter holding the cities of an optimal cover.
+     * @return                     the minimum number of supplies needed to cover every city.
+     */
+    int findMinimumSupplies(std::set<std::string>& suppliedCities);
+
+    /**
+     * @brief findMinimumSupplies  performs the same search as above but gives up once any limit is
+     *                             reached. An aborted search still reports the smallest cover it
+     *                             found, which is never worse than the heuristic cover.
+     * @param suppliedCities       the output parameter holding the cities of the best cover found.
+     * @param limits               the node, time, and cancellation limits for the search.
+     * @return                     FOUND if the cover is proven optimal or ABORTED by a limit.
+     */
+    SearchStatus findMinimumSupplies(std::set<std::string>& suppliedCities,
+                                     const SearchLimits& limits);
+
+    /**
+     * @brief findApproximateSupplies  reports the cover the greedy and local search heuristic
+     *                                 found when the network was built. It needs no search at all
+     *                                 and is the cover findMinimumSupplies starts out trying to
+     *                                 beat, so it is often optimal but is never guaranteed to be.
+     * @param suppliedCities           the output parameter holding the cities of the cover.
+     * @return                         the number of supplies in the heuristic cover.
+     */
+    int findApproximateSupplies(std::set<std::string>& suppliedCities) const;
+
+    /**
+     * @brief getUniqueDisasterConfigurations  returns every disaster configuration possible with a
+     *                                         given supply count, generating each one exactly once.
+     *                                         Once we have tried every configuration that supplies
+     *                                         an option we forbid that option for its siblings, so
+     *                                         no set needs to filter out duplicates. At the optimal
+     *                                         supply count this finds exactly the configurations of
+     *                                         getAllDisasterConfigurations. With extra supplies both
+     *                                         find every configuration that wastes no supply but
+     *                                         may differ in which wasteful ones they include.
+     * @param numSupplies                      the number of supplies we have to distribute.
+     * @return                                 all possible distributions of the supplies.
+     */
+    std::vector<std::set<std::string>> getUniqueDisasterConfigurations(int numSupplies);
+
+    /**
+     * @brief countDisasterConfigurations  counts the configurations getUniqueDisasterConfigurations
+     *                                     would return with the same search, but only increments a
+     *                                     counter at every cover. No configuration is ever built so
+     *                                     we can count far more of them than would fit in memory.
+     * @param numSupplies                  the number of supplies we have to distribute.
+     * @return                             the number of distinct distributions of the supplies.
+     */
+    uint64_t countDisasterConfigurations(int numSupplies);
+
+    /**
+     * @brief countMinimalConfigurations  counts the configurations of at most the given supplies
+     *                                    from which no supply could be taken away. At the optimal
+     *                                    supply count every configuration is minimal, so this agrees
+     *                                    with countDisasterConfigurations. With symmetries we choose
+     *                                    the options of a city as a set and search one set of every
+     *                                    group of mirror images, counting it once for each image.
+     * @param numSupplies                 the number of supplies we have to distribute.
+     * @return                            the number of minimal distributions of the supplies.
+     */
+    uint64_t countMinimalConfigurations(int numSupplies);
+
+    /**
+     * @brief countMinimalConfigurations  performs the same count as above but gives up once any
+     *                                    limit is reached. An aborted count only tells us how many
+     *                                    configurations we reached before it stopped.
+     * @param numSupplies                 the number of supplies we have to distribute.
+     * @param count                       the output parameter holding the number we counted.
+     * @param limits                      the node, time, and cancellation limits for the count.
+     * @return                            FOUND with the full count or ABORTED by a limit.
+     */
+    SearchStatus countMinimalConfigurations(int numSupplies,
+                                            uint64_t& count,
+                                            const SearchLimits& limits);
+
+    /* A visitor sees every configuration the moment it is found as the option ids on the stack of
+     * supplies, valid only for the duration of the call. It returns true to keep searching.
+     */
+    using ConfigurationVisitor = std::function<bool(const std::vector<int>& supplies)>;
+
+    /**
+     * @brief visitDisasterConfigurations  runs the search of getUniqueDisasterConfigurations but
+     *                                     hands each configuration to a visitor instead of keeping
+     *                                     it. The visitor may stream, filter, or stop the search.
+     * @param numSupplies                  the number of supplies we have to distribute.
+     * @param visit                        the visitor called with the option ids of every cover.
+     * @return                             true if every configuration was visited, false if the
+     *                                     visitor stopped the search early.
+     */
+    bool visitDisasterConfigurations(int numSupplies, const ConfigurationVisitor& visit);
+
+    /**
+     * @brief getSupplyName  names the city holding an option id given to a visitor.
+     * @param option         the option id of a supplied city.
+     * @return               the name of the city receiving supplies.
+     */
+    const std::string& getSupplyName(int option) const;
+
+    /* The decision and minimum searches try the options covering a city in one of two orders. By
+     * default options that covered the most cities when the network was built come first. Deep in
+     * the search many of those cities are tagged, so we may instead rank the options at every node
+     * by the untagged cities each would cover now. Enumeration must try every option anyway so it
+     * always uses the order of the columns.
+     */
+    enum class OptionOrder {
+        MOST_CONNECTED,
+        MOST_UNCOVERED
+    };
+
+    /**
+     * @brief setOptionOrder  chooses the order in which later searches try the options of a city.
+     * @param order           MOST_CONNECTED to follow the columns or MOST_UNCOVERED to rank them.
+     */
+    void setOptionOrder(OptionOrder order);
+
+    /**
+     * @brief setSymmetries  lets later searches skip choices that mirror choices they have already
+     *                       tried. It is an error if the network was not built from a graph of the
+     *                       same cities or if any symmetry does not map the network onto itself.
+     * @param symmetries     the symmetries of the graph this network was built from.
+     */
+    void setSymmetries(const SymmetryGroup& symmetries);
+
+    /* Every node of the search checks two lower bounds on the supplies we still need. These are
+     * the number of nodes each bound cut from the tree during the last serial decision or minimum
+     * search, along with any counts of minimal configurations since. The threaded searches count
+     * in the copies their workers own and never report them.
+     */
+    struct BoundCuts {
+        long long optionSize;
+        long long packing;
+    };
+
+    /**
+     * @brief getBoundCuts  reports how many nodes each lower bound eliminated in the last search.
+     * @return              the cuts made by the largest option bound and the packing bound.
+     */
+    BoundCuts getBoundCuts() const;
+
+    /**
+     * @brief getNogoodStats  reports how often the last decision or minimum search found a set of
+     *                        uncovered cities it had already failed to cover.
+     * @return                the hits, misses, stores, and evictions of the table of nogoods.
+     */
+    NogoodTable::NogoodStats getNogoodStats() const;
+
+    /**
+     * @brief getSearchStats  reports the nodes, updates, mems, and solutions of every serial
+     *                        search since the last reset. Empty unless built with DLX_SEARCH_STATS.
+     * @return                the statistics Knuth keeps for his own dancing links programs.
+     */
+    const SearchStats& getSearchStats() const;
+
+    /**
+     * @brief resetSearchStats  clears the statistics so the next search is counted on its own.
+     */
+    void resetSearchStats();
+
+    /**
+     * @brief getWorkerNodes  reports how many nodes each thread entered in the last parallel search
+     *                        so callers can check how evenly work stealing spread the search.
+     * @return                the node count of each worker, empty before any parallel search.
+     */
+    const std::vector<long long>& getWorkerNodes() const;
+
 
 
 
@@ -79,8 +315,10 @@ private:
         int supplyTag;
     };
 
-    struct cityName {
-        std::string name;
+    /* The links of the cities we still need to cover. Choosing a city walks these at every node
+     * of the search, so the names of the cities are kept apart in cityNames_.
+     */
+    struct cityHeader {
         int left;
         int right;
     };
@@ -92,38 +330,200 @@ private:
     /* Use table to control recursion and know when all cities are safe. Table will be empty.
      * Grid contains cities as nodes. Cities apear as columns with appearances across rows.
      * Rows are the same cities but they indicate which other cities they cover if supplied.
-     * All cities apear as rows and columns so the grid is square.
+     * In a graph all cities apear as rows and columns so the grid is square. A reduced network may
+     * have fewer rows but never needs more supplies than there are columns, which we count here.
      */
-    std::vector<cityName> table_;
+    std::vector<cityHeader> table_;
+    // The name of the city at each header index. Only printing and debugging need these.
+    std::vector<std::string> cityNames_;
     std::vector<city> grid_;
+    // Spacers hold the negative option id plus one. This is the name we report for each option.
+    std::vector<std::string> supplyNames_;
     int numItemsAndOptions_;
 
+    /* We bound the search by how many untagged cities the best remaining option could still cover.
+     * Every grid index knows the option it belongs to and every option knows how many of its
+     * cities are untagged. Options are counted by that number so the largest is always at hand.
+     */
+    std::vector<int> optionOf_;
+    std::vector<int> liveCities_;
+    std::vector<int> optionsWithLive_;
+    int maxLive_;
+    int numUncovered_;
+    /* Columns never shrink as cities are tagged, so their lengths say little deep in the search.
+     * An option whose only untagged city is the one we must cover is no better than any other
+     * option covering that city. We count the options of each city that reach another untagged
+     * city, updated with the live counts above when a supply tags or untags a city.
+     */
+    std::vector<int> usefulOptions_;
+    // The order rankOptions lists the options of the chosen city in. The stack keeps the lists.
+    OptionOrder optionOrder_;
+    // A packing marks every option that covers a packed city. Stamps save us from clearing marks.
+    std::vector<int> packingStamp_;
+    int stamp_;
+    BoundCuts cuts_;
+    /* The Zobrist hash of the uncovered cities names the sub-problem at every node. Failed nodes
+     * of the decision and minimum searches are remembered so other orders of the same choices
+     * skip them. Enumeration forbids options as it goes so it only reads the table and never
+     * writes to it.
+     */
+    std::vector<uint64_t> cityKeys_;
+    uint64_t uncoveredKey_;
+    NogoodTable nogoods_;
+    // The decision, minimum, and minimal counting searches spend this budget to be bounded.
+    SearchBudget budget_;
+    // The heuristic cover of the network as option ids. Empty if some city can not be covered.
+    std::vector<int> incumbent_;
+    /* The symmetries of the network other than the identity as the image of every header and of
+     * every row, along with the row each row is the image of. We hash the image of the uncovered
+     * cities under every symmetry next to uncoveredKey_. A symmetry with a matching hash fixes the
+     * uncovered cities, and cities we fail to cover fail in every image. Counting also hashes the
+     * options chosen and forbidden on the way to a node and their images.
+     */
+    std::vector<std::vector<int>> cityImage_;
+    std::vector<std::vector<int>> rowImage_;
+    std::vector<std::vector<int>> rowPreimage_;
+    bool isGroupComplete_;
+    std::vector<uint64_t> uncoveredImageKeys_;
+    std::vector<uint64_t> rowKeys_;
+    uint64_t chosenKey_;
+    uint64_t forbiddenKey_;
+    std::vector<uint64_t> chosenImageKeys_;
+    std::vector<uint64_t> forbiddenImageKeys_;
+    // The node at which we last listed or tried each row. Every node of the decision and minimum
+    // searches takes a new stamp so marks left by other nodes never match.
+    std::vector<uint64_t> triedAt_;
+    uint64_t nodeStamp_;
+    // How many options of a configuration cover each city, to check that it is minimal.
+    std::vector<int> coverCount_;
+    // Choosing a city only reads the grid but still spends mems, so the counts may always change.
+    mutable SearchStats stats_;
+    // The nodes each thread entered in the last parallel search, to check the load balance.
+    std::vector<long long> workerNodes_;
+
+
+    /**
+     * @brief countMinimalCovers  counts the minimal configurations that supply every option on the
+     *                            stack. Like the unique enumerations we forbid every option once we
+     *                            have counted the configurations that supply it. Every node we
+     *                            choose at spends the budget and an aborted count stops branching.
+     * @param numSupplies         the number of supplies we have left to distribute.
+     * @param chosen              the stack of the grid indices of the options we supplied.
+     * @return                    the number of minimal configurations, images included.
+     */
+    uint64_t countMinimalCovers(int numSupplies, std::vector<int>& chosen);
+
+    /**
+     * @brief countSymmetricSubsets  counts the minimal configurations below a node by the set of
+     *                               options of the chosen city they supply. We supply every option
+     *                               in a set and forbid the rest. Symmetries that fix the options
+     *                               chosen and forbidden so far and the column map each set onto
+     *                               its images, so we count only the least set of every group of
+     *                               images and weigh it by the size of the group.
+     * @param chosenIndex            the header of the city we chose to cover.
+     * @param numSupplies            the number of supplies we have left to distribute.
+     * @param chosen                 the stack of the grid indices of the options we supplied.
+     * @param count                  the output parameter holding the number of configurations.
+     * @return                       false if no symmetry helps here and we should branch as usual.
+     */
+    bool countSymmetricSubsets(int chosenIndex,
+                               int numSupplies,
+                               std::vector<int>& chosen,
+                               uint64_t& count);
+
+    /**
+     * @brief isMinimalCover  checks that every option we supplied covers a city no other covers.
+     * @param chosen          the grid indices of the options we supplied.
+     * @return                true if no supply could be taken away.
+     */
+    bool isMinimalCover(const std::vector<int>& chosen);
+
+    /**
+     * @brief toggleChosen  adds or removes a row from the hashes of the chosen options.
+     * @param row           the row of the option we supplied or took away.
+     */
+    void toggleChosen(int row);
+
+    /**
+     * @brief toggleForbidden  adds or removes a row from the hashes of the forbidden options.
+     * @param row              the row of the option we forbade or permitted.
+     */
+    void toggleForbidden(int row);
+
+    /**
+     * @brief isSymmetricOption  checks if a symmetry that fixes the uncovered cities maps an option
+     *                           we fully searched at this node onto this option. Every cover using
+     *                           this option has an image of the same size that uses the other.
+     * @param indexInOption      the index of the chosen city in the option we might supply.
+     * @param node               the stamp of the node we are searching.
+     * @return                   true if we may skip supplying this option.
+     */
+    bool isSymmetricOption(int indexInOption, uint64_t node) const;
+
+    /**
+     * @brief recordNogood  remembers that the uncovered cities can not be covered with the supplies
+     *                      we have, along with every image of them under the symmetries.
+     * @param numSupplies   the supplies that were not enough.
+     */
+    void recordNogood(int numSupplies);
+
+    /**
+     * @brief isBeyondBounds  checks if the remaining untagged cities certainly need more supplies
+     *                        than we have left. Any one option covers at most as many untagged
+     *                        cities as the largest option. Any group of untagged cities no two of
+     *                        which share an option needs a supply for each city in the group.
+     * @param numSupplies     the number of supplies we have left to distribute.
+     * @return                true if either bound exceeds our supplies and we may stop searching.
+     */
+    bool isBeyondBounds(int numSupplies);
+
+    /**
+     * @brief packCities   greedily gathers untagged cities such that no option covers two of
+     *                     them. We stop early as soon as we have packed more than the limit.
+     * @param limit        the number of supplies we have. Packing more cities proves failure.
+     * @return             the number of cities we packed.
+     */
+    int packCities(int limit);
+
+    /**
+     * @brief rankOptions  appends the options covering the chosen city to a list. If we rank them,
+     *                     options covering the most untagged cities come first and ties keep the
+     *                     order of the column. The options already in the list are not touched.
+     * @param header       the header of the city we chose to cover.
+     * @param ranked       the list of options for every node on our path. We add this node's.
+     */
+    void rankOptions(int header, std::vector<int>& ranked);
 
     /**
-     * @brief isDLXCovered     performs an in-place recursive search on a dancing links data
-     *                         structure to determine if a transportation grid is safe with the
-     *                         given number of supplies. A city is safe if it has supplies or is
-     *                         adjacent to a city with supplies. All cities are tagged with the
-     *                         supply number that has covered them either by being next to a city
-     *                         with that supply number or holding the supply themselves.
-     * @param numSupplies      the depth or our recursive search. How many supplies we can give out.
-     * @param supplyLocations  the output parameter upon successfull coverage. Empty if we fail.
-     * @return                 true if we can cover the grid with the given supplies, false if not.
+     * @brief tagLiveCity  records that every option covering a newly tagged city has one less
+     *                     untagged city it could cover.
+     * @param header       the column header of the city we just tagged.
      */
-    bool isDLXCovered(int numSupplies, std::set<std::string>& supplyLocations);
+    void tagLiveCity(int header);
 
     /**
-     * @brief fillConfigurations  finds all possible distributions of the given number of supplies.
-     *                            It generates duplicate configurations and uses a std::set to filter
-     *                            them out. This is slow and I want to only generate unique
-     *                            configurations but am having trouble finding a way.
-     * @param numSupplies         the number of supplies we have to distribute.
-     * @param suppliedCities      the set that will hold new configurations that work.
-     * @param allConfigurations   the set that records all configurations found.
+     * @brief untagLiveCity  records that every option covering a city we untagged has one more
+     *                       untagged city it could cover.
+     * @param header         the column header of the city we just untagged.
      */
-    void fillConfigurations(int numSupplies,
-                              std::set<std::string>& suppliedCities,
-                              std::set<std::set<std::string>>& allConfigurations);
+    void untagLiveCity(int header);
+
+    /**
+     * @brief findLiveCity   finds the one untagged city left in an option that now covers just one.
+     * @param indexInOption  the index of any city in the option.
+     * @return               the column header of the untagged city in the option.
+     */
+    int findLiveCity(int indexInOption) const;
+
+    /**
+     * @brief nameSupplies     resolves the options on a stack of supplies to the names of the cities
+     *                         holding them. The search only deals in indices so this is the one
+     *                         place names are touched, once per cover we report.
+     * @param supplies         the option ids of the cities we supplied.
+     * @param suppliedCities   the output parameter to which we add the names of supplied cities.
+     */
+    void nameSupplies(const std::vector<int>& supplies,
+                      std::set<std::string>& suppliedCities) const;
 
     /**
      * @brief chooseIsolatedCity  selects a city we are trying to cover either by giving it supplies
@@ -138,6 +538,27 @@ private:
      */
     int chooseIsolatedCity() const;
 
+    /**
+     * @brief chooseConstrainedCity  selects the city with the fewest options that reach another
+     *                               untagged city. A city with none must spend a supply on itself
+     *                               alone, so any one of its options will do and we stop looking.
+     *                               Only the decision and minimum searches use this choice because
+     *                               enumeration must try every option to find every configuration.
+     * @return                       the index of the city we are selecting to attempt to cover.
+     */
+    int chooseConstrainedCity() const;
+
+    /**
+     * @brief isDominatedOption  checks if an option covers no untagged city but the chosen one. We
+     *                           try the first such option only if no option of the city covers
+     *                           more. Any cover supplying a skipped option is no larger with the
+     *                           option we try in its place.
+     * @param header             the column header of the city we chose to cover.
+     * @param indexInOption      the index of the chosen city in the option we might supply.
+     * @return                   true if we may skip supplying this option.
+     */
+    bool isDominatedOption(int header, int indexInOption) const;
+
     /**
      * @brief coverCity      covers a city wit supplies and all of its neighbors. All cities tagged
      *                       with a supply number equivalent to the current depth of the recursive
@@ -145,9 +566,9 @@ private:
      *                       exact supply did not work out and it must be removed later.
      * @param indexInOption  the index for the current city we are trying to cover.
      * @param supplyTag      uses number of supplies remaining as a unique tag for recursive depth.
-     * @return               the name of the city holding the supplies.
+     * @return               the option id of the city holding the supplies.
      */
-    std::string coverCity(int indexInOption, const int supplyTag);
+    int coverCity(int indexInOption, const int supplyTag);
 
     /**
      * @brief uncoverCity    uncovers a city if that choice of option did not lead to a covered
@@ -158,6 +579,64 @@ private:
      */
     void uncoverCity(int indexInOption);
 
+    /**
+     * @brief forbidOption   removes an option from every column in which it appears so it may not
+     *                       be chosen to cover any other city. Supply tags never change the columns
+     *                       so this is the only time a city leaves a column. The column of the city
+     *                       we chose to cover is left alone because we are traversing it.
+     * @param indexInOption  the index of the chosen city in the option we forbid.
+     */
+    void forbidOption(int indexInOption);
+
+    /**
+     * @brief permitOption   restores an option to every column from which it was forbidden. Options
+     *                       must be permitted in the reverse order they were forbidden.
+     * @param indexInOption  the index of the chosen city in the option we permit.
+     */
+    void permitOption(int indexInOption);
+
+
+    /* * * * * * * * * *    Hooks for the Parallel Search Driver        * * * * * * * * * * * * * */
+
+
+    /* The IterativeSearch stack steps every search of this network, ParallelSearch, and the
+     * generators, except for countMinimalConfigurations. The depth tag it passes along is the
+     * supply number we tag an option with when we cover it, which is also the number of supplies
+     * left at the node. A search that decides prunes with our bounds and nogoods, tries the options
+     * we rank, and hands back failed nodes to recordNogood. Enumeration walks the column of
+     * chooseItem so that it finds every cover.
+     */
+
+    bool isSolved() const;
+    int chooseItem() const;
+    int nextOption(int indexInOption) const;
+    int coverOption(int indexInOption, int depthTag);
+    void uncoverOption(int indexInOption);
+    bool isPruned(int depthTag);
+    SearchStats& stats() const;
+
+    /**
+     * @brief chooseOptions  chooses the most constrained city and appends the options we try to
+     *                       cover it. Dominated options and the images of options already listed
+     *                       are left out, and every option listed is marked tried at a new node.
+     * @param options        the list of options for every node on the path. We add this node's.
+     * @return               the city we chose, or zero if every city is covered.
+     */
+    int chooseOptions(std::vector<int>& options);
+    // The SolutionGenerator also retires options it has exhausted so no solution repeats.
+    void retireOption(int indexInOption);
+    void restoreOption(int indexInOption);
+
+    /**
+     * @brief withHooks  runs a step of the IterativeSearch stack. This network is its own hooks.
+     * @param step       the step to run given the hooks it should use.
+     * @return           whatever the step returns.
+     */
+    template <typename Step>
+    auto withHooks(const Step& step) -> decltype(step(*this)) {
+        return step(*this);
+    }
+
 
     /* * * * * * * * * *    Constructors for Dancing Links Building     * * * * * * * * * * * * * */
 
@@ -165,43 +644,60 @@ private:
     /**
      * @brief initializeHeaders  creates the lookup table of city names and the first row of headers
      *                           that are in the dancing links array. This is the first pass on the
-     *                           input map. We will perform a second, much longer pass to build the
+     *                           graph. We will perform a second, much longer pass to build the
      *                           columns later.
-     * @param roadNetwork        the input of cities connected to other cities.
-     * @param connectionSizes    a city and the size of the set of adjacent cities.
-     * @param columnBuilder      the hash map we will use to connect newly added items to a column.
+     * @param roadNetwork        the cities to cover and the cities each option covers.
+     * @param connectionSizes    an option id and the number of cities it covers.
+     * @param columnBuilder      the last index of each city's column so far, indexed by city id.
      */
-    void initializeHeaders(const std::map<std::string, std::set<std::string>>& roadNetwork,
-                             std::vector<std::pair<std::string,int>>& connectionSizes,
-                             std::unordered_map<std::string,int>& columnBuilder);
+    void initializeHeaders(const CoverNetwork& roadNetwork,
+                           std::vector<std::pair<int,int>>& connectionSizes,
+                           std::vector<int>& columnBuilder);
 
     /**
      * @brief initializeItems  builds the structure needed to perform the dancing links algorithm.
      *                         This focusses on setting up the grid in the dancing Network struct
      *                         so that all item columns are tallied correctly and the option rows
      *                         represent all the cities that a supply city can cover, self included.
-     * @param roadNetwork      we need to look back at the original map to grab sets to build.
+     * @param roadNetwork      we need to look back at the network to grab the cities to build.
      * @param connectionSizes  we organize rows in descending order top to bottom as a heuristic.
-     * @param columnBuilder    the map we use to help build an accurate column for each city item.
-     * @param index            we are passed in a starting index to begin building
+     * @param columnBuilder    the last index of each city's column so far, indexed by city id.
      */
-    void initializeItems(const std::map<std::string, std::set<std::string>>& roadNetwork,
-                          const std::vector<std::pair<std::string,int>>& connectionSizes,
-                          std::unordered_map<std::string,int>& columnBuilder);
+    void initializeItems(const CoverNetwork& roadNetwork,
+                         const std::vector<std::pair<int,int>>& connectionSizes,
+                         std::vector<int>& columnBuilder);
 
     /**
      * @brief initializeColumns  this is the set builder for each row. When a city is given supplies
      *                           it is connected to itself and its adjacent cities. We represent
      *                           this in a row and connect each item to any appearance in a previous
-     *                           row so that each column is built.
-     * @param connections        the set containing the city and all adjacent connections.
-     * @param columnBuilder      the map we use to track the last appearance of an item in a column.
+     *                           row so that each column is built. The cities of an option are
+     *                           sorted so the row stays in order of city id.
+     * @param roadNetwork        the network holding the cities each option covers.
+     * @param option             the id of the option whose row we are building.
+     * @param columnBuilder      the last index of each city's column so far, indexed by city id.
      * @param index              the index of the array at which we start building.
      * @return                   the new index of the grid after adding all items in a row.
      */
-    int initializeColumns(const std::set<std::string>& connections,
-                            std::unordered_map<std::string,int>& columnBuilder,
-                            int index);
+    int initializeColumns(const CoverNetwork& roadNetwork,
+                          int option,
+                          std::vector<int>& columnBuilder,
+                          int index);
+
+    /**
+     * @brief appendToColumn  adds one item to the bottom of a city's column at the end of the grid.
+     * @param city            the id of the city we add to its column.
+     * @param columnBuilder   the last index of each city's column so far, indexed by city id.
+     * @param index           the index of the grid at which the new item is placed.
+     */
+    void appendToColumn(int city, std::vector<int>& columnBuilder, int index);
+
+    /**
+     * @brief initializeBounds  records the option of every grid index and the number of cities
+     *                          each option covers so we can bound the search. Call after the grid
+     *                          is complete.
+     */
+    void initializeBounds();
 
 
     /* * * * * * * * * * * * *  Overloaded Debugging Operators  * * * * * * * * * * * * * * * * * */
@@ -209,13 +705,16 @@ private:
 
     friend bool operator==(const city& lhs, const city& rhs);
     friend bool operator!=(const city& lhs, const city& rhs);
-    friend bool operator==(const cityName& lhs, const cityName& rhs);
-    friend bool operator!=(const cityName& lhs, const cityName& rhs);
+    friend bool operator==(const cityHeader& lhs, const cityHeader& rhs);
+    friend bool operator!=(const cityHeader& lhs, const cityHeader& rhs);
     friend std::ostream& operator<<(std::ostream& os, const city& city);
-    friend std::ostream& operator<<(std::ostream& os, const cityName& city);
+    friend std::ostream& operator<<(std::ostream& os, const cityHeader& city);
     friend std::ostream& operator<<(std::ostream& os, const std::vector<city>& grid);
-    friend std::ostream& operator<<(std::ostream& os, const std::vector<cityName>& links);
+    friend std::ostream& operator<<(std::ostream& os, const std::vector<cityHeader>& links);
     friend std::ostream& operator<<(std::ostream& os, const DisasterTags& network);
+    template <typename Links, typename Option> friend class IterativeSearch;
+    template <typename Links, typename Option> friend class ParallelSearch;
+    template <typename Links, typename Option> friend class SolutionGenerator;
     ALLOW_TEST_ACCESS();
 };
 
@@ -0,0 +1,416 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: IterativeSearch.h
+ * --------------------------
+ * This file contains the explicit stack that drives a cover search over the DisasterLinks,
+ * DisasterTags, and PartnerLinks classes without recursion. A recursive search keeps its place in
+ * the call stack, so it can not be paused part way, handed to another thread, or saved. Here the
+ * place of a search is a plain stack of frames, one for every option chosen. A frame remembers the
+ * item we are covering and the options we try for it in the order we try them. The decision,
+ * minimum, and enumeration searches of all three solvers, the SolutionGenerator, and the workers
+ * of ParallelSearch all step their search with this stack, so one loop carries the pruning for
+ * every one of them.
+ *
+ *      - findCover stops at the first cover. It is how the solvers decide if a cover exists.
+ *      - improveCover keeps every cover smaller than the best so far, lowering the depth limit to
+ *        one below each cover it finds. It is how the solvers find a minimum cover.
+ *      - visitCovers reports the covers of a stack that enumerates. A UNIQUE stack retires an
+ *        option for its siblings once every cover beneath it has been seen, so no cover repeats.
+ *        An EVERY_PATH stack retires nothing and reports a cover once for every path reaching it.
+ *      - A task of ParallelSearch covers its path with enter, may begin with one frame of a range
+ *        of options, and undoes everything with leave.
+ *
+ * Before we choose at a node the solver may cut it with its bounds and nogoods. A stack that
+ * decides then lets the solver list the options of the item it chooses in its own order, leaving
+ * out any option it can prove redundant, and hands every node whose options all failed back to the
+ * solver as a nogood. A stack that enumerates must report every cover in the order the solvers
+ * always have, so it walks the whole column of the item the solver chooses. Its failures prove
+ * nothing once options are retired, so it records no nogoods. The options of a frame are copied
+ * onto one shared stack when the frame opens, so covering never disturbs the options left to try.
+ *
+ * The frames are reserved up to the depth limit once and reused by every search, so they rarely
+ * grow while we search. The stack holds no reference to a solver and every step is given the
+ * hooks of the solver it works on, which lets a generator and its copy of the solver be copied
+ * together. The hooks are reached through withHooks, which hands a whole run of steps one object
+ * holding them. DisasterLinks binds its hooks to the width of the grid it built, while the other
+ * solvers simply hand over themselves. A solver must befriend this class and provide the hooks
+ * listed in ParallelSearch.h, along with retireOption and restoreOption if covers are visited.
+ *
+ * The max weight matching of PartnerLinks branches on leaving a person out as well as on their
+ * pairings, so it keeps its own stack with a frame for each kind of branch. The bitset search of
+ * DisasterBits and the orbit counting of DisasterTags::countMinimalConfigurations still recurse.
+ */
+#ifndef ITERATIVESEARCH_H
+#define ITERATIVESEARCH_H
+#include <algorithm>
+#include <vector>
+#include "SearchLimits.h"
+#include "SearchStats.h"
+
+namespace DancingLinks {
+
+/* A stack that decides may list fewer options than a column holds and records nogoods. A stack
+ * that enumerates walks every column in full and either retires exhausted options or does not.
+ */
+enum class SearchMode {
+    DECIDE,
+    UNIQUE,
+    EVERY_PATH
+};
+
+template <typename Links, typename Option>
+class IterativeSearch {
+
+public:
+
+
+    /* The options of a frame sit on the options stack from begin up to end and cur is the one we
+     * are trying now. The options this frame has retired sit on the retired stack from the given
+     * mark to the top. Only a whole frame that runs out of options proves its node has no cover. A
+     * frame that was given part of a node by another worker, or that gave part away, is not whole.
+     */
+    struct Frame {
+        int item;
+        int begin;
+        int cur;
+        int end;
+        int retiredMark;
+        bool isWhole;
+    };
+
+    /**
+     * @brief IterativeSearch  prepares an empty stack for searches of the given depth.
+     * @param depthLimit       the limit on how many options a cover may choose.
+     * @param mode             whether the stack decides, enumerates unique covers, or enumerates
+     *                         every path to a cover.
+     */
+    IterativeSearch(int depthLimit, SearchMode mode)
+        : depthLimit_(depthLimit),
+          mode_(mode),
+          pathSize_(0),
+          frames_(),
+          options_(),
+          chosen_(),
+          retired_() {
+        // A perfect matching may be given every person as its limit so keep the reservation sane.
+        int reserved = depthLimit < MAX_RESERVED_DEPTH ? depthLimit : MAX_RESERVED_DEPTH;
+        frames_.reserve(std::max(0, reserved));
+        chosen_.reserve(std::max(0, reserved));
+    }
+
+    /**
+     * @brief findCover  searches for the first cover with the stack. The solver is left as it was.
+     * @param links      the solver we search.
+     * @param cover      the output parameter holding the options of the cover in the order chosen.
+     * @return           true if a cover was found, false if no cover exists within the limit.
+     */
+    bool findCover(Links& links, std::vector<Option>& cover) {
+        SearchBudget unlimited;
+        return findCover(links, cover, unlimited);
+    }
+
+    /**
+     * @brief findCover  performs the same search but stops once the budget is spent. A search that
+     *                   stops unwinds every choice it made and records no nogoods on the way out.
+     * @param links      the solver we search.
+     * @param cover      the output parameter holding the options of the cover in the order chosen.
+     * @param budget     the limits on the search. Ask it if it aborted to tell a stop from a fail.
+     * @return           true if a cover was found, false if none exists or the budget ran out.
+     */
+    bool findCover(Links& links, std::vector<Option>& cover, SearchBudget& budget) {
+        return links.withHooks([&](auto& hooks) {
+            for (;;) {
+                DLX_STATS(hooks.stats().enterNode(depth()));
+                if (hooks.isSolved()) {
+                    DLX_STATS(hooks.stats().solutions++);
+                    cover = chosen_;
+                    unwind(hooks);
+                    return true;
+                }
+                // Only a node where we could still choose an option spends the budget.
+                if (depth() < depthLimit_ && budget.isSpent()) {
+                    unwind(hooks);
+                    return false;
+                }
+                if (!descend(hooks) && !advance(hooks)) {
+                    return false;
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief improveCover  searches for a cover smaller than the best one so far. Every cover we
+     *                      find becomes the best, and the depth limit drops to one below it, so
+     *                      frames too deep for the new limit try no more options. The frames above
+     *                      a cover searched their node under the old limit so none become nogoods.
+     *                      Requires a stack that decides.
+     * @param links         the solver we search.
+     * @param best          the best cover so far, replaced by every smaller cover we find. The
+     *                      depth limit of the stack must be one less than the size of this cover.
+     * @param budget        the limits on the search. Ask it if it aborted to tell a stop from a
+     *                      fail.
+     * @return              true if the search ran to the end, false if the budget ran out.
+     */
+    bool improveCover(Links& links, std::vector<Option>& best, SearchBudget& budget) {
+        return links.withHooks([&](auto& hooks) {
+            for (;;) {
+                DLX_STATS(hooks.stats().enterNode(depth()));
+                if (hooks.isSolved()) {
+                    DLX_STATS(hooks.stats().solutions++);
+                    // We only choose options while we can beat the best so this cover is better.
+                    best = chosen_;
+                    depthLimit_ = depth() - 1;
+                    for (Frame& frame : frames_) {
+                        frame.isWhole = false;
+                    }
+                    if (!advance(hooks)) {
+                        return true;
+                    }
+                    continue;
+                }
+                if (depth() < depthLimit_ && budget.isSpent()) {
+                    unwind(hooks);
+                    return false;
+                }
+                if (!descend(hooks) && !advance(hooks)) {
+                    return true;
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief visitCovers  reports every cover in the order the enumerations of the solvers
+     *                     always have. Requires a stack that enumerates.
+     * @param links        the solver we search.
+     * @param visit        called with the options chosen at every cover. False stops the search.
+     * @return             true if the search ran to the end, false if it was stopped.
+     */
+    template <typename Visit>
+    bool visitCovers(Links& links, const Visit& visit) {
+        return links.withHooks([&](auto& hooks) {
+            for (;;) {
+                DLX_STATS(hooks.stats().enterNode(depth()));
+                if (hooks.isSolved()) {
+                    DLX_STATS(hooks.stats().solutions++);
+                    if (!visit(chosen_)) {
+                        unwind(hooks);
+                        return false;
+                    }
+                    if (!advance(hooks)) {
+                        return true;
+                    }
+                    continue;
+                }
+                if (!descend(hooks) && !advance(hooks)) {
+                    return true;
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief enter  covers the options of a path from the root before the frames of a task. They
+     *               count toward the depth and stay chosen until leave.
+     * @param hooks  the hooks of the solver we search.
+     * @param path   the options chosen from the root to the node where the task begins.
+     */
+    template <typename Hooks>
+    void enter(Hooks& hooks, const std::vector<int>& path) {
+        for (int depth = 0; depth < (int)path.size(); depth++) {
+            chosen_.push_back(hooks.coverOption(path[depth], depthLimit_ - depth));
+        }
+        pathSize_ = path.size();
+    }
+
+    /**
+     * @brief leave  undoes every frame and then the path given to enter.
+     * @param hooks  the hooks of the solver we search.
+     * @param path   the same path given to enter.
+     */
+    template <typename Hooks>
+    void leave(Hooks& hooks, const std::vector<int>& path) {
+        unwind(hooks);
+        for (int depth = path.size() - 1; depth >= 0; depth--) {
+            hooks.uncoverOption(path[depth]);
+            chosen_.pop_back();
+        }
+        pathSize_ = 0;
+    }
+
+    /**
+     * @brief descend  chooses an item at the current node and covers its first option in a new
+     *                 frame. Nothing happens at the depth limit, when the solver prunes the node,
+     *                 or when the item has no options left to try.
+     * @param hooks    the hooks of the solver we search.
+     * @return         true if we moved deeper, false if this node has nothing to try.
+     */
+    template <typename Hooks>
+    bool descend(Hooks& hooks) {
+        int depthTag = depthLimit_ - depth();
+        if (depthTag <= 0 || hooks.isPruned(depthTag)) {
+            return false;
+        }
+        int begin = options_.size();
+        int item = 0;
+        if (mode_ != SearchMode::DECIDE) {
+            item = hooks.chooseItem();
+            for (int i = item > 0 ? hooks.nextOption(item) : item; i != item;
+                    i = hooks.nextOption(i)) {
+                options_.push_back(i);
+            }
+        } else {
+            item = hooks.chooseOptions(options_);
+            // Every option of the item was redundant so the node is refuted without a cover.
+            if (item > 0 && (int)options_.size() == begin) {
+                hooks.recordNogood(depthTag);
+            }
+        }
+        if (item <= 0 || (int)options_.size() == begin) {
+            options_.resize(begin);
+            return false;
+        }
+        openFrame(hooks, {item, begin, begin, (int)options_.size(), (int)retired_.size(), true});
+        return true;
+    }
+
+    /**
+     * @brief pushFrame  covers the first of a range of options for an item in a new frame. The
+     *                   options of the node are listed again, just as the worker that gave the
+     *                   range away listed them, and only the given range of that list is tried.
+     * @param hooks      the hooks of the solver we search.
+     * @param item       the item the options cover.
+     * @param start      the position in the list of the first option we try.
+     * @param end        the position in the list at which we stop.
+     */
+    template <typename Hooks>
+    void pushFrame(Hooks& hooks, int item, int start, int end) {
+        int begin = options_.size();
+        hooks.chooseOptions(options_);
+        openFrame(hooks, {item, begin, begin + start, begin + end, (int)retired_.size(), false});
+    }
+
+    /**
+     * @brief advance  backs out of the deepest option and covers the next untried option of the
+     *                 deepest frame that has one within the depth limit. Frames with nothing left
+     *                 are popped and the options they retired are restored. A whole frame of a
+     *                 stack that decides leaves its node behind as a nogood when it is popped.
+     * @param hooks    the hooks of the solver we search.
+     * @return         true if we moved to a new option, false if every frame is exhausted.
+     */
+    template <typename Hooks>
+    bool advance(Hooks& hooks) {
+        while (!frames_.empty()) {
+            Frame& top = frames_.back();
+            int option = options_[top.cur];
+            hooks.uncoverOption(option);
+            chosen_.pop_back();
+            if (mode_ == SearchMode::UNIQUE) {
+                // Every cover with this option has been seen. Siblings may not use it.
+                hooks.retireOption(option);
+                retired_.push_back(option);
+            }
+            // Only improveCover lowers the limit, so only its frames may end before their options.
+            if (++top.cur != top.end && depth() <= depthLimit_) {
+                chosen_.push_back(hooks.coverOption(options_[top.cur], depthLimit_ - depth() + 1));
+                return true;
+            }
+            while ((int)retired_.size() > top.retiredMark) {
+                hooks.restoreOption(retired_.back());
+                retired_.pop_back();
+            }
+            if (mode_ == SearchMode::DECIDE && top.isWhole) {
+                hooks.recordNogood(depthLimit_ - depth() + 1);
+            }
+            options_.resize(top.begin);
+            frames_.pop_back();
+        }
+        return false;
+    }
+
+    /**
+     * @brief unwind  uncovers every option on the frame stack in reverse order and restores every
+     *                option the frames retired. The path given to enter stays covered.
+     * @param hooks   the hooks of the solver we search.
+     */
+    template <typename Hooks>
+    void unwind(Hooks& hooks) {
+        while (!frames_.empty()) {
+            hooks.uncoverOption(options_[frames_.back().cur]);
+            chosen_.pop_back();
+            while ((int)retired_.size() > frames_.back().retiredMark) {
+                hooks.restoreOption(retired_.back());
+                retired_.pop_back();
+            }
+            options_.resize(frames_.back().begin);
+            frames_.pop_back();
+        }
+    }
+
+    /**
+     * @brief depth  the number of options chosen, those of the path included.
+     * @return       the depth of the node we are at.
+     */
+    int depth() const {
+        return pathSize_ + frames_.size();
+    }
+
+    /**
+     * @brief chosen  the options chosen from the root to the node we are at, in the order chosen.
+     * @return        the options the solver reported as it covered each one.
+     */
+    const std::vector<Option>& chosen() const {
+        return chosen_;
+    }
+
+    /**
+     * @brief frames  the frames beneath the path. ParallelSearch shortens the range of a frame when
+     *                it gives the untried options of the frame to another worker.
+     * @return        the stack of frames from the shallowest to the deepest.
+     */
+    std::vector<Frame>& frames() {
+        return frames_;
+    }
+
+    /**
+     * @brief option    the option listed at a position of the options stack.
+     * @param position  a position from the begin up to the end of some frame.
+     * @return          the index in the option that we cover it with.
+     */
+    int option(int position) const {
+        return options_[position];
+    }
+
+
+private:
+
+
+    static constexpr int MAX_RESERVED_DEPTH = 1 << 12;
+
+    int depthLimit_;
+    SearchMode mode_;
+    int pathSize_;
+    std::vector<Frame> frames_;
+    // The options listed for every frame, one after another from the shallowest frame.
+    std::vector<int> options_;
+    std::vector<Option> chosen_;
+    std::vector<int> retired_;
+
+
+    /**
+     * @brief openFrame  pushes a frame whose options are already listed and covers its first one.
+     * @param hooks      the hooks of the solver we search.
+     * @param frame      the frame we push.
+     */
+    template <typename Hooks>
+    void openFrame(Hooks& hooks, const Frame& frame) {
+        int depthTag = depthLimit_ - depth();
+        frames_.push_back(frame);
+        chosen_.push_back(hooks.coverOption(options_[frame.cur], depthTag));
+    }
+};
+
+} // namespace DancingLinks
+
+#endif // ITERATIVESEARCH_H
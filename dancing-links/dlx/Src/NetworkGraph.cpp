@@ -0,0 +1,338 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: NetworkGraph.cpp
+ * --------------------------
+ * This file contains the implementation of the compact CSR graph the dancing links solvers are
+ * built from, along with the more general network of items and options the disaster solvers use.
+ * The map constructors are the only place names are looked up. Once a graph exists a solver can
+ * build its grid by walking these arrays without hashing a single string.
+ */
+#include <algorithm>
+#include "NetworkGraph.h"
+
+namespace DancingLinks {
+
+
+/* * * * * * * * * * * * * * * * *   Building the Compact Graph   * * * * * * * * * * * * * * * * */
+
+
+NetworkGraph::NetworkGraph(const std::map<std::string, std::set<std::string>>& network)
+    : names_(),
+      offsets_(),
+      neighbors_(),
+      weights_(),
+      isWeighted_(false) {
+    names_.reserve(network.size());
+    for (const auto& [name, connections] : network) {
+        names_.push_back(name);
+    }
+    offsets_.reserve(network.size() + 1);
+    offsets_.push_back(0);
+    for (const auto& [name, connections] : network) {
+        for (const std::string& connection : connections) {
+            // A city or person is already in its own option so a link to itself adds nothing.
+            if (connection != name) {
+                neighbors_.push_back(idOf(connection));
+            }
+        }
+        offsets_.push_back(neighbors_.size());
+    }
+    finishArcs();
+}
+
+NetworkGraph::NetworkGraph(const std::map<std::string, std::map<std::string,int>>& network)
+    : names_(),
+      offsets_(),
+      neighbors_(),
+      weights_(),
+      isWeighted_(true) {
+    names_.reserve(network.size());
+    for (const auto& [name, connections] : network) {
+        names_.push_back(name);
+    }
+    offsets_.reserve(network.size() + 1);
+    offsets_.push_back(0);
+    for (const auto& [name, connections] : network) {
+        for (const auto& [connection, weight] : connections) {
+            if (connection != name) {
+                neighbors_.push_back(idOf(connection));
+                weights_.push_back(weight);
+            }
+        }
+        offsets_.push_back(neighbors_.size());
+    }
+    finishArcs();
+}
+
+NetworkGraph::NetworkGraph(std::vector<std::string> names,
+                           std::vector<int> offsets,
+                           std::vector<int> neighbors,
+                           std::vector<int> weights)
+    : names_(std::move(names)),
+      offsets_(std::move(offsets)),
+      neighbors_(std::move(neighbors)),
+      weights_(std::move(weights)),
+      isWeighted_(!weights_.empty()) {
+    finishArcs();
+}
+
+void NetworkGraph::finishArcs() {
+    if (offsets_.size() != names_.size() + 1 || offsets_.front() != 0
+            || offsets_.back() != (int)neighbors_.size()) {
+        error("Graph offsets must start at zero and end at the number of arcs.");
+    }
+    if (isWeighted_ && weights_.size() != neighbors_.size()) {
+        error("Graph weights must be empty or match the number of arcs.");
+    }
+    for (int vertex = 0; vertex < numVertices(); vertex++) {
+        int begin = offsets_[vertex];
+        int end = offsets_[vertex + 1];
+        if (end < begin) {
+            error("Graph offsets must never decrease.");
+        }
+        bool isSorted = true;
+        for (int arc = begin; arc < end; arc++) {
+            if (neighbors_[arc] < 0 || neighbors_[arc] >= numVertices()
+                    || neighbors_[arc] == vertex) {
+                error("Graph arc leads to itself or to a vertex outside the graph.");
+            }
+            isSorted = isSorted && (arc == begin || neighbors_[arc - 1] <= neighbors_[arc]);
+        }
+        if (!isSorted) {
+            // Only hand built graphs arrive here. Weights must follow their neighbors as we sort.
+            std::vector<std::pair<int,int>> arcs = {};
+            for (int arc = begin; arc < end; arc++) {
+                arcs.push_back({neighbors_[arc], isWeighted_ ? weights_[arc] : 0});
+            }
+            std::sort(arcs.begin(), arcs.end());
+            for (int arc = begin; arc < end; arc++) {
+                neighbors_[arc] = arcs[arc - begin].first;
+                if (isWeighted_) {
+                    weights_[arc] = arcs[arc - begin].second;
+                }
+            }
+        }
+        for (int arc = begin + 1; arc < end; arc++) {
+            if (neighbors_[arc - 1] == neighbors_[arc]) {
+                error("Graph lists the same arc twice.");
+            }
+        }
+    }
+}
+
+int NetworkGraph::idOf(const std::string& name) const {
+    auto found = std::lower_bound(names_.begin(), names_.end(), name);
+    if (found == names_.end() || *found != name) {
+        error("Connection to " + name + " who is not in the network.");
+    }
+    return found - names_.begin();
+}
+
+
+/* * * * * * * * * * * * * * * * * *   Reading the Compact Graph   * * * * * * * * * * * * * * * * */
+
+
+int NetworkGraph::numVertices() const {
+    return names_.size();
+}
+
+int NetworkGraph::numArcs() const {
+    return neighbors_.size();
+}
+
+bool NetworkGraph::isWeighted() const {
+    return isWeighted_;
+}
+
+const std::string& NetworkGraph::name(int vertex) const {
+    return names_[vertex];
+}
+
+int NetworkGraph::degree(int vertex) const {
+    return offsets_[vertex + 1] - offsets_[vertex];
+}
+
+int NetworkGraph::arcsBegin(int vertex) const {
+    return offsets_[vertex];
+}
+
+int NetworkGraph::arcsEnd(int vertex) const {
+    return offsets_[vertex + 1];
+}
+
+int NetworkGraph::neighbor(int arc) const {
+    return neighbors_[arc];
+}
+
+int NetworkGraph::weight(int arc) const {
+    return weights_[arc];
+}
+
+
+/* * * * * * * * * * * * * * * * *   Items Covered by Options   * * * * * * * * * * * * * * * * * */
+
+
+CoverNetwork::CoverNetwork(const NetworkGraph& roadNetwork)
+    : itemNames_(),
+      optionNames_(),
+      offsets_(),
+      items_() {
+    int numCities = roadNetwork.numVertices();
+    itemNames_.reserve(numCities);
+    offsets_.reserve(numCities + 1);
+    items_.reserve(numCities + roadNetwork.numArcs());
+    offsets_.push_back(0);
+    for (int city = 0; city < numCities; city++) {
+        itemNames_.push_back(roadNetwork.name(city));
+        // Neighbors arrive sorted by id so the city slots in before the first neighbor above it.
+        bool isCityPlaced = false;
+        for (int arc = roadNetwork.arcsBegin(city); arc < roadNetwork.arcsEnd(city); arc++) {
+            int neighbor = roadNetwork.neighbor(arc);
+            if (!isCityPlaced && city < neighbor) {
+                items_.push_back(city);
+                isCityPlaced = true;
+            }
+            items_.push_back(neighbor);
+        }
+        if (!isCityPlaced) {
+            items_.push_back(city);
+        }
+        offsets_.push_back(items_.size());
+    }
+    optionNames_ = itemNames_;
+}
+
+CoverNetwork::CoverNetwork(std::vector<std::string> itemNames,
+                           std::vector<std::string> optionNames,
+                           std::vector<int> offsets,
+                           std::vector<int> items)
+    : itemNames_(std::move(itemNames)),
+      optionNames_(std::move(optionNames)),
+      offsets_(std::move(offsets)),
+      items_(std::move(items)) {
+    finishOptions();
+}
+
+void CoverNetwork::finishOptions() {
+    if (offsets_.size() != optionNames_.size() + 1 || offsets_.front() != 0
+            || offsets_.back() != (int)items_.size()) {
+        error("Option offsets must start at zero and end at the number of covered items.");
+    }
+    for (int option = 0; option < numOptions(); option++) {
+        if (offsets_[option + 1] < offsets_[option]) {
+            error("Option offsets must never decrease.");
+        }
+        for (int entry = offsets_[option]; entry < offsets_[option + 1]; entry++) {
+            if (items_[entry] < 0 || items_[entry] >= numItems()) {
+                error("Option covers an item outside the network.");
+            }
+        }
+        std::sort(items_.begin() + offsets_[option], items_.begin() + offsets_[option + 1]);
+        if (std::adjacent_find(items_.begin() + offsets_[option],
+                               items_.begin() + offsets_[option + 1])
+                != items_.begin() + offsets_[option + 1]) {
+            error("Option covers the same item twice.");
+        }
+    }
+}
+
+int CoverNetwork::numItems() const {
+    return itemNames_.size();
+}
+
+int CoverNetwork::numOptions() const {
+    return optionNames_.size();
+}
+
+int CoverNetwork::numEntries() const {
+    return items_.size();
+}
+
+const std::string& CoverNetwork::itemName(int item) const {
+    return itemNames_[item];
+}
+
+const std::string& CoverNetwork::optionName(int option) const {
+    return optionNames_[option];
+}
+
+int CoverNetwork::optionSize(int option) const {
+    return offsets_[option + 1] - offsets_[option];
+}
+
+int CoverNetwork::optionBegin(int option) const {
+    return offsets_[option];
+}
+
+int CoverNetwork::optionEnd(int option) const {
+    return offsets_[option + 1];
+}
+
+int CoverNetwork::item(int entry) const {
+    return items_[entry];
+}
+
+std::vector<CoverNetwork> CoverNetwork::getComponents() const {
+    // Every option joins all of the items it covers into one group.
+    std::vector<int> parent(numItems());
+    for (int item = 0; item < numItems(); item++) {
+        parent[item] = item;
+    }
+    for (int option = 0; option < numOptions(); option++) {
+        for (int entry = offsets_[option] + 1; entry < offsets_[option + 1]; entry++) {
+            int first = findRoot(parent, items_[offsets_[option]]);
+            int other = findRoot(parent, items_[entry]);
+            parent[std::max(first, other)] = std::min(first, other);
+        }
+    }
+
+    // Roots are always the smallest item of a group so groups are numbered in order of first item.
+    std::vector<int> componentOf(numItems(), -1);
+    std::vector<int> newId(numItems(), -1);
+    std::vector<std::vector<std::string>> itemNames = {};
+    for (int item = 0; item < numItems(); item++) {
+        int root = findRoot(parent, item);
+        if (root == item) {
+            componentOf[item] = itemNames.size();
+            itemNames.emplace_back();
+        } else {
+            componentOf[item] = componentOf[root];
+        }
+        newId[item] = itemNames[componentOf[item]].size();
+        itemNames[componentOf[item]].push_back(itemNames_[item]);
+    }
+    std::vector<std::vector<std::string>> optionNames(itemNames.size());
+    std::vector<std::vector<int>> offsets(itemNames.size(), {0});
+    std::vector<std::vector<int>> items(itemNames.size());
+    for (int option = 0; option < numOptions(); option++) {
+        if (!optionSize(option)) {
+            continue;
+        }
+        int component = componentOf[items_[offsets_[option]]];
+        optionNames[component].push_back(optionNames_[option]);
+        for (int entry = offsets_[option]; entry < offsets_[option + 1]; entry++) {
+            items[component].push_back(newId[items_[entry]]);
+        }
+        offsets[component].push_back(items[component].size());
+    }
+
+    std::vector<CoverNetwork> components = {};
+    components.reserve(itemNames.size());
+    for (int component = 0; component < (int)itemNames.size(); component++) {
+        components.emplace_back(std::move(itemNames[component]),
+                                std::move(optionNames[component]),
+                                std::move(offsets[component]),
+                                std::move(items[component]));
+    }
+    return components;
+}
+
+int CoverNetwork::findRoot(std::vector<int>& parent, int item) {
+    while (parent[item] != item) {
+        parent[item] = parent[parent[item]];
+        item = parent[item];
+    }
+    return item;
+}
+
+} // namespace DancingLinks
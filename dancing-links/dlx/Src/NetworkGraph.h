@@ -0,0 +1,188 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: NetworkGraph.h
+ * --------------------------
+ * This file defines a compact graph that every dancing links solver can be built from. Names are
+ * only used to report results, so they live in their own table while the connections use a dense
+ * id space of 0 to N - 1. The adjacency of every vertex is stored back to back in one array in the
+ * compressed sparse row (CSR) layout. The arcs of vertex v are the neighbors from offsets[v] up to,
+ * but not including, offsets[v + 1]. An optional weight array runs parallel to the neighbors.
+ *
+ * Every vertex lists its neighbors in ascending order with no duplicates and never lists itself.
+ * Because the map constructors number vertices in the sorted order of their names, a solver built
+ * from a graph lays out its grid exactly as it would have from the original map.
+ *
+ * The disaster solvers really cover items with options, and a graph is only the special case where
+ * every city is both an item and the option of supplying it. A CoverNetwork is the general case.
+ * Its options need not match its items one to one, which is what a reduced network looks like once
+ * some cities are known to be safe and some supply locations are known to be useless.
+ */
+#ifndef NETWORKGRAPH_H
+#define NETWORKGRAPH_H
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "GUI/SimpleTest.h"
+
+namespace DancingLinks {
+
+class NetworkGraph {
+
+public:
+
+
+    /**
+     * @brief NetworkGraph  builds a graph from the map of connections the solvers have always
+     *                      accepted. Vertices are numbered in the order the map stores the names.
+     *                      A name that only appears as a neighbor is an error.
+     * @param network       the map of each name to the names it is connected to.
+     */
+    explicit NetworkGraph(const std::map<std::string, std::set<std::string>>& network);
+
+    /**
+     * @brief NetworkGraph  builds a weighted graph from a map of each name to its weighted
+     *                      connections. The weight of an arc is the weight the first name gave.
+     * @param network       the map of each name to the names it is connected to and the weights.
+     */
+    explicit NetworkGraph(const std::map<std::string, std::map<std::string,int>>& network);
+
+    /**
+     * @brief NetworkGraph  builds a graph directly from CSR arrays, for callers that already have
+     *                      a dense numbering. The arrays are checked and any list of neighbors out
+     *                      of order is sorted, carrying its weights with it.
+     * @param names         the name of every vertex indexed by id.
+     * @param offsets       the start of the arcs of each vertex, with the total arc count at the end.
+     * @param neighbors     the id at the end of each arc.
+     * @param weights       the weight of each arc or empty if the graph is not weighted.
+     */
+    NetworkGraph(std::vector<std::string> names,
+                 std::vector<int> offsets,
+                 std::vector<int> neighbors,
+                 std::vector<int> weights = {});
+
+    int numVertices() const;
+    int numArcs() const;
+    bool isWeighted() const;
+    const std::string& name(int vertex) const;
+    int degree(int vertex) const;
+
+    /**
+     * @brief arcsBegin  the first arc of a vertex. Arcs of a vertex run up to arcsEnd.
+     * @param vertex     the id of the vertex whose arcs we want.
+     * @return           the index of the first arc in the neighbor and weight arrays.
+     */
+    int arcsBegin(int vertex) const;
+    int arcsEnd(int vertex) const;
+    int neighbor(int arc) const;
+    int weight(int arc) const;
+
+
+private:
+
+
+    std::vector<std::string> names_;
+    std::vector<int> offsets_;
+    std::vector<int> neighbors_;
+    std::vector<int> weights_;
+    bool isWeighted_;
+
+
+    /**
+     * @brief finishArcs  checks that the arrays describe a well formed graph and sorts the
+     *                    neighbors of each vertex. Every constructor ends here.
+     */
+    void finishArcs();
+
+    /**
+     * @brief idOf  finds the id of a name with a binary search of the sorted name table.
+     * @param name  the name we must find.
+     * @return      the id of the name. It is an error if the name is not in the graph.
+     */
+    int idOf(const std::string& name) const;
+
+    ALLOW_TEST_ACCESS();
+};
+
+class CoverNetwork {
+
+public:
+
+
+    /**
+     * @brief CoverNetwork  turns a graph into the items and options of the supply problem. Every
+     *                      city is an item and supplying a city is the option that covers the city
+     *                      and its neighbors. Items and options share the ids of the graph.
+     * @param roadNetwork   the graph of cities connected to other cities.
+     */
+    explicit CoverNetwork(const NetworkGraph& roadNetwork);
+
+    /**
+     * @brief CoverNetwork  builds a network directly from CSR arrays of the items each option
+     *                      covers. The arrays are checked and each option's items are sorted.
+     * @param itemNames     the name of every item indexed by id.
+     * @param optionNames   the name of every option indexed by id.
+     * @param offsets       the start of the items of each option, with the total at the end.
+     * @param items         the id of every item covered, option after option.
+     */
+    CoverNetwork(std::vector<std::string> itemNames,
+                 std::vector<std::string> optionNames,
+                 std::vector<int> offsets,
+                 std::vector<int> items);
+
+    int numItems() const;
+    int numOptions() const;
+    int numEntries() const;
+    const std::string& itemName(int item) const;
+    const std::string& optionName(int option) const;
+    int optionSize(int option) const;
+
+    /**
+     * @brief optionBegin  the first entry of an option. Entries of an option run up to optionEnd.
+     * @param option       the id of the option whose items we want.
+     * @return             the index of the first entry in the array of covered items.
+     */
+    int optionBegin(int option) const;
+    int optionEnd(int option) const;
+    int item(int entry) const;
+
+    /**
+     * @brief getComponents  splits the network into groups of items that share no option with any
+     *                       other group. A cover of the network is a cover of every group, so each
+     *                       group can be searched on its own. Items and options keep their order
+     *                       within a group and groups are ordered by their first item. Options that
+     *                       cover nothing belong to no group and are dropped.
+     * @return               the connected components of the network.
+     */
+    std::vector<CoverNetwork> getComponents() const;
+
+
+private:
+
+
+    std::vector<std::string> itemNames_;
+    std::vector<std::string> optionNames_;
+    std::vector<int> offsets_;
+    std::vector<int> items_;
+
+
+    /**
+     * @brief finishOptions  checks that the arrays describe well formed options and sorts the items
+     *                       of each option.
+     */
+    void finishOptions();
+
+    /**
+     * @brief findRoot  finds the representative of an item's group, halving the path as it goes.
+     * @param parent    the parent of every item in a forest of groups.
+     * @param item      the item whose group we want.
+     * @return          the item representing the group.
+     */
+    static int findRoot(std::vector<int>& parent, int item);
+
+    ALLOW_TEST_ACCESS();
+};
+
+} // namespace DancingLinks
+
+#endif // NETWORKGRAPH_H
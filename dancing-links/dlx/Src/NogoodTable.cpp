@@ -0,0 +1,92 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: NogoodTable.cpp
+ * --------------------------
+ * This file contains the implementation of the bounded table of sub-problems a disaster cover
+ * search has proven infeasible. See the header for the replacement policy.
+ */
+#include <algorithm>
+#include "NogoodTable.h"
+
+namespace DancingLinks {
+
+
+NogoodTable::NogoodTable(int numBuckets)
+    : buckets_(),
+      numBuckets_(1),
+      mask_(0),
+      stats_({0, 0, 0, 0}) {
+    while (numBuckets_ < numBuckets) {
+        numBuckets_ <<= 1;
+    }
+    mask_ = numBuckets_ - 1;
+}
+
+uint64_t NogoodTable::itemKey(int item) {
+    // The splitmix64 finalizer spreads consecutive indices over all 64 bits.
+    uint64_t key = (uint64_t)item * 0x9E3779B97F4A7C15ULL + 0x9E3779B97F4A7C15ULL;
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+    return key ^ (key >> 31);
+}
+
+void NogoodTable::prepare() {
+    if (buckets_.empty()) {
+        buckets_.assign(numBuckets_, {{0, 0}, {0, 0}});
+    }
+    stats_ = {0, 0, 0, 0};
+}
+
+bool NogoodTable::isInfeasible(uint64_t key, int numSupplies) {
+    if (buckets_.empty()) {
+        stats_.misses++;
+        return false;
+    }
+    const Bucket& bucket = buckets_[key & mask_];
+    if ((bucket.largest.key == key && bucket.largest.numSupplies >= numSupplies)
+            || (bucket.newest.key == key && bucket.newest.numSupplies >= numSupplies)) {
+        stats_.hits++;
+        return true;
+    }
+    stats_.misses++;
+    return false;
+}
+
+void NogoodTable::recordInfeasible(uint64_t key, int numSupplies) {
+    stats_.stores++;
+    // A search may start without prepare, as tests of the recursion do, so take memory now.
+    if (buckets_.empty()) {
+        buckets_.assign(numBuckets_, {{0, 0}, {0, 0}});
+    }
+    Bucket& bucket = buckets_[key & mask_];
+    // A proof with more supplies is stronger so the same items only ever need one entry.
+    if (bucket.largest.key == key && bucket.largest.numSupplies) {
+        bucket.largest.numSupplies = std::max(bucket.largest.numSupplies, numSupplies);
+        return;
+    }
+    if (bucket.newest.key == key && bucket.newest.numSupplies) {
+        numSupplies = std::max(numSupplies, bucket.newest.numSupplies);
+        bucket.newest.numSupplies = 0;
+    }
+    if (numSupplies >= bucket.largest.numSupplies) {
+        if (bucket.newest.numSupplies && bucket.largest.numSupplies) {
+            stats_.evictions++;
+        }
+        // The old largest proof is demoted rather than lost.
+        if (bucket.largest.numSupplies) {
+            bucket.newest = bucket.largest;
+        }
+        bucket.largest = {key, numSupplies};
+        return;
+    }
+    if (bucket.newest.numSupplies) {
+        stats_.evictions++;
+    }
+    bucket.newest = {key, numSupplies};
+}
+
+NogoodTable::NogoodStats NogoodTable::getStats() const {
+    return stats_;
+}
+
+} // namespace DancingLinks
@@ -0,0 +1,106 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: NogoodTable.h
+ * --------------------------
+ * This file defines a transposition table of nogoods for the disaster cover searches. Supplying
+ * A and then B leaves the same cities uncovered as supplying B and then A, so a recursive search
+ * meets the same sub-problem again and again through different orders of choices. Options are
+ * never removed by those searches, so a sub-problem is only the set of uncovered cities and the
+ * supplies we have left. Once we prove a set of cities can not be covered with some supplies, it
+ * can not be covered with fewer either, and we never need to search it again.
+ *
+ * A set of cities is identified by a Zobrist hash. Every city has a fixed random key and the hash
+ * of a set is the exclusive or of the keys of its cities, so a solver keeps the hash current with
+ * one exclusive or each time it covers or uncovers a city. We store the full 64 bit hash with an
+ * entry and accept the vanishing chance that two sets we meet share one.
+ *
+ * The table has a fixed number of buckets and never grows. Each bucket holds two entries. The
+ * first keeps the proof with the most supplies because it refutes the largest sub-problems and is
+ * the most expensive to find again. The second always takes the newest proof that lost to the
+ * first, so recent sub-problems of the current branch are still remembered.
+ */
+#ifndef NOGOODTABLE_H
+#define NOGOODTABLE_H
+#include <cstdint>
+#include <vector>
+#include "GUI/SimpleTest.h"
+
+namespace DancingLinks {
+
+class NogoodTable {
+
+public:
+
+
+    /**
+     * @brief NogoodTable  prepares a table with a bounded number of buckets. No memory is taken
+     *                     until the first nogood is stored so copies of unused solvers stay cheap.
+     * @param numBuckets   the least number of buckets. We round up to a power of two.
+     */
+    explicit NogoodTable(int numBuckets = 1 << 15);
+
+    /**
+     * @brief itemKey  the fixed random key of an item for the Zobrist hash of a set of items.
+     * @param item     the index of the item.
+     * @return         a well mixed 64 bit key that never changes for this index.
+     */
+    static uint64_t itemKey(int item);
+
+    /**
+     * @brief prepare  takes the memory of the table if it has none and resets the statistics.
+     *                 Entries are facts about the network, not one search, so they are kept.
+     */
+    void prepare();
+
+    /**
+     * @brief isInfeasible  checks if the set of items was proven impossible to cover with at least
+     *                      as many supplies as we have now. Counts a hit or a miss.
+     * @param key           the Zobrist hash of the items that remain uncovered.
+     * @param numSupplies   the supplies we have left to cover them.
+     * @return              true if we may skip this sub-problem.
+     */
+    bool isInfeasible(uint64_t key, int numSupplies);
+
+    /**
+     * @brief recordInfeasible  remembers that a set of items can not be covered with the supplies.
+     * @param key               the Zobrist hash of the items that remain uncovered.
+     * @param numSupplies       the supplies that were not enough.
+     */
+    void recordInfeasible(uint64_t key, int numSupplies);
+
+    // How the table performed since the last call to prepare.
+    struct NogoodStats {
+        long long hits;
+        long long misses;
+        long long stores;
+        long long evictions;
+    };
+
+    NogoodStats getStats() const;
+
+
+private:
+
+
+    // An entry is empty while its supplies are zero. Covering nothing with nothing always works.
+    struct Nogood {
+        uint64_t key;
+        int numSupplies;
+    };
+
+    struct Bucket {
+        Nogood largest;
+        Nogood newest;
+    };
+
+    std::vector<Bucket> buckets_;
+    int numBuckets_;
+    uint64_t mask_;
+    NogoodStats stats_;
+
+    ALLOW_TEST_ACCESS();
+};
+
+} // namespace DancingLinks
+
+#endif // NOGOODTABLE_H
@@ -0,0 +1,341 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: ParallelSearch.h
+ * --------------------------
+ * This file contains a multi-threaded driver for the cover searches performed by the DisasterLinks,
+ * DisasterTags, and PartnerLinks classes. The subtrees beneath the item we choose to cover are
+ * wildly unbalanced. One option may be refuted after a handful of covers while its neighbor hides
+ * almost the entire search. Splitting the tree once at the root is therefore not enough to keep
+ * every thread busy, so this driver uses work stealing.
+ *
+ * Every worker owns a copy of the dancing links grid and searches it with the explicit stack of
+ * frames from IterativeSearch rather than recursion. A frame remembers the item we are covering,
+ * the options the solver listed for it, and which of them we are trying now. Workers prune with
+ * the bounds and nogoods of their own copy just as the serial search does. When a worker runs out
+ * of work it raises a request to steal. The next time a busy worker enters a node it answers by
+ * cutting its shallowest frame that still has untried options in two. It keeps the option it is
+ * working on and hands the rest of the list to the thief as a task. A task is only the path of
+ * options chosen to reach the frame and the positions left to try in its list. The thief replays
+ * the path on its own grid copy, lists the options of that node the same way, and continues
+ * exactly where the victim stopped.
+ * A search may be bounded by SearchLimits. Every worker spends its own budget but all of them add
+ * to one shared node count, and the first worker to run out of budget stops every other worker.
+ *
+ * Because this is a template it lives entirely in this header. A solver that wants to be driven in
+ * parallel must befriend ParallelSearch and IterativeSearch and provide the following private
+ * members. The depth tag passed when covering an option, pruning, or recording a nogood is the
+ * depth limit minus the current depth, which is the number of supplies left in a disaster. The
+ * hooks may live on a separate object that withHooks hands to a whole task at once. Listing the
+ * options of a node must give the same list every time the node is reached in the same state.
+ *
+ *      template <typename Step> auto withHooks(const Step& step);   // Calls step(hooks).
+ *      bool isSolved() const;
+ *      int chooseItem() const;                               // Zero or less if nothing to try.
+ *      int nextOption(int indexInOption) const;
+ *      Option coverOption(int indexInOption, int depthTag);
+ *      void uncoverOption(int indexInOption);
+ *      bool isPruned(int depthTag);                          // Bounds and nogoods cut the node.
+ *      int chooseOptions(std::vector<int>& options);         // Appends the options to try.
+ *      void recordNogood(int depthTag);                      // Every option of the node failed.
+ *      SearchStats& stats() const;
+ */
+#ifndef PARALLELSEARCH_H
+#define PARALLELSEARCH_H
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "IterativeSearch.h"
+#include "SearchLimits.h"
+
+namespace DancingLinks {
+
+template <typename Links, typename Option>
+class ParallelSearch {
+
+public:
+
+
+    /**
+     * @brief ParallelSearch  prepares to search a dancing links solver with multiple threads. The
+     *                        solver we are given is only used as the source of the copies we give
+     *                        to each worker. It is left unchanged.
+     * @param links           the fully built solver we want to search in parallel.
+     * @param numWorkers      the number of threads to use. Zero or less uses every core we have.
+     */
+    ParallelSearch(const Links& links, int numWorkers)
+        : links_(links),
+          numWorkers_(numWorkers > 0 ? numWorkers
+                                     : std::max(1, (int)std::thread::hardware_concurrency())),
+          depthLimit_(0),
+          pool_(),
+          poolLock_(),
+          poolReady_(),
+          pending_(0),
+          hungry_(0),
+          active_(0),
+          found_(false),
+          aborted_(false),
+          limits_(),
+          sharedNodes_(0),
+          result_(),
+          nodesPerWorker_() {}
+
+    /**
+     * @brief hasCover         searches for a cover using at most the given number of options.
+     *                         Workers steal unexplored ranges of options from one another until a
+     *                         cover is found or every range has been refuted.
+     * @param depthLimit       the limit on how many options we can choose.
+     * @param selectedOptions  the output parameter holding the cover found by the fastest worker.
+     * @return                 true if any worker found a cover, false if no cover exists.
+     */
+    bool hasCover(int depthLimit, std::set<Option>& selectedOptions) {
+        return findCover(depthLimit, selectedOptions, SearchLimits()) == SearchStatus::FOUND;
+    }
+
+    /**
+     * @brief findCover        performs the same search as hasCover but every worker stops once any
+     *                         limit is reached. The node limit counts the nodes of all workers.
+     * @param depthLimit       the limit on how many options we can choose.
+     * @param selectedOptions  the output parameter holding the cover found by the fastest worker.
+     * @param limits           the node, time, and cancellation limits for the search.
+     * @return                 FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+     */
+    SearchStatus findCover(int depthLimit,
+                           std::set<Option>& selectedOptions,
+                           const SearchLimits& limits) {
+        depthLimit_ = depthLimit;
+        pool_ = {{{}, 0, 0, 0}};
+        pending_ = 1;
+        hungry_ = 0;
+        active_ = 0;
+        found_ = false;
+        aborted_ = false;
+        limits_ = limits;
+        sharedNodes_ = 0;
+        result_.clear();
+        nodesPerWorker_.assign(numWorkers_, 0);
+
+        std::vector<std::thread> workers = {};
+        for (int id = 0; id < numWorkers_; id++) {
+            workers.emplace_back(&ParallelSearch::runWorker, this, id);
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        if (found_) {
+            selectedOptions.insert(result_.begin(), result_.end());
+            return SearchStatus::FOUND;
+        }
+        return aborted_ ? SearchStatus::ABORTED : SearchStatus::INFEASIBLE;
+    }
+
+    /**
+     * @brief nodesPerWorker  reports how many nodes of the search tree each worker entered during
+     *                        the last search. Useful to check how evenly the work was balanced.
+     * @return                the node count for each worker indexed by worker.
+     */
+    const std::vector<long long>& nodesPerWorker() const {
+        return nodesPerWorker_;
+    }
+
+
+private:
+
+
+    /* A task is a subtree of the search handed from one worker to another. The path leads from the
+     * root to the node where the task begins. If item is zero the task is that entire node.
+     * Otherwise the task is only the options from position start up to, but not including, end in
+     * the list of options the solver gives for the given item at that node.
+     */
+    struct Task {
+        std::vector<int> path;
+        int item;
+        int start;
+        int end;
+    };
+
+    using Frame = typename IterativeSearch<Links,Option>::Frame;
+
+    const Links& links_;
+    int numWorkers_;
+    int depthLimit_;
+    std::vector<Task> pool_;
+    std::mutex poolLock_;
+    std::condition_variable poolReady_;
+    // These are read without the lock on every node so busy workers know when to give away work.
+    std::atomic<int> pending_;
+    std::atomic<int> hungry_;
+    int active_;
+    std::atomic<bool> found_;
+    std::atomic<bool> aborted_;
+    SearchLimits limits_;
+    std::atomic<long long> sharedNodes_;
+    std::set<Option> result_;
+    std::vector<long long> nodesPerWorker_;
+
+
+    /**
+     * @brief runWorker  takes tasks from the shared pool until the search is finished. Each worker
+     *                   searches its own copy of the grid and reports its node count at the end.
+     * @param id         the index of this worker for reporting node counts.
+     */
+    void runWorker(int id) {
+        Links local(links_);
+        IterativeSearch<Links,Option> search(depthLimit_, SearchMode::DECIDE);
+        SearchBudget budget(limits_, &sharedNodes_);
+        long long nodes = 0;
+        Task task = {};
+        while (takeTask(task)) {
+            local.withHooks([&](auto& hooks) {
+                search.enter(hooks, task.path);
+
+                searchTask(hooks, task, search, budget, nodes);
+
+                search.leave(hooks, task.path);
+            });
+            finishTask();
+        }
+        nodesPerWorker_[id] = nodes;
+    }
+
+    /**
+     * @brief searchTask  performs a depth first search of the subtree described by a task with the
+     *                    explicit stack. The path of the task must already be entered. The stack
+     *                    may stop with frames left on it and leave will undo them.
+     * @param hooks       the hooks of this worker's copy of the grid.
+     * @param task        the task describing the subtree to search.
+     * @param search      the stack of frames for the options chosen beneath the task path.
+     * @param budget      this worker's share of the limits placed on the search.
+     * @param nodes       the running count of nodes this worker has entered.
+     */
+    template <typename Hooks>
+    void searchTask(Hooks& hooks, const Task& task, IterativeSearch<Links,Option>& search,
+                    SearchBudget& budget, long long& nodes) {
+        if (task.item) {
+            search.pushFrame(hooks, task.item, task.start, task.end);
+        }
+        for (;;) {
+            nodes++;
+            if (found_ || aborted_) {
+                return;
+            }
+            if (budget.isSpent()) {
+                recordAbort();
+                return;
+            }
+            if (hungry_.load(std::memory_order_relaxed)
+                    && !pending_.load(std::memory_order_relaxed)) {
+                donateWork(task, search);
+            }
+            if (hooks.isSolved()) {
+                recordCover(search.chosen());
+                return;
+            }
+            // Nothing left to try at this node so back up until a frame has an untried option.
+            if (!search.descend(hooks) && !search.advance(hooks)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief donateWork  answers a request to steal. We give away every untried option of the
+     *                    shallowest frame that has any because it is likely the largest subtree.
+     *                    This worker will stop at the option it is trying now. Neither that frame
+     *                    nor any frame above it sees its whole node anymore, so none may become a
+     *                    nogood when it runs out of options.
+     * @param task        the task this worker is currently searching.
+     * @param search      the stack of frames for this task.
+     */
+    void donateWork(const Task& task, IterativeSearch<Links,Option>& search) {
+        std::vector<Frame>& frames = search.frames();
+        for (int i = 0; i < (int)frames.size(); i++) {
+            if (frames[i].cur + 1 != frames[i].end) {
+                Task stolen = {task.path,
+                               frames[i].item,
+                               frames[i].cur + 1 - frames[i].begin,
+                               frames[i].end - frames[i].begin};
+                for (int j = 0; j < i; j++) {
+                    stolen.path.push_back(search.option(frames[j].cur));
+                }
+                for (int j = 0; j <= i; j++) {
+                    frames[j].isWhole = false;
+                }
+                frames[i].end = frames[i].cur + 1;
+                std::lock_guard<std::mutex> guard(poolLock_);
+                pool_.push_back(std::move(stolen));
+                pending_++;
+                poolReady_.notify_one();
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief takeTask  waits for a task to search. Returns false once a cover is found, once a
+     *                  limit stops the search, or when no tasks remain and no worker is busy,
+     *                  meaning no one can donate more work.
+     * @param task      the output parameter for the task we take.
+     * @return          true if we have a new task to search, false if the search is finished.
+     */
+    bool takeTask(Task& task) {
+        std::unique_lock<std::mutex> lock(poolLock_);
+        hungry_++;
+        poolReady_.wait(lock, [this]() {
+            return found_ || aborted_ || !pool_.empty() || active_ == 0;
+        });
+        hungry_--;
+        if (found_ || aborted_ || pool_.empty()) {
+            poolReady_.notify_all();
+            return false;
+        }
+        task = std::move(pool_.back());
+        pool_.pop_back();
+        pending_--;
+        active_++;
+        return true;
+    }
+
+    /**
+     * @brief finishTask  marks this worker as idle. The last worker to go idle with no tasks left
+     *                    wakes the others so they can all finish.
+     */
+    void finishTask() {
+        std::lock_guard<std::mutex> guard(poolLock_);
+        active_--;
+        if (active_ == 0 && pool_.empty()) {
+            poolReady_.notify_all();
+        }
+    }
+
+    /**
+     * @brief recordCover  saves the first cover found and wakes every idle worker so they can stop.
+     * @param chosen       the options chosen from the root to the solved node.
+     */
+    void recordCover(const std::vector<Option>& chosen) {
+        std::lock_guard<std::mutex> guard(poolLock_);
+        if (!found_) {
+            result_.insert(chosen.begin(), chosen.end());
+            found_ = true;
+        }
+        poolReady_.notify_all();
+    }
+
+    /**
+     * @brief recordAbort  stops the search because a limit was reached and wakes every idle worker.
+     *                     A cover found by another worker first still counts as found.
+     */
+    void recordAbort() {
+        std::lock_guard<std::mutex> guard(poolLock_);
+        aborted_ = true;
+        poolReady_.notify_all();
+    }
+};
+
+} // namespace DancingLinks
+
+#endif // PARALLELSEARCH_H
@@ -8,9 +8,11 @@
  * Matching. For more details on the concepts behind the algorithm see the mini write up in the
  * DancingLinks.h file or the full write up in the README.md for the repository.
  */
+#include <algorithm>
 #include <cmath>
 #include <limits.h>
 #include "PartnerLinks.h"
+#include "ParallelSearch.h"
 
 namespace DancingLinks {
 
@@ -22,97 +24,147 @@ bool hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions) {
     return links.hasPerfectLinks(selectedOptions);
 }
 
+bool hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions, int numThreads) {
+    return links.hasPerfectLinks(selectedOptions, numThreads);
+}
+
+SearchStatus hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions,
+                           const SearchLimits& limits) {
+    return links.hasPerfectLinks(selectedOptions, limits);
+}
+
+SearchStatus hasExactCover(PartnerLinks& links, std::set<Pair>& selectedOptions, int numThreads,
+                           const SearchLimits& limits) {
+    return links.hasPerfectLinks(selectedOptions, numThreads, limits);
+}
+
 std::vector<std::set<Pair>> getAllExactCovers(PartnerLinks& links) {
     return links.getAllPerfectLinks();
 }
 
+uint64_t countExactCovers(PartnerLinks& links) {
+    return links.countPerfectLinks();
+}
+
+bool visitExactCovers(PartnerLinks& links,
+                      const std::function<bool(const std::vector<int>&)>& visit) {
+    return links.visitPerfectLinks(visit);
+}
+
 std::set<Pair> getMaxWeightMatching(PartnerLinks& links) {
     return links.getMaxWeightMatching();
 }
 
+SearchStatus getMaxWeightMatching(PartnerLinks& links, std::set<Pair>& pairs,
+                                  const SearchLimits& limits) {
+    return links.getMaxWeightMatching(pairs, limits);
+}
+
 
 /* * * * * * * * * * * * *  Perfect Matching Algorithm X via Dancing Links  * * * * * * * * * * * */
 
 
 bool PartnerLinks::hasPerfectLinks(std::set<Pair>& pairs) {
-    // Mathematically impossible perfect links no work necessary.
-    if (hasSingleton_ || numPeople_ % 2 != 0) {
-        return false;
-    }
-    return isPerfectMatching(pairs);
+    return hasPerfectLinks(pairs, SearchLimits()) == SearchStatus::FOUND;
 }
 
-bool PartnerLinks::isPerfectMatching(std::set<Pair>& pairs) {
-    if (table_[0].right == 0) {
-        return true;
+bool PartnerLinks::hasPerfectLinks(std::set<Pair>& pairs, int numThreads) {
+    return hasPerfectLinks(pairs, numThreads, SearchLimits()) == SearchStatus::FOUND;
+}
+
+SearchStatus PartnerLinks::hasPerfectLinks(std::set<Pair>& pairs, const SearchLimits& limits) {
+    // Mathematically impossible perfect links no work necessary.
+    if (hasSingleton_ || numPeople_ % 2 != 0) {
+        return SearchStatus::INFEASIBLE;
     }
-    // If our previous pairings led to someone that can no longer be reached stop recursion.
-    int chosenPerson = choosePerson();
-    if (chosenPerson == -1) {
-        return false;
+    budget_ = SearchBudget(limits);
+    // Everyone is paired off by the time we choose numPeople_ / 2 pairs so that is our depth.
+    std::vector<Pair> matching = {};
+    IterativeSearch<PartnerLinks,Pair> search(numPeople_ / 2, SearchMode::DECIDE);
+    if (search.findCover(*this, matching, budget_)) {
+        pairs.insert(matching.begin(), matching.end());
+        return SearchStatus::FOUND;
     }
+    return budget_.isAborted() ? SearchStatus::ABORTED : SearchStatus::INFEASIBLE;
+}
 
-    for (int cur = links_[chosenPerson].down; cur != chosenPerson; cur = links_[cur].down) {
-
-        Pair match = coverPairing(cur);
-
-        if (isPerfectMatching(pairs)) {
-            // Cleanup the data structure in case we are asked again. Maybe uneccessary.
-            pairs.insert(match);
-            uncoverPairing(cur);
-            return true;
-        }
-        // Selecting to partner chosenPerson with this option did not work out. Retry other option.
-        uncoverPairing(cur);
+SearchStatus PartnerLinks::hasPerfectLinks(std::set<Pair>& pairs,
+                                           int numThreads,
+                                           const SearchLimits& limits) {
+    if (hasSingleton_ || numPeople_ % 2 != 0) {
+        return SearchStatus::INFEASIBLE;
     }
-    return false;
+    // Everyone is paired off by the time we choose numPeople_ / 2 pairs so that is our depth.
+    ParallelSearch<PartnerLinks,Pair> search(*this, numThreads);
+    SearchStatus status = search.findCover(numPeople_ / 2, pairs, limits);
+    workerNodes_ = search.nodesPerWorker();
+    return status;
 }
 
 std::vector<std::set<Pair>> PartnerLinks::getAllPerfectLinks() {
     if (hasSingleton_ || numPeople_ % 2 != 0) {
         return {};
     }
-    /* Going with a pass by reference method here becuase I like the "no copy recursion" principle
-     * behind Knuth's dancing links. I can profile to see if this is any faster than creating
-     * copies of sets through the stack frames and returning the desired result as the return type.
-     */
     std::vector<std::set<Pair>> result = {};
-    std::set<Pair> soFar = {};
-    fillPerfectMatchings(soFar, result);
+    visitPerfectMatchings([&](const std::vector<int>& pairings) {
+        std::set<Pair> matching = {};
+        for (int pairing : pairings) {
+            matching.insert(getPairing(pairing));
+        }
+        result.push_back(matching);
+        return true;
+    });
     return result;
 }
 
-void PartnerLinks::fillPerfectMatchings(std::set<Pair>& soFar, std::vector<std::set<Pair>>& result) {
-    if (table_[0].right == 0) {
-        result.push_back(soFar);
-        return;
+uint64_t PartnerLinks::countPerfectLinks() {
+    if (hasSingleton_ || numPeople_ % 2 != 0) {
+        return 0;
     }
+    uint64_t count = 0;
+    visitPerfectMatchings([&](const std::vector<int>&) {
+        count++;
+        return true;
+    });
+    return count;
+}
 
-    int chosen = choosePerson();
-    // A person is left by themselves so backtrack to better choice.
-    if (chosen == -1) {
-        return;
+bool PartnerLinks::visitPerfectLinks(const MatchingVisitor& visit) {
+    if (hasSingleton_ || numPeople_ % 2 != 0) {
+        return true;
     }
+    return visitPerfectMatchings(visit);
+}
 
-    /* The chosen person must be included in any Perfect Matching configuration or else it would
-     * not be Perfect Matching. We will explore all ways to pair them off and include each in
-     * the output parameter. Some ways might leave loners and we won't include those.
-     */
+Pair PartnerLinks::getPairing(int pairing) const {
+    return {personNames_[links_[pairing].topOrLen],
+            personNames_[links_[toPairIndex(pairing)].topOrLen]};
+}
 
-    for (int cur = links_[chosen].down; cur != chosen; cur = links_[cur].down) {
+const SearchStats& PartnerLinks::getSearchStats() const {
+    return stats_;
+}
 
-        Pair match = coverPairing(cur);
-        soFar.insert(match);
+void PartnerLinks::resetSearchStats() {
+    stats_ = SearchStats();
+}
 
-        fillPerfectMatchings(soFar, result);
+const std::vector<long long>& PartnerLinks::getWorkerNodes() const {
+    return workerNodes_;
+}
 
-        uncoverPairing(cur);
-        soFar.erase(match);
-    }
+template <typename Visit>
+bool PartnerLinks::visitPerfectMatchings(const Visit& visit) {
+    // Every Perfect Matching pairs off everyone so no stack is deeper than half the people.
+    PairingHooks hooks(*this);
+    IterativeSearch<PairingHooks,int> search(numPeople_ / 2, SearchMode::UNIQUE);
+    return search.visitCovers(hooks, visit);
 }
 
 int PartnerLinks::choosePerson() const {
     for (int cur = table_[0].right; cur != 0; cur = table_[cur].right) {
+        // One mem for the header in the table and one for the number of pairings in the links.
+        DLX_STATS(stats_.mems += 2);
         // Someone has become inaccessible due to other matches.
         if (links_[cur].topOrLen == 0) {
             return -1;
@@ -122,15 +174,22 @@ int PartnerLinks::choosePerson() const {
 }
 
 Pair PartnerLinks::coverPairing(int indexInPair) {
+    coverPeople(indexInPair);
+    return getPairing(indexInPair);
+}
+
+void PartnerLinks::coverPeople(int indexInPair) {
 
     /* We now must cover the two people in this option in the lookup table. Then go through all
      * other options and eliminate the other pairings in which each appears because they are paired
      * off and therefore no longer accessible to other people that want to pair with them.
      */
 
-    personName p1 = table_[links_[indexInPair].topOrLen];
+    personHeader p1 = table_[links_[indexInPair].topOrLen];
     table_[p1.right].left = p1.left;
     table_[p1.left].right = p1.right;
+    // Each person costs a link, their header, and the two headers beside it.
+    DLX_STATS(stats_.mems += 8; stats_.updates += 2; stats_.depth++);
 
     // p1 needs to dissapear from all other pairings.
     hidePersonPairings(indexInPair);
@@ -138,19 +197,18 @@ Pair PartnerLinks::coverPairing(int indexInPair) {
     // In case I ever apply a selection heuristic, partner might not be to the right.
     indexInPair = toPairIndex(indexInPair);
 
-    personName p2 = table_[links_[indexInPair].topOrLen];
+    personHeader p2 = table_[links_[indexInPair].topOrLen];
     table_[p2.right].left = p2.left;
     table_[p2.left].right = p2.right;
 
     // p2 needs to dissapear from all other pairings.
     hidePersonPairings(indexInPair);
-
-    return {p1.name, p2.name};
 }
 
 void PartnerLinks::uncoverPairing(int indexInPair) {
+    DLX_STATS(stats_.mems += 8; stats_.depth--);
 
-    personName p1 = table_[links_[indexInPair].topOrLen];
+    personHeader p1 = table_[links_[indexInPair].topOrLen];
     table_[p1.left].right = links_[indexInPair].topOrLen;
     table_[p1.right].left = links_[indexInPair].topOrLen;
 
@@ -158,7 +216,7 @@ void PartnerLinks::uncoverPairing(int indexInPair) {
 
     indexInPair = toPairIndex(indexInPair);
 
-    personName p2 = table_[links_[indexInPair].topOrLen];
+    personHeader p2 = table_[links_[indexInPair].topOrLen];
     table_[p2.left].right = links_[indexInPair].topOrLen;
     table_[p2.right].left = links_[indexInPair].topOrLen;
 
@@ -168,12 +226,14 @@ void PartnerLinks::uncoverPairing(int indexInPair) {
 void PartnerLinks::hidePersonPairings(int indexInPair) {
     for (int i = links_[indexInPair].down; i != indexInPair; i = links_[i].down) {
          // We need this guard to prevent splicing while on a column header.
+        DLX_STATS(stats_.mems++);
         if (i > links_[indexInPair].topOrLen) {
             // In case the other partner is to the left, just decrement index to go left.
             personLink cur = links_[toPairIndex(i)];
             links_[cur.up].down = cur.down;
             links_[cur.down].up = cur.up;
             links_[cur.topOrLen].topOrLen--;
+            DLX_STATS(stats_.mems += 4; stats_.updates++);
         }
     }
 }
@@ -181,17 +241,19 @@ void PartnerLinks::hidePersonPairings(int indexInPair) {
 void PartnerLinks::unhidePersonPairings(int indexInPair) {
     // The direction does not truly matter but I distinguish this from hide by going upwards.
     for (int i = links_[indexInPair].up; i != indexInPair; i = links_[i].up) {
+        DLX_STATS(stats_.mems++);
         if (i > links_[indexInPair].topOrLen) {
             int partnerIndex = toPairIndex(i);
             personLink cur = links_[partnerIndex];
             links_[cur.up].down = partnerIndex;
             links_[cur.down].up = partnerIndex;
             links_[cur.topOrLen].topOrLen++;
+            DLX_STATS(stats_.mems += 4);
         }
     }
 }
 
-inline int PartnerLinks::toPairIndex(int indexInPair) {
+inline int PartnerLinks::toPairIndex(int indexInPair) const {
     // There are only ever two people in an option so this is a safe increment/decrement.
     if (links_[++indexInPair].topOrLen <= 0) {
         indexInPair -= 2;
@@ -200,60 +262,195 @@ inline int PartnerLinks::toPairIndex(int indexInPair) {
 }
 
 
+/* * * * * * * * * * * * *     Hooks for the Parallel Search Driver      * * * * * * * * * * * * */
+
+
+bool PartnerLinks::isSolved() const {
+    return table_[0].right == 0;
+}
+
+int PartnerLinks::chooseItem() const {
+    return choosePerson();
+}
+
+int PartnerLinks::nextOption(int indexInPair) const {
+    return links_[indexInPair].down;
+}
+
+Pair PartnerLinks::coverOption(int indexInPair, int depthTag) {
+    (void)depthTag;
+    return coverPairing(indexInPair);
+}
+
+void PartnerLinks::uncoverOption(int indexInPair) {
+    uncoverPairing(indexInPair);
+}
+
+bool PartnerLinks::isPruned(int depthTag) const {
+    (void)depthTag;
+    return false;
+}
+
+int PartnerLinks::chooseOptions(std::vector<int>& options) {
+    // If our previous pairings led to someone that can no longer be reached stop this branch.
+    int chosenPerson = choosePerson();
+    if (chosenPerson == -1) {
+        return -1;
+    }
+    for (int cur = links_[chosenPerson].down; cur != chosenPerson; cur = links_[cur].down) {
+        options.push_back(cur);
+    }
+    return chosenPerson;
+}
+
+void PartnerLinks::recordNogood(int depthTag) {
+    (void)depthTag;
+}
+
+SearchStats& PartnerLinks::stats() const {
+    return stats_;
+}
+
+void PartnerLinks::retireOption(int indexInPair) {
+    // Every other option for the chosen person also covers them, so none could repeat this pair.
+    (void)indexInPair;
+}
+
+void PartnerLinks::restoreOption(int indexInPair) {
+    (void)indexInPair;
+}
+
+PartnerLinks::PairingHooks::PairingHooks(PartnerLinks& links)
+    : links_(links) {}
+
+bool PartnerLinks::PairingHooks::isSolved() const {
+    return links_.isSolved();
+}
+
+int PartnerLinks::PairingHooks::chooseItem() const {
+    return links_.chooseItem();
+}
+
+int PartnerLinks::PairingHooks::nextOption(int indexInPair) const {
+    return links_.nextOption(indexInPair);
+}
+
+int PartnerLinks::PairingHooks::coverOption(int indexInPair, int depthTag) {
+    (void)depthTag;
+    links_.coverPeople(indexInPair);
+    return indexInPair;
+}
+
+void PartnerLinks::PairingHooks::uncoverOption(int indexInPair) {
+    links_.uncoverPairing(indexInPair);
+}
+
+bool PartnerLinks::PairingHooks::isPruned(int depthTag) const {
+    return links_.isPruned(depthTag);
+}
+
+int PartnerLinks::PairingHooks::chooseOptions(std::vector<int>& options) {
+    return links_.chooseOptions(options);
+}
+
+void PartnerLinks::PairingHooks::recordNogood(int depthTag) {
+    links_.recordNogood(depthTag);
+}
+
+SearchStats& PartnerLinks::PairingHooks::stats() const {
+    return links_.stats();
+}
+
+void PartnerLinks::PairingHooks::retireOption(int indexInPair) {
+    links_.retireOption(indexInPair);
+}
+
+void PartnerLinks::PairingHooks::restoreOption(int indexInPair) {
+    links_.restoreOption(indexInPair);
+}
+
+
 /* * * * * * * * * * * * *  Weighted Matching Algorithm X via Dancing Links  * * ** * * * * * * * */
 
 
 std::set<Pair> PartnerLinks::getMaxWeightMatching() {
+    std::set<Pair> pairs = {};
+    getMaxWeightMatching(pairs, SearchLimits());
+    return pairs;
+}
+
+SearchStatus PartnerLinks::getMaxWeightMatching(std::set<Pair>& pairs, const SearchLimits& limits) {
     if (!isWeighted_) {
         error("Asking for max weight matching of a graph with no weight information provided.\n"
               "For weighted graphs provide a std::map<string,std::map<string,int>> representing a person\n"
               "and the weights of their preferred connections to the constructor.");
     }
-    /* In the spirit of "no copy" recursion by Knuth, we can just fill and remove from one set and
+    budget_ = SearchBudget(limits);
+    /* In the spirit of "no copy" search by Knuth, we can just fill and remove from one set and
      * record the best snapshot of pairings in the winner set. Have to profile to see if adding
-     * and removing from a set during recursion is faster than creating new sets in the stack frames
-     * of recursive calls. Possible space vs speed tradeoff?
+     * and removing from a set as we search is faster than creating new sets for every frame.
+     * Possible space vs speed tradeoff?
      */
     std::pair<int,std::set<Pair>> soFar = {};
     std::pair<int,std::set<Pair>> winner = {};
-    fillWeights(soFar, winner);
-    return winner.second;
+    bool isComplete = fillWeights(soFar, winner);
+    pairs.insert(winner.second.begin(), winner.second.end());
+    return isComplete ? SearchStatus::FOUND : SearchStatus::ABORTED;
 }
 
-void PartnerLinks::fillWeights(std::pair<int,std::set<Pair>>& soFar, std::pair<int,std::set<Pair>>& winner) {
-    if (table_[0].right == 0) {
-        return;
-    }
-
-    int chosen = chooseWeightedPerson();
-    if (chosen == -1) {
-        return;
-    }
-    // Explore every possibility without this person to see if a heavier matching exists without.
-    hidePerson(chosen);
-    fillWeights(soFar, winner);
-    unhidePerson(chosen);
-
-    // Now loop through every possible option for every combination of people available.
-    for (int cur = links_[chosen].down; cur != chosen; cur = links_[cur].down) {
-
-        // Our cover operation is able to pick up the weight and names of pair in a O(1) operation.
-        std::pair<int,Pair> match = coverWeightedPair(cur);
-        soFar.first += match.first;
-        soFar.second.insert(match.second);
-
-        // Go explore every weight that matching this pair produces
-        fillWeights(soFar, winner);
-
-        // The winner pair will copy in the weight and std::set if its the best so far.
-        if (soFar.first > winner.first) {
-            winner = soFar;
+bool PartnerLinks::fillWeights(std::pair<int,std::set<Pair>>& soFar, std::pair<int,std::set<Pair>>& winner) {
+    /* A frame whose cur is the person it chose has left that person out of the matching. Any other
+     * cur is the pairing of that person we covered, along with its weight and names to undo.
+     */
+    struct WeightFrame {
+        int person;
+        int cur;
+        std::pair<int,Pair> match;
+    };
+    // Every frame hides or pairs off at least one person so this is as deep as we go.
+    std::vector<WeightFrame> frames = {};
+    frames.reserve(numPeople_);
+    for (;;) {
+        DLX_STATS(stats_.enterNode(stats_.depth));
+        int chosen = table_[0].right == 0 ? -1 : chooseWeightedPerson();
+        // Only a node where we could still choose a person spends the budget.
+        bool isAborted = chosen != -1 && budget_.isSpent();
+        if (chosen != -1 && !isAborted) {
+            // Explore every possibility without this person to see if a heavier matching exists.
+            hidePerson(chosen);
+            frames.push_back({chosen, chosen, {}});
+            continue;
+        }
+        /* Back out of finished frames until one has another pairing to try. An aborted search
+         * backs out of every frame, still checking the matchings on the way up against the winner.
+         */
+        for (;;) {
+            if (frames.empty()) {
+                return !isAborted;
+            }
+            WeightFrame& top = frames.back();
+            if (top.cur == top.person) {
+                unhidePerson(top.person);
+            } else {
+                // The winner pair will copy in the weight and std::set if its the best so far.
+                if (soFar.first > winner.first) {
+                    DLX_STATS(stats_.solutions++);
+                    winner = soFar;
+                }
+                uncoverPairing(top.cur);
+                soFar.first -= top.match.first;
+                soFar.second.erase(top.match.second);
+            }
+            top.cur = links_[top.cur].down;
+            if (!isAborted && top.cur != top.person) {
+                // Our cover operation is able to pick up the weight and names of pair in O(1).
+                top.match = coverWeightedPair(top.cur);
+                soFar.first += top.match.first;
+                soFar.second.insert(top.match.second);
+                break;
+            }
+            frames.pop_back();
         }
-
-        // Prepare to explore the next options. Cleanup links and remove previous choice from pair.
-        uncoverPairing(cur);
-        soFar.first -= match.first;
-        soFar.second.erase(match.second);
     }
 }
 
@@ -265,14 +462,14 @@ int PartnerLinks::chooseWeightedPerson() const {
             return cur;
         }
     }
-    // Every person is alone so no more weights to explore in this recursive branch.
+    // Every person is alone so no more weights to explore in this branch.
     return -1;
 }
 
 void PartnerLinks::hidePerson(int indexInPair) {
     indexInPair = links_[indexInPair].down;
 
-    personName p1 = table_[links_[indexInPair].topOrLen];
+    personHeader p1 = table_[links_[indexInPair].topOrLen];
     table_[p1.right].left = p1.left;
     table_[p1.left].right = p1.right;
 
@@ -285,11 +482,12 @@ void PartnerLinks::hidePerson(int indexInPair) {
     links_[cur.up].down = cur.down;
     links_[cur.down].up = cur.up;
     links_[cur.topOrLen].topOrLen--;
+    DLX_STATS(stats_.mems += 9; stats_.updates += 2);
 }
 
 void PartnerLinks::unhidePerson(int indexInPair) {
     indexInPair = links_[indexInPair].down;
-    personName p1 = table_[links_[indexInPair].topOrLen];
+    personHeader p1 = table_[links_[indexInPair].topOrLen];
     table_[p1.left].right = links_[indexInPair].topOrLen;
     table_[p1.right].left = links_[indexInPair].topOrLen;
 
@@ -300,13 +498,17 @@ void PartnerLinks::unhidePerson(int indexInPair) {
     links_[cur.up].down = indexInPair;
     links_[cur.down].up = indexInPair;
     links_[cur.topOrLen].topOrLen++;
+    DLX_STATS(stats_.mems += 9);
 }
 
 std::pair<int,Pair> PartnerLinks::coverWeightedPair(int indexInPair) {
 
-    personName p1 = table_[links_[indexInPair].topOrLen];
+    int person1 = links_[indexInPair].topOrLen;
+    personHeader p1 = table_[person1];
     table_[p1.right].left = p1.left;
     table_[p1.left].right = p1.right;
+    // The same work as covering a pairing plus one mem to read its weight.
+    DLX_STATS(stats_.mems += 9; stats_.updates += 2; stats_.depth++);
 
     // p1 needs to dissapear from all other pairings.
     hidePersonPairings(indexInPair);
@@ -322,13 +524,14 @@ std::pair<int,Pair> PartnerLinks::coverWeightedPair(int indexInPair) {
         indexInPair++;
     }
 
-    personName p2 = table_[links_[indexInPair].topOrLen];
+    int person2 = links_[indexInPair].topOrLen;
+    personHeader p2 = table_[person2];
     table_[p2.right].left = p2.left;
     table_[p2.left].right = p2.right;
     // p2 needs to dissapear from all other pairings.
     hidePersonPairings(indexInPair);
 
-    result.second = {p1.name,p2.name};
+    result.second = {personNames_[person1], personNames_[person2]};
     return result;
 }
 
@@ -337,71 +540,64 @@ std::pair<int,Pair> PartnerLinks::coverWeightedPair(int indexInPair) {
 
 
 PartnerLinks::PartnerLinks(const std::map<std::string, std::set<std::string>>& possibleLinks)
-    : table_(),
-      links_(),
-      numPeople_(0),
-      numPairings_(0),
-      hasSingleton_(false),
-      isWeighted_(false) {
-
-    std::unordered_map<std::string, int> columnBuilder = {};
-
-    initializeHeaders(possibleLinks, columnBuilder);
-
-    // Begin building the rows with the negative spacer tiles and the subsequent columns.
-    int index = links_.size();
-    int spacerTitle = -1;
-
-    std::set<Pair> seenPairs = {};
-    for (const auto& p : possibleLinks) {
-
-        const std::set<std::string>& preferences = p.second;
-        if (preferences.empty()) {
-            hasSingleton_ = true;
-        }
-        setPerfectPairs(p.first, preferences, columnBuilder, seenPairs, index, spacerTitle);
-    }
-    links_.push_back({INT_MIN, index - 2, INT_MIN});
-}
+    : PartnerLinks(NetworkGraph(possibleLinks)) {}
 
 PartnerLinks::PartnerLinks(const std::map<std::string, std::map<std::string, int>>& possibleLinks)
+    : PartnerLinks(NetworkGraph(possibleLinks)) {}
+
+PartnerLinks::PartnerLinks(const NetworkGraph& possibleLinks)
     : table_(),
+      personNames_(),
       links_(),
       numPeople_(0),
       numPairings_(0),
       hasSingleton_(false),
-      isWeighted_(true) {
+      isWeighted_(possibleLinks.isWeighted()),
+      budget_(),
+      stats_(),
+      workerNodes_() {
 
-    std::unordered_map<std::string, int> columnBuilder = {};
+    std::vector<int> columnBuilder = {};
 
     initializeHeaders(possibleLinks, columnBuilder);
 
     // Begin building the rows with the negative spacer tiles and the subsequent columns.
     int index = links_.size();
+    int spacerTitle = -1;
 
-    std::set<Pair> seenPairs = {};
-    for (const auto& p : possibleLinks) {
-
-        const std::map<std::string,int>& preferences = p.second;
-        if (preferences.empty()) {
+    /* Pairings are bidirectional but usually appear in the arcs of both people. Every person keeps
+     * a cursor into their sorted arcs so later people can ask if a pairing was already made.
+     */
+    std::vector<int> pairCursor = {};
+    pairCursor.reserve(numPeople_);
+    for (int person = 0; person < numPeople_; person++) {
+        pairCursor.push_back(possibleLinks.arcsBegin(person));
+    }
+    for (int person = 0; person < numPeople_; person++) {
+        if (possibleLinks.degree(person) == 0) {
             hasSingleton_ = true;
         }
-        setWeightedPairs(p.first, preferences, columnBuilder, seenPairs, index);
+        setPairs(possibleLinks, person, columnBuilder, pairCursor, index, spacerTitle);
     }
     links_.push_back({INT_MIN, index - 2, INT_MIN});
 }
 
-void PartnerLinks::initializeHeaders(const std::map<std::string, std::set<std::string>>& possibleLinks,
-                                     std::unordered_map<std::string,int>& columnBuilder) {
+void PartnerLinks::initializeHeaders(const NetworkGraph& possibleLinks,
+                                     std::vector<int>& columnBuilder) {
     // std::set up the headers first. Lookup table and first N headers in links.
-    table_.push_back({"", 0, 1});
+    table_.reserve(possibleLinks.numVertices() + 1);
+    personNames_.reserve(possibleLinks.numVertices() + 1);
+    columnBuilder.reserve(possibleLinks.numVertices());
+    table_.push_back({0, 1});
+    personNames_.push_back("");
     links_.push_back({});
     int index = 1;
-    for (const auto& p : possibleLinks) {
+    for (int person = 0; person < possibleLinks.numVertices(); person++) {
 
-        columnBuilder[p.first] = index;
+        columnBuilder.push_back(index);
 
-        table_.push_back({p.first, index - 1, index + 1});
+        table_.push_back({index - 1, index + 1});
+        personNames_.push_back(possibleLinks.name(person));
         table_[0].left++;
         // Add the first headers for the item vector. They need count up and down.
         links_.push_back({0, index, index});
@@ -412,121 +608,63 @@ void PartnerLinks::initializeHeaders(const std::map<std::string, std::set<std::s
     table_[table_.size() - 1].right = 0;
 }
 
-void PartnerLinks::initializeHeaders(const std::map<std::string, std::map<std::string,int>>& possibleLinks,
-                                     std::unordered_map<std::string,int>& columnBuilder) {
-    // std::set up the headers first. Lookup table and first N headers in links.
-    table_.push_back({"", 0, 1});
-    links_.push_back({});
-    int index = 1;
-    for (const auto& p : possibleLinks) {
-
-        columnBuilder[p.first] = index;
-
-        table_.push_back({p.first, index - 1, index + 1});
-        table_[0].left++;
-        // Add the first headers for the item vector. They need count up and down.
-        links_.push_back({0, index, index});
-
-        numPeople_++;
+void PartnerLinks::setPairs(const NetworkGraph& possibleLinks,
+                            int person,
+                            std::vector<int>& columnBuilder,
+                            std::vector<int>& pairCursor,
+                            int& index,
+                            int& spacerTitle) {
+    for (int arc = possibleLinks.arcsBegin(person); arc < possibleLinks.arcsEnd(person); arc++) {
+        // A negative weight means we treat the partnership as if it does not exist.
+        if (isWeighted_ && possibleLinks.weight(arc) < 0) {
+            continue;
+        }
+        int partner = possibleLinks.neighbor(arc);
+        if (partner < person && isPairedEarlier(possibleLinks, partner, person, pairCursor)) {
+            continue;
+        }
+        numPairings_++;
+        // Weights are negative so we know we are on a spacer tile when found.
+        links_.push_back({isWeighted_ ? -possibleLinks.weight(arc) : spacerTitle--,
+                          index - 2,           // First item in previous option
+                          index + 2});         // Last item in current option
+        index++;
+        // The person who sorts first by name has the smaller id. We only ever have two items.
+        appendToColumn(std::min(person, partner), columnBuilder, index);
+        index++;
+        appendToColumn(std::max(person, partner), columnBuilder, index);
         index++;
     }
-    table_[table_.size() - 1].right = 0;
 }
 
-void PartnerLinks::setPerfectPairs(const std::string& person,
-                                   const std::set<std::string>& preferences,
-                                   std::unordered_map<std::string,int>& columnBuilder,
-                                   std::set<Pair>& seenPairs,
-                                   int& index,
-                                   int& spacerTitle) {
-    for (const auto& pref : preferences) {
-        Pair newPair = {person, pref};
-
-        if (!seenPairs.count(newPair)) {
-            numPairings_++;
-            // Update the count for this column.
-            links_.push_back({spacerTitle,     // Negative to mark spacer.
-                           index - 2,       // First item in previous option
-                           index + 2});     // Last item in current option
-            index++;
-            std::string sortedFirst = newPair.first();
-            links_.push_back({links_[columnBuilder[sortedFirst]].down, index, index});
-
-            // We can always access the column header with down field of last item.
-            links_[links_[columnBuilder[sortedFirst]].down].topOrLen++;
-            links_[links_[columnBuilder[sortedFirst]].down].up = index;
-            // The current node is the new tail in a vertical circular linked list for an item.
-            links_[index].up = columnBuilder[sortedFirst];
-            links_[index].down = links_[columnBuilder[sortedFirst]].down;
-            // Update the old tail to reflect the new addition of an item in its option.
-            links_[columnBuilder[sortedFirst]].down = index;
-            // Similar to a previous/current coding pattern but in an above/below column.
-            columnBuilder[sortedFirst] = index;
-
-            // Repeat the process. We only ever have two items in an option.
-            index++;
-            std::string sortedSecond = newPair.second();
-            links_.push_back({links_[columnBuilder[sortedSecond]].down, index, index});
-            links_[links_[columnBuilder[sortedSecond]].down].topOrLen++;
-            links_[links_[columnBuilder[sortedSecond]].down].up = index;
-            links_[index].up = columnBuilder[sortedSecond];
-            links_[index].down = links_[columnBuilder[sortedSecond]].down;
-            links_[columnBuilder[sortedSecond]].down = index;
-            columnBuilder[sortedSecond] = index;
-
-            // Pairings are bidirectional but might appear multiple times in std::map. Track here.
-            seenPairs.insert(newPair);
-            index++;
-            spacerTitle--;
-        }
+bool PartnerLinks::isPairedEarlier(const NetworkGraph& possibleLinks,
+                                   int partner,
+                                   int person,
+                                   std::vector<int>& pairCursor) {
+    // People are visited in increasing order so a cursor never needs to move backward.
+    int& cursor = pairCursor[partner];
+    while (cursor < possibleLinks.arcsEnd(partner) && possibleLinks.neighbor(cursor) < person) {
+        cursor++;
+    }
+    if (cursor == possibleLinks.arcsEnd(partner) || possibleLinks.neighbor(cursor) != person) {
+        return false;
     }
+    // The partner skipped this pairing if they gave it a negative weight.
+    return !isWeighted_ || possibleLinks.weight(cursor) >= 0;
 }
 
-void PartnerLinks::setWeightedPairs(const std::string& person,
-                                    const std::map<std::string,int>& preferences,
-                                    std::unordered_map<std::string,int>& columnBuilder,
-                                    std::set<Pair>& seenPairs,
-                                    int& index) {
-    for (const auto& pref : preferences) {
-        Pair newPair = {person, pref.first};
-
-        if (!seenPairs.count(newPair) && pref.second >= 0) {
-            numPairings_++;
-            // Weight is negative so we know we are on a spacer tile when found.
-            links_.push_back({-pref.second,     // Negative weight of the partnership
-                              index - 2,              // First item in previous option
-                              index + 2});            // Last item in current option
-            index++;
-            std::string sortedFirst = newPair.first();
-            links_.push_back({links_[columnBuilder[sortedFirst]].down,index, index});
-
-            // We can always access the column header with down field of last item.
-            links_[links_[columnBuilder[sortedFirst]].down].topOrLen++;
-            links_[links_[columnBuilder[sortedFirst]].down].up = index;
-            // The current node is new tail in a vertical circular linked list for an item.
-            links_[index].up = columnBuilder[sortedFirst];
-            links_[index].down = links_[columnBuilder[sortedFirst]].down;
-            // Update the old tail to reflect the new addition of an item in its option.
-            links_[columnBuilder[sortedFirst]].down = index;
-            // Similar to a previous/current coding pattern but in an above/below column.
-            columnBuilder[sortedFirst] = index;
-
-            // Repeat the process. We only ever have two items in an option.
-            index++;
-            std::string sortedSecond = newPair.second();
-            links_.push_back({links_[columnBuilder[sortedSecond]].down, index, index});
-            links_[links_[columnBuilder[sortedSecond]].down].topOrLen++;
-            links_[links_[columnBuilder[sortedSecond]].down].up = index;
-            links_[index].up = columnBuilder[sortedSecond];
-            links_[index].down = links_[columnBuilder[sortedSecond]].down;
-            links_[columnBuilder[sortedSecond]].down = index;
-            columnBuilder[sortedSecond] = index;
-
-            // Because all pairings are bidirectional, they should only apear once as options.
-            seenPairs.insert(newPair);
-            index++;
-        }
-    }
+void PartnerLinks::appendToColumn(int person, std::vector<int>& columnBuilder, int index) {
+    links_.push_back({links_[columnBuilder[person]].down, index, index});
+    // We can always access the column header with down field of last item.
+    links_[links_[columnBuilder[person]].down].topOrLen++;
+    links_[links_[columnBuilder[person]].down].up = index;
+    // The current node is the new tail in a vertical circular linked list for an item.
+    links_[index].up = columnBuilder[person];
+    links_[index].down = links_[columnBuilder[person]].down;
+    // Update the old tail to reflect the new addition of an item in its option.
+    links_[columnBuilder[person]].down = index;
+    // Similar to a previous/current coding pattern but in an above/below column.
+    columnBuilder[person] = index;
 }
 
 } // namespace DancingLinks
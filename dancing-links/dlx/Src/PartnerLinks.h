@@ -13,13 +13,17 @@
  */
 #ifndef PartnerLinks_H
 #define PartnerLinks_H
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <set>
-#include <unordered_map>
 #include <string>
 #include <vector>
 #include "GUI/SimpleTest.h"
 #include "MatchingUtilities.h"
+#include "NetworkGraph.h"
+#include "SearchLimits.h"
+#include "SearchStats.h"
 
 namespace DancingLinks {
 
@@ -49,6 +53,14 @@ public:
      */
     explicit PartnerLinks(const std::map<std::string, std::map<std::string, int>>& possibleLinks);
 
+    /**
+     * @brief PartnerLinks   builds the matrix from a compact graph of people. The world is weighted
+     *                       if the graph is, and no names are hashed while building. Both map
+     *                       constructors above simply build this graph first.
+     * @param possibleLinks  the graph of people, their partners, and optionally the weights.
+     */
+    explicit PartnerLinks(const NetworkGraph& possibleLinks);
+
     /**
      * @brief hasPerfectLinks  determines if an instance of a PartnerLinks matrix can solve the
      *                         Perfect Match problem. A perfect matching is when every person is
@@ -58,6 +70,35 @@ public:
      */
     bool hasPerfectLinks(std::set<Pair>& pairs);
 
+    /**
+     * @brief hasPerfectLinks  performs the same search as above but shares the search among
+     *                         multiple threads. Idle threads steal untried pairings from busy ones
+     *                         and all threads stop once any of them finds a perfect matching.
+     * @param pairs            the output parameter that shows the first perfect matching we found.
+     * @param numThreads       the number of threads to use. Zero or less uses all hardware threads.
+     * @return                 true if there is a perfect matching false if not.
+     */
+    bool hasPerfectLinks(std::set<Pair>& pairs, int numThreads);
+
+    /**
+     * @brief hasPerfectLinks  performs the same search as above but gives up once any limit is
+     *                         reached. An aborted search tells us nothing about the network.
+     * @param pairs            the output parameter that shows the first perfect matching we found.
+     * @param limits           the node, time, and cancellation limits for the search.
+     * @return                 FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+     */
+    SearchStatus hasPerfectLinks(std::set<Pair>& pairs, const SearchLimits& limits);
+
+    /**
+     * @brief hasPerfectLinks  performs the threaded search within the given limits. The node limit
+     *                         counts the nodes of every thread together.
+     * @param pairs            the output parameter that shows the first perfect matching we found.
+     * @param numThreads       the number of threads to use. Zero or less uses all hardware threads.
+     * @param limits           the node, time, and cancellation limits for the search.
+     * @return                 FOUND with the output filled, INFEASIBLE, or ABORTED by a limit.
+     */
+    SearchStatus hasPerfectLinks(std::set<Pair>& pairs, int numThreads, const SearchLimits& limits);
+
     /**
      * @brief getAllPerfectLinks  retrieves every configuration of a graph of people that will
      *                            produce a Perfect Matching. This is not every possible pairing
@@ -67,6 +108,36 @@ public:
      */
     std::vector<std::set<Pair>> getAllPerfectLinks();
 
+    /**
+     * @brief countPerfectLinks  counts the Perfect Matchings getAllPerfectLinks would return with
+     *                           the same search. No Pair or set is built along the way so networks
+     *                           with more matchings than fit in memory can still be counted.
+     * @return                   the number of distinct Perfect Matching configurations.
+     */
+    uint64_t countPerfectLinks();
+
+    /* A visitor sees every Perfect Matching the moment it is found as the stack of pairing ids
+     * chosen so far, valid only for the duration of the call. It returns true to keep searching.
+     */
+    using MatchingVisitor = std::function<bool(const std::vector<int>& pairings)>;
+
+    /**
+     * @brief visitPerfectLinks  runs the search of getAllPerfectLinks but hands each Perfect
+     *                           Matching to a visitor instead of keeping it. The visitor may
+     *                           stream, filter, or stop the search.
+     * @param visit              the visitor called with the pairing ids of every Perfect Matching.
+     * @return                   true if every matching was visited, false if the visitor stopped
+     *                           the search early.
+     */
+    bool visitPerfectLinks(const MatchingVisitor& visit);
+
+    /**
+     * @brief getPairing  names the two people of a pairing id given to a visitor.
+     * @param pairing     the pairing id of a partnership we chose.
+     * @return            the Pair of people partnered by this pairing.
+     */
+    Pair getPairing(int pairing) const;
+
     /**
      * @brief getMaxWeightMatching  determines the Max Weight Matching of a PartnerLinks matrix. A
      *                              Max Weight Matching is the greatest sum of edge weights we can
@@ -75,6 +146,35 @@ public:
      */
     std::set<Pair> getMaxWeightMatching();
 
+    /**
+     * @brief getMaxWeightMatching  performs the same search as above but gives up once any limit
+     *                              is reached. An aborted search still reports the heaviest
+     *                              matching it completed, which may fall short of the maximum.
+     * @param pairs                 the output parameter holding the heaviest matching we found.
+     * @param limits                the node, time, and cancellation limits for the search.
+     * @return                      FOUND with the Max Weight Matching or ABORTED by a limit.
+     */
+    SearchStatus getMaxWeightMatching(std::set<Pair>& pairs, const SearchLimits& limits);
+
+    /**
+     * @brief getSearchStats  reports the nodes, updates, mems, and solutions of every serial
+     *                        search since the last reset. Empty unless built with DLX_SEARCH_STATS.
+     * @return                the statistics Knuth keeps for his own dancing links programs.
+     */
+    const SearchStats& getSearchStats() const;
+
+    /**
+     * @brief resetSearchStats  clears the statistics so the next search is counted on its own.
+     */
+    void resetSearchStats();
+
+    /**
+     * @brief getWorkerNodes  reports how many nodes each thread entered in the last parallel search
+     *                        so callers can check how evenly work stealing spread the search.
+     * @return                the node count of each worker, empty before any parallel search.
+     */
+    const std::vector<long long>& getWorkerNodes() const;
+
 
 
 
@@ -85,7 +185,9 @@ private:
      * a header for a column topOrLen is the number of options that a person appears in. If the node
      * is in the column topOrLen is the index of the header for that column. Up down pointers are
      * indices in the array. The left right pointers are implicit because these nodes are next to
-     * one another in an array.
+     * one another in an array. Unlike DisasterLinks these stay full size for every graph. Spacers
+     * of a weighted graph hold any weight we are given, and 16 bit nodes counted the matchings of
+     * small grids no faster because three full size fields already fit the whole grid in cache.
      */
     struct personLink {
         int topOrLen;
@@ -95,10 +197,9 @@ private:
 
     /* These nodes control recursion in a seperate array. As partnerships are chosen or individual
      * people are chosen their representation in the lookup array is spliced out of a doubly linked
-     * list.
+     * list. Choosing a person walks this list at every node so the names are kept apart.
      */
-    struct personName {
-        std::string name;
+    struct personHeader {
         int left;
         int right;
     };
@@ -109,43 +210,45 @@ private:
      * problem. However, it must be given the correct information. If a Max Weight Matching is
      * desired, it must have the weights of every partnership in the network.
      */
-    std::vector<personName> table_;
+    std::vector<personHeader> table_;
+    // The name of the person at each header index, read only when we report a pairing.
+    std::vector<std::string> personNames_;
     std::vector<personLink> links_;
     int numPeople_;                  // Total people in the network.
     int numPairings_;                // The number of pairings or rows in the matrix.
     bool hasSingleton_;              // No perfect matching if someone is alone.
     bool isWeighted_;                // Must provide weights to ask for max weight matching.
+    SearchBudget budget_;            // Spent by the perfect and max weight searches to bound them.
+    mutable SearchStats stats_;      // Choosing a person spends mems so the counts may change.
+    std::vector<long long> workerNodes_;  // Nodes of each thread in the last parallel search.
 
 
     /* * * * * * * * * * * *    Core Functionality for Algorithm X     * * *  * * * * * * * * * * */
 
 
     /**
-     * @brief isPerfectMatching  finds the first available Perfect Matching for a network. The set
-     *                           is empty if no matching is found.
-     * @param pairs              the output parameter of the found matching.
-     * @return                   true if the matching is found, false if not.
-     */
-    bool isPerfectMatching(std::set<Pair>& pairs);
-
-    /**
-     * @brief fillPerfectMatchings  finds all available Perfect Matchings for a network. Fills the
-     *                              sets that complete this task as pass by reference output
-     *                              parameters. Every Perfect Matching configuration is unique.
-     * @param soFar                 the helper set we insert/delete from as we build Matchings.
-     * @param result                the output parameter we fill with any Perfect Matchings we find.
+     * @brief visitPerfectMatchings  finds all Perfect Matchings of a network with the explicit
+     *                               IterativeSearch stack. Pairings are covered by id and
+     *                               never named as we go.
+     * @param visit                  called with the pairing ids at every matching. False stops
+     *                               the search.
+     * @return                       true if the search ran to the end, false if it was stopped.
      */
-    void fillPerfectMatchings(std::set<Pair>& soFar, std::vector<std::set<Pair>>& result);
+    template <typename Visit>
+    bool visitPerfectMatchings(const Visit& visit);
 
     /**
-     * @brief fillWeights  recusively finds the maximum weight pairings possible given a dancing
-     *                     links network with weighted partners. Uses the soFar set to store all
-     *                     possible pairing combinations while the winner output parameter tracks
-     *                     snapshots of the best weight and pairs found so far.
+     * @brief fillWeights  finds the maximum weight pairings possible given a dancing links network
+     *                     with weighted partners. A frame of its stack either leaves the person it
+     *                     chose out of the matching or pairs them, and a person is always left out
+     *                     before we try their pairings. The soFar pair holds the pairings of the
+     *                     frames while the winner output parameter tracks snapshots of the best
+     *                     weight and pairs found so far. Every node we choose at spends the budget.
      * @param soFar        the pair of weight and pairs we fill with every possible pairing.
      * @param winner       the pair of weight and pairs that records the best weight found.
+     * @return             true if the search ran to the end, false if the budget ran out.
      */
-    void fillWeights(std::pair<int,std::set<Pair>>& soFar, std::pair<int,std::set<Pair>>& winner);
+    bool fillWeights(std::pair<int,std::set<Pair>>& soFar, std::pair<int,std::set<Pair>>& winner);
 
     /**
      * @brief choosePerson  chooses a person for the Perfect Matching algorithm. It will simply
@@ -178,6 +281,12 @@ private:
      */
     Pair coverPairing(int indexInPair);
 
+    /**
+     * @brief coverPeople  covers a pairing just as coverPairing does without naming the Pair.
+     * @param indexInPair  the index of the pair we want to cover.
+     */
+    void coverPeople(int indexInPair);
+
     /**
      * @brief uncoverPairing  uncovers a pairing that was hidden in Perfect Matching or Max Weight
      *                        Matching. The uncovering process is identical across both algorithms.
@@ -236,66 +345,126 @@ private:
      *                     need to move left or right.
      * @param indexInPair  the current partner.
      */
-    inline int toPairIndex(int indexInPair);
+    inline int toPairIndex(int indexInPair) const;
 
 
-    /* * * * * * * * * *   Build and Initialize Dancing Links Data Structure    * * * * * * * * * */
+    /* * * * * * * * * *        Hooks for the Parallel Search Driver          * * * * * * * * * */
 
 
+    /* The IterativeSearch stack steps this network for the perfect matching search, ParallelSearch,
+     * and generators. There is no depth limit for perfect matching so the depth tag is ignored.
+     * We keep no nogoods or bounds. A person no one can reach any longer is found as we choose.
+     */
+
+    bool isSolved() const;
+    int chooseItem() const;
+    int nextOption(int indexInPair) const;
+    Pair coverOption(int indexInPair, int depthTag);
+    void uncoverOption(int indexInPair);
+    bool isPruned(int depthTag) const;
+    void recordNogood(int depthTag);
+    SearchStats& stats() const;
+
     /**
-     * @brief initializeHeaders  initializes the headers of the dancing link data structure if
-     *                           given a map of pairs with no weights.
-     * @param possibleLinks      the map of unweighted connections for every person in the graph.
-     * @param columnBuilder      the helping data structure we use to build columns in one array.
+     * @brief chooseOptions  chooses the person with the fewest partners and appends every pairing
+     *                       that could partner them in the order of their column.
+     * @param options        the list of options for every node on the path. We add this node's.
+     * @return               the person we chose, or -1 if someone can no longer be partnered.
      */
-    void initializeHeaders(const std::map<std::string, std::set<std::string>>& possibleLinks,
-                           std::unordered_map<std::string,int>& columnBuilder);
+    int chooseOptions(std::vector<int>& options);
+    // The SolutionGenerator also retires options it has exhausted so no solution repeats.
+    void retireOption(int indexInPair);
+    void restoreOption(int indexInPair);
 
     /**
-     * @brief initializeHeaders  initializes the headers of the dancing link data structure if
-     *                           given a map of pairs with weights. Negative weights are ignored
-     *                           and no pairing is made for that negative match.
-     * @param possibleLinks      the map of weighted matches for every person in the graph.
-     * @param columnBuilder      the helping data structure we use to build columns in one array.
+     * @brief withHooks  runs a step of the IterativeSearch stack. This network is its own hooks.
+     * @param step       the step to run given the hooks it should use.
+     * @return           whatever the step returns.
      */
-    void initializeHeaders(const std::map<std::string, std::map<std::string,int>>& possibleLinks,
-                           std::unordered_map<std::string,int>& columnBuilder);
+    template <typename Step>
+    auto withHooks(const Step& step) -> decltype(step(*this)) {
+        return step(*this);
+    }
+
+    /* The enumerations visit pairing ids rather than Pairs, so their stack covers options with
+     * these hooks instead. They are the hooks of the network except that nothing is named.
+     */
+    class PairingHooks {
+    public:
+        explicit PairingHooks(PartnerLinks& links);
+        bool isSolved() const;
+        int chooseItem() const;
+        int nextOption(int indexInPair) const;
+        int coverOption(int indexInPair, int depthTag);
+        void uncoverOption(int indexInPair);
+        bool isPruned(int depthTag) const;
+        int chooseOptions(std::vector<int>& options);
+        void recordNogood(int depthTag);
+        SearchStats& stats() const;
+        void retireOption(int indexInPair);
+        void restoreOption(int indexInPair);
+        template <typename Step>
+        auto withHooks(const Step& step) -> decltype(step(*this)) {
+            return step(*this);
+        }
+    private:
+        PartnerLinks& links_;
+    };
+
+
+    /* * * * * * * * * *   Build and Initialize Dancing Links Data Structure    * * * * * * * * * */
+
+
+    /**
+     * @brief initializeHeaders  initializes the headers of the dancing link data structure from the
+     *                           compact graph of people, weighted or not.
+     * @param possibleLinks      the graph of connections for every person.
+     * @param columnBuilder      the last index of each person's column so far, indexed by id.
+     */
+    void initializeHeaders(const NetworkGraph& possibleLinks, std::vector<int>& columnBuilder);
 
     /**
-     * @brief setPerfectPairs  creates the internal rows and columns of the dancing links data
-     *                         structure. Perfect pairs do not have any weight information and
-     *                         options will simply be given a number from 1 to N number of matches.
+     * @brief setPairs         creates the internal rows and columns of the dancing links data
+     *                         structure for every pairing a person offers that was not already made.
+     *                         Perfect pairs are numbered from 1 to N matches in their spacers.
+     *                         Weighted pairs place their weight as a negative topOrLen in the
+     *                         spacer instead. Negative weights are ignored and no pairing made.
+     * @param possibleLinks    the graph of connections for every person.
      * @param person           the person who will set all possible matches for.
-     * @param preferences      the set of all people this person is willing to pair with.
-     * @param columnBuilder    the structure we use to track and build all columns in one array.
-     * @param seenPairs        helper set to keep pairings unique and bidirectional.
+     * @param columnBuilder    the last index of each person's column so far, indexed by id.
+     * @param pairCursor       where each person's search for earlier pairings left off.
      * @param index            we advance the index as an output parameter.
-     * @param spacerTitle      we advance the spacerTitle to number each option.
-     */
-    void setPerfectPairs(const std::string& person,
-                         const std::set<std::string>& preferences,
-                         std::unordered_map<std::string,int>& columnBuilder,
-                         std::set<Pair>& seenPairs,
-                         int& index,
-                         int& spacerTitle);
-
-    /**
-     * @brief setWeightedPairs  creates the internal rows and columns of the dancing links data
-     *                          structure. Weighted Pairs have weights for each partnership that
-     *                          are placed as negative topOrLen fields in the spacer for each row.
-     *                          We can then get the weight and names of any partnership while
-     *                          recursing easily. Negative weights are ignored and no pairing made.
-     * @param person            the person who's weighted matches we will set.
-     * @param preferences       the people this person can pair with and the weight of those pairs.
-     * @param columnBuilder     the structure we use to track and build all columns in one array.
-     * @param seenPairs         helper set to keep pairings unique and bidirectional.
-     * @param index             we advance the index as an output parameter.
-     */
-    void setWeightedPairs(const std::string& person,
-                          const std::map<std::string,int>& preferences,
-                          std::unordered_map<std::string,int>& columnBuilder,
-                          std::set<Pair>& seenPairs,
-                          int& index);
+     * @param spacerTitle      we advance the spacerTitle to number each unweighted option.
+     */
+    void setPairs(const NetworkGraph& possibleLinks,
+                  int person,
+                  std::vector<int>& columnBuilder,
+                  std::vector<int>& pairCursor,
+                  int& index,
+                  int& spacerTitle);
+
+    /**
+     * @brief isPairedEarlier  checks if a partner who came before a person already made their
+     *                         pairing. The cursor of the partner only moves forward so checking
+     *                         every pairing costs one pass over the arcs in total.
+     * @param possibleLinks    the graph of connections for every person.
+     * @param partner          the earlier person whose arcs we search.
+     * @param person           the person we hope to find among the partner's arcs.
+     * @param pairCursor       where each person's search for earlier pairings left off.
+     * @return                 true if the partner already created this pairing.
+     */
+    bool isPairedEarlier(const NetworkGraph& possibleLinks,
+                         int partner,
+                         int person,
+                         std::vector<int>& pairCursor);
+
+    /**
+     * @brief appendToColumn  adds one item to the bottom of a person's column at the end of links.
+     * @param person          the id of the person we add to their column.
+     * @param columnBuilder   the last index of each person's column so far, indexed by id.
+     * @param index           the index of links at which the new item is placed.
+     */
+    void appendToColumn(int person, std::vector<int>& columnBuilder, int index);
 
 
     /* * * * * * * * * * * * *  Overloaded Debugging Operators  * * * * * * * * * * * * * * * * * */
@@ -303,13 +472,16 @@ private:
 
     friend bool operator==(const personLink& lhs, const personLink& rhs);
     friend bool operator!=(const personLink& lhs, const personLink& rhs);
-    friend bool operator==(const personName& lhs, const personName& rhs);
-    friend bool operator!=(const personName& lhs, const personName& rhs);
+    friend bool operator==(const personHeader& lhs, const personHeader& rhs);
+    friend bool operator!=(const personHeader& lhs, const personHeader& rhs);
     friend std::ostream& operator<<(std::ostream& os, const personLink& city);
-    friend std::ostream& operator<<(std::ostream& os, const personName& city);
+    friend std::ostream& operator<<(std::ostream& os, const personHeader& city);
     friend std::ostream& operator<<(std::ostream&os, const std::vector<personLink>& links);
-    friend std::ostream& operator<<(std::ostream&os, const std::vector<personName>& table);
+    friend std::ostream& operator<<(std::ostream&os, const std::vector<personHeader>& table);
     friend std::ostream& operator<<(std::ostream&os, const PartnerLinks& links);
+    template <typename Links, typename Option> friend class IterativeSearch;
+    template <typename Links, typename Option> friend class ParallelSearch;
+    template <typename Links, typename Option> friend class SolutionGenerator;
     // I need to test the internals of the dlx instance so leave this here.
     ALLOW_TEST_ACCESS();
 };
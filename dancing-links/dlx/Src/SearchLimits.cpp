@@ -0,0 +1,56 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: SearchLimits.cpp
+ * --------------------------
+ * This file contains the implementation of the budget a cover search spends. Only the occasional
+ * check of every limit lives here. Counting nodes stays in the header so it can be inlined.
+ */
+#include <algorithm>
+#include "SearchLimits.h"
+
+namespace DancingLinks {
+
+
+SearchBudget::SearchBudget()
+    : SearchBudget(SearchLimits()) {}
+
+SearchBudget::SearchBudget(const SearchLimits& limits, std::atomic<long long>* sharedNodes)
+    : limits_(limits),
+      sharedNodes_(sharedNodes),
+      nodes_(0),
+      reportedNodes_(0),
+      nextCheck_(1),
+      isAborted_(false) {
+    limits_.checkInterval = std::max(1, limits_.checkInterval);
+}
+
+bool SearchBudget::checkLimits() {
+    if (isAborted_) {
+        return true;
+    }
+    long long totalNodes = nodes_;
+    if (sharedNodes_) {
+        totalNodes = sharedNodes_->fetch_add(nodes_ - reportedNodes_) + nodes_ - reportedNodes_;
+        reportedNodes_ = nodes_;
+    }
+    bool isTimed = limits_.deadline != std::chrono::steady_clock::time_point::max();
+    if (totalNodes > limits_.maxNodes
+            || (limits_.cancel && limits_.cancel->load(std::memory_order_relaxed))
+            || (isTimed && std::chrono::steady_clock::now() >= limits_.deadline)) {
+        isAborted_ = true;
+        // Every later node lands here and is turned away immediately.
+        nextCheck_ = 0;
+        return true;
+    }
+    // A lone budget with nothing to poll only needs to wake up on the node that breaks the limit.
+    if (!sharedNodes_ && !isTimed && !limits_.cancel) {
+        nextCheck_ = limits_.maxNodes < std::numeric_limits<long long>::max() ? limits_.maxNodes + 1
+                                                                            : limits_.maxNodes;
+    } else {
+        nextCheck_ = nodes_ + std::min<long long>(limits_.checkInterval,
+                                                  limits_.maxNodes - totalNodes + 1);
+    }
+    return false;
+}
+
+} // namespace DancingLinks
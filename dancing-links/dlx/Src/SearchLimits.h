@@ -0,0 +1,108 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: SearchLimits.h
+ * --------------------------
+ * This file defines the limits we may place on a cover search and the budget a solver spends as
+ * it searches. Some networks are far too hard to search in full, so a caller can bound a search by
+ * the number of nodes it enters, by a deadline on the clock, or by a flag another thread raises to
+ * cancel it. A search that runs out of budget unwinds every choice it made and reports that it was
+ * aborted, which is different from proving that no cover exists.
+ *
+ * Counting a node is one increment and one comparison. The clock and the cancellation flag are
+ * only read every few nodes because reading them on every node would cost more than the node. A
+ * budget never records anything a search proves, so the solvers must take care not to remember an
+ * aborted subtree as infeasible.
+ */
+#ifndef SEARCHLIMITS_H
+#define SEARCHLIMITS_H
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include "GUI/SimpleTest.h"
+
+namespace DancingLinks {
+
+/* A default SearchLimits places no limit at all. Set only the fields you need. The node limit is
+ * shared by every thread of a parallel search and may be exceeded by a few check intervals there.
+ */
+struct SearchLimits {
+    long long maxNodes = std::numeric_limits<long long>::max();
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    const std::atomic<bool>* cancel = nullptr;
+    int checkInterval = 1024;
+};
+
+enum class SearchStatus {
+    FOUND,
+    INFEASIBLE,
+    ABORTED
+};
+
+class SearchBudget {
+
+public:
+
+    /**
+     * @brief SearchBudget  prepares a budget with no limits so a search never aborts.
+     */
+    SearchBudget();
+
+    /**
+     * @brief SearchBudget  prepares a budget that will abort a search once any limit is reached.
+     * @param limits        the node, time, and cancellation limits for the search.
+     * @param sharedNodes   the node count of every thread searching together, or nullptr if this
+     *                      budget is the only one spent on the search.
+     */
+    explicit SearchBudget(const SearchLimits& limits,
+                          std::atomic<long long>* sharedNodes = nullptr);
+
+    /**
+     * @brief isSpent  counts one more node entered by the search and checks the limits when due.
+     *                 Once a budget is spent it stays spent.
+     * @return         true if the search must stop and unwind.
+     */
+    bool isSpent() {
+        if (++nodes_ < nextCheck_) {
+            return false;
+        }
+        return checkLimits();
+    }
+
+    /**
+     * @brief isAborted  reports if a limit stopped the search without counting a node.
+     * @return           true if the search did not finish.
+     */
+    bool isAborted() const {
+        return isAborted_;
+    }
+
+    /**
+     * @brief getNodes  the number of nodes this budget has counted.
+     * @return          nodes entered by the search spending this budget.
+     */
+    long long getNodes() const {
+        return nodes_;
+    }
+
+private:
+
+    SearchLimits limits_;
+    std::atomic<long long>* sharedNodes_;
+    long long nodes_;
+    long long reportedNodes_;
+    long long nextCheck_;
+    bool isAborted_;
+
+    /**
+     * @brief checkLimits  reads the clock and the cancellation flag, adds our nodes to the shared
+     *                     count, and decides on which node we must check again.
+     * @return             true if any limit has been reached.
+     */
+    bool checkLimits();
+
+    ALLOW_TEST_ACCESS();
+};
+
+} // namespace DancingLinks
+
+#endif // SEARCHLIMITS_H
@@ -0,0 +1,82 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: SearchStats.h
+ * --------------------------
+ * This file defines the statistics a solver may keep about its own searches. Following Knuth, we
+ * count the nodes entered at every depth of the search tree, the updates made to the links, the
+ * memory accesses or mems spent on the links, and the solutions found. Nodes per depth show the
+ * shape of a search tree, and mems are a measure of work that does not depend on the machine.
+ *
+ *      - A node is one call of a recursive search or one step of the IterativeSearch stack,
+ *        counted at the depth of the choices above it.
+ *      - An update is one node spliced out of a list. Putting it back is not counted again.
+ *      - A mem is one read or write of a node record of the grid or the lookup table. A record
+ *        copied out once and used many times is counted once.
+ *      - A solution is one cover or matching reported by the search.
+ *
+ * Counting costs as much as some of the work it counts so it is off unless the program is built
+ * with DLX_SEARCH_STATS defined. Every count is wrapped in DLX_STATS so that without the switch the
+ * statement is never compiled and the solvers are exactly as they were. The statistics then stay
+ * empty. Counts accumulate over every search a solver runs until resetSearchStats is called.
+ * Parallel searches count in the copies each thread owns so only serial searches are reported.
+ */
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+#include <vector>
+
+#ifdef DLX_SEARCH_STATS
+#define DLX_STATS(statement) statement
+#else
+#define DLX_STATS(statement) do {} while (false)
+#endif
+
+namespace DancingLinks {
+
+struct SearchStats {
+    // Nodes entered at each depth. Depth zero is the node where every search starts.
+    std::vector<long long> nodesPerDepth = {};
+    long long updates = 0;
+    long long mems = 0;
+    long long solutions = 0;
+    // The depth of the current node for a search that does not keep its choices on a stack.
+    int depth = 0;
+
+    /**
+     * @brief enterNode  counts one more node of the search at the given depth.
+     * @param depth      the number of choices made above this node.
+     */
+    void enterNode(int depth) {
+        if (depth >= (int)nodesPerDepth.size()) {
+            nodesPerDepth.resize(depth + 1, 0);
+        }
+        nodesPerDepth[depth]++;
+    }
+
+    /**
+     * @brief getNodes  the nodes entered at every depth together.
+     * @return          the size of the search tree.
+     */
+    long long getNodes() const {
+        long long total = 0;
+        for (long long nodes : nodesPerDepth) {
+            total += nodes;
+        }
+        return total;
+    }
+
+    /**
+     * @brief isEnabled  reports if this program was built to count anything at all.
+     * @return           true if DLX_SEARCH_STATS is defined.
+     */
+    static constexpr bool isEnabled() {
+#ifdef DLX_SEARCH_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+} // namespace DancingLinks
+
+#endif // SEARCHSTATS_H
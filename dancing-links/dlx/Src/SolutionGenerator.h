@@ -0,0 +1,103 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: SolutionGenerator.h
+ * --------------------------
+ * This file contains a resumable search over the DisasterLinks, DisasterTags, and PartnerLinks
+ * classes. The enumerations of those classes find every solution before they return, which is
+ * a long wait for the first one on a large map. A generator instead steps the IterativeSearch
+ * stack of frames shared with the ParallelSearch driver and simply stops whenever it reaches a
+ * solution. The stack is kept between calls, so asking for the next solution picks up exactly
+ * where the last one was found and the total never needs to be enumerated.
+ *
+ * Solutions are generated once each in the same order as the unique enumerations of the solvers.
+ * Once every solution beneath an option has been yielded that option is retired for its siblings
+ * and restored when we back out of their frame. The bounds and nogoods of the solver still cut
+ * nodes with no solution beneath them, but the order we try options in is never changed. Every
+ * option of a perfect matching covers the person we chose, so PartnerLinks has nothing to retire
+ * and its hooks do nothing.
+ *
+ * Because this is a template it lives entirely in this header. A solver must befriend the
+ * generator and IterativeSearch and provide the hooks ParallelSearch needs along with the
+ * following private members.
+ *
+ *      void retireOption(int indexInOption);
+ *      void restoreOption(int indexInOption);    // In the reverse order options were retired.
+ */
+#ifndef SOLUTIONGENERATOR_H
+#define SOLUTIONGENERATOR_H
+#include <vector>
+#include "IterativeSearch.h"
+
+namespace DancingLinks {
+
+template <typename Links, typename Option>
+class SolutionGenerator {
+
+public:
+
+
+    /**
+     * @brief SolutionGenerator  prepares to generate the solutions of a solver one at a time. The
+     *                           generator searches its own copy so the solver we are given is left
+     *                           unchanged and the generator may be abandoned at any point.
+     * @param links              the fully built solver whose solutions we want.
+     * @param depthLimit         the limit on how many options a solution may choose. A perfect
+     *                           matching chooses half the people so any larger limit is the same.
+     */
+    SolutionGenerator(const Links& links, int depthLimit)
+        : links_(links),
+          search_(depthLimit, SearchMode::UNIQUE),
+          isStarted_(false),
+          isExhausted_(false) {}
+
+    /**
+     * @brief next      resumes the search until it finds the next solution.
+     * @param solution  the output parameter holding the options of the solution found, in the
+     *                  order they were chosen. Its old contents are replaced.
+     * @return          true if another solution was found, false once every one has been yielded.
+     */
+    bool next(std::vector<Option>& solution) {
+        if (isExhausted_) {
+            return false;
+        }
+        return links_.withHooks([&](auto& hooks) {
+            // We stopped at a solution last time so there is nothing more to find beneath it.
+            if (isStarted_ && !search_.advance(hooks)) {
+                isExhausted_ = true;
+                return false;
+            }
+            isStarted_ = true;
+            for (;;) {
+                if (hooks.isSolved()) {
+                    solution = search_.chosen();
+                    return true;
+                }
+                if (!search_.descend(hooks) && !search_.advance(hooks)) {
+                    isExhausted_ = true;
+                    return false;
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief isExhausted  reports if every solution has already been yielded.
+     * @return             true if next will never find another solution.
+     */
+    bool isExhausted() const {
+        return isExhausted_;
+    }
+
+
+private:
+
+
+    Links links_;
+    IterativeSearch<Links,Option> search_;
+    bool isStarted_;
+    bool isExhausted_;
+};
+
+} // namespace DancingLinks
+
+#endif // SOLUTIONGENERATOR_H
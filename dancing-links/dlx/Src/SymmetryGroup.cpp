@@ -0,0 +1,237 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: SymmetryGroup.cpp
+ * --------------------------
+ * This file contains the implementation of the symmetries of a transportation network. See the
+ * header for how we find them and why we keep every element of the group.
+ */
+#include <algorithm>
+#include <map>
+#include <set>
+#include "SymmetryGroup.h"
+
+namespace DancingLinks {
+
+namespace {
+
+// Detection gives up after this many placements so a graph that defeats refinement stays cheap.
+constexpr long long PLACEMENT_BUDGET = 1 << 20;
+
+std::vector<int> identity(int numVertices) {
+    std::vector<int> elem(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        elem[v] = v;
+    }
+    return elem;
+}
+
+} // namespace
+
+
+/* * * * * * * * * * * * * * * * *     Building the Symmetry Group    * * * * * * * * * * * * * * */
+
+
+SymmetryGroup::SymmetryGroup(int numVertices)
+    : numVertices_(numVertices),
+      elements_({identity(numVertices)}),
+      isComplete_(true) {}
+
+SymmetryGroup::SymmetryGroup(const NetworkGraph& graph, int maxSize)
+    : numVertices_(graph.numVertices()),
+      elements_({identity(graph.numVertices())}),
+      isComplete_(true) {
+    std::vector<int> classes = refineClasses(graph);
+
+    // Placing the neighbors of placed cities first lets the roads between them reject bad images.
+    std::vector<int> order = {};
+    order.reserve(numVertices_);
+    std::vector<bool> isQueued(numVertices_, false);
+    for (int start = 0; start < numVertices_; start++) {
+        if (isQueued[start]) {
+            continue;
+        }
+        isQueued[start] = true;
+        order.push_back(start);
+        for (int next = order.size() - 1; next < (int)order.size(); next++) {
+            int city = order[next];
+            for (int arc = graph.arcsBegin(city); arc < graph.arcsEnd(city); arc++) {
+                int neighbor = graph.neighbor(arc);
+                if (!isQueued[neighbor]) {
+                    isQueued[neighbor] = true;
+                    order.push_back(neighbor);
+                }
+            }
+        }
+    }
+    std::vector<int> images(numVertices_, -1);
+    std::vector<int> preimages(numVertices_, -1);
+    long long budget = PLACEMENT_BUDGET;
+    placeCities(graph, classes, order, 0, images, preimages, maxSize, budget);
+}
+
+SymmetryGroup::SymmetryGroup(const NetworkGraph& graph,
+                             const std::vector<std::vector<int>>& generators,
+                             int maxSize)
+    : numVertices_(graph.numVertices()),
+      elements_({identity(graph.numVertices())}),
+      isComplete_(true) {
+    for (const std::vector<int>& generator : generators) {
+        if ((int)generator.size() != numVertices_) {
+            error("A symmetry must give an image for every city.");
+        }
+        std::vector<bool> isImage(numVertices_, false);
+        for (int image : generator) {
+            if (image < 0 || image >= numVertices_ || isImage[image]) {
+                error("A symmetry must map the cities one to one onto the cities.");
+            }
+            isImage[image] = true;
+        }
+        for (int city = 0; city < numVertices_; city++) {
+            for (int arc = graph.arcsBegin(city); arc < graph.arcsEnd(city); arc++) {
+                if (!isRoad(graph, generator[city], generator[graph.neighbor(arc)])) {
+                    error("A symmetry must map every road onto a road.");
+                }
+            }
+        }
+    }
+    // Multiplying every element we have by every generator eventually reaches the whole group.
+    std::set<std::vector<int>> found = {elements_.front()};
+    for (int next = 0; next < (int)elements_.size() && isComplete_; next++) {
+        for (const std::vector<int>& generator : generators) {
+            std::vector<int> product(numVertices_);
+            for (int city = 0; city < numVertices_; city++) {
+                product[city] = generator[elements_[next][city]];
+            }
+            if (found.count(product)) {
+                continue;
+            }
+            if ((int)elements_.size() == maxSize) {
+                isComplete_ = false;
+                break;
+            }
+            found.insert(product);
+            elements_.push_back(std::move(product));
+        }
+    }
+}
+
+int SymmetryGroup::size() const {
+    return elements_.size();
+}
+
+int SymmetryGroup::numVertices() const {
+    return numVertices_;
+}
+
+bool SymmetryGroup::isComplete() const {
+    return isComplete_;
+}
+
+const std::vector<int>& SymmetryGroup::getElement(int index) const {
+    return elements_[index];
+}
+
+
+/* * * * * * * * * * * * * * * * *        Detecting Symmetries        * * * * * * * * * * * * * * */
+
+
+std::vector<int> SymmetryGroup::refineClasses(const NetworkGraph& graph) {
+    int numVertices = graph.numVertices();
+    std::vector<int> classes(numVertices);
+    for (int city = 0; city < numVertices; city++) {
+        classes[city] = graph.degree(city);
+    }
+    int numClasses = 0;
+    while (true) {
+        // A city's signature is its class followed by the sorted classes of its neighbors.
+        std::map<std::vector<int>, int> signatures = {};
+        std::vector<int> refined(numVertices);
+        for (int city = 0; city < numVertices; city++) {
+            std::vector<int> signature = {classes[city]};
+            for (int arc = graph.arcsBegin(city); arc < graph.arcsEnd(city); arc++) {
+                signature.push_back(classes[graph.neighbor(arc)]);
+            }
+            std::sort(signature.begin() + 1, signature.end());
+            refined[city] = signatures.emplace(signature, signatures.size()).first->second;
+        }
+        classes = refined;
+        // Classes only ever split so the same number of them means nothing split.
+        if ((int)signatures.size() == numClasses) {
+            return classes;
+        }
+        numClasses = signatures.size();
+    }
+}
+
+bool SymmetryGroup::isRoad(const NetworkGraph& graph, int from, int to) {
+    int begin = graph.arcsBegin(from);
+    int end = graph.arcsEnd(from);
+    while (begin < end) {
+        int mid = begin + (end - begin) / 2;
+        if (graph.neighbor(mid) < to) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return begin < graph.arcsEnd(from) && graph.neighbor(begin) == to;
+}
+
+bool SymmetryGroup::isConsistent(const NetworkGraph& graph,
+                                 int city,
+                                 int image,
+                                 const std::vector<int>& images,
+                                 const std::vector<int>& preimages) {
+    for (int arc = graph.arcsBegin(city); arc < graph.arcsEnd(city); arc++) {
+        int placed = images[graph.neighbor(arc)];
+        if (placed != -1 && !isRoad(graph, image, placed)) {
+            return false;
+        }
+    }
+    for (int arc = graph.arcsBegin(image); arc < graph.arcsEnd(image); arc++) {
+        int placed = preimages[graph.neighbor(arc)];
+        if (placed != -1 && !isRoad(graph, city, placed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SymmetryGroup::placeCities(const NetworkGraph& graph,
+                                const std::vector<int>& classes,
+                                const std::vector<int>& order,
+                                int depth,
+                                std::vector<int>& images,
+                                std::vector<int>& preimages,
+                                int maxSize,
+                                long long& budget) {
+    if (depth == numVertices_) {
+        if (images == elements_.front()) {
+            return;
+        }
+        if ((int)elements_.size() == maxSize) {
+            isComplete_ = false;
+            return;
+        }
+        elements_.push_back(images);
+        return;
+    }
+    int city = order[depth];
+    for (int image = 0; image < numVertices_ && isComplete_; image++) {
+        if (classes[image] != classes[city] || preimages[image] != -1
+                || !isConsistent(graph, city, image, images, preimages)) {
+            continue;
+        }
+        if (--budget < 0) {
+            isComplete_ = false;
+            return;
+        }
+        images[city] = image;
+        preimages[image] = city;
+        placeCities(graph, classes, order, depth + 1, images, preimages, maxSize, budget);
+        images[city] = -1;
+        preimages[image] = -1;
+    }
+}
+
+} // namespace DancingLinks
@@ -0,0 +1,150 @@
+/**
+ * Author: Alexander G. Lopez
+ * File: SymmetryGroup.h
+ * --------------------------
+ * This file defines the symmetries of a transportation network. A symmetry, or automorphism, is a
+ * renaming of the cities that maps every road onto a road. A grid of cities has eight of them: four
+ * rotations and four reflections. Supplying a set of cities covers the network exactly when
+ * supplying its image under any symmetry does, so a search that has tried one of two mirror image
+ * choices learns everything the other could teach it. The disaster solvers use these symmetries to
+ * skip branches that are images of branches they have already searched.
+ *
+ * We store every element of the group, not just a few generators of it, because the searches must
+ * ask which symmetries fix the choices made so far. Networks with huge groups, like a hub with
+ * dozens of interchangeable dead end towns, would need far too many elements, so the group stops
+ * growing at a limit. A partial group still holds only true symmetries and is safe to skip
+ * branches with, but it is not closed, so anything that counts by the size of orbits needs the
+ * group to be complete.
+ *
+ *      - Detection refines the cities into classes that no symmetry could mix, starting from their
+ *        degrees and splitting classes by the classes of their neighbors until nothing splits. It
+ *        then backtracks over images for the cities in breadth first order, checking every road
+ *        to the cities already placed. Every complete placement is a symmetry.
+ *      - A caller who knows the symmetries of a network may give generators instead. Each one is
+ *        checked against the roads and the group is every product of them.
+ */
+#ifndef SYMMETRYGROUP_H
+#define SYMMETRYGROUP_H
+#include <vector>
+#include "GUI/SimpleTest.h"
+#include "NetworkGraph.h"
+
+namespace DancingLinks {
+
+class SymmetryGroup {
+
+public:
+
+
+    /**
+     * @brief SymmetryGroup  the trivial group of a network of the given size. Only the identity
+     *                       maps every road onto a road.
+     * @param numVertices    the number of cities in the network.
+     */
+    explicit SymmetryGroup(int numVertices = 0);
+
+    /**
+     * @brief SymmetryGroup  finds every symmetry of a graph, stopping early at the size limit or if
+     *                       the backtracking grows too large.
+     * @param graph          the graph of cities connected to other cities.
+     * @param maxSize        the most elements the group may hold, the identity included.
+     */
+    explicit SymmetryGroup(const NetworkGraph& graph, int maxSize = 1 << 10);
+
+    /**
+     * @brief SymmetryGroup  builds the group generated by the given symmetries of a graph. It is
+     *                       an error if a generator is not a permutation that maps roads to roads.
+     * @param graph          the graph of cities connected to other cities.
+     * @param generators     each generator lists the image of every city by its id in the graph.
+     * @param maxSize        the most elements the group may hold, the identity included.
+     */
+    SymmetryGroup(const NetworkGraph& graph,
+                  const std::vector<std::vector<int>>& generators,
+                  int maxSize = 1 << 10);
+
+    int size() const;
+    int numVertices() const;
+
+    /**
+     * @brief isComplete  reports if the group holds every symmetry it was meant to. Detection may
+     *                    stop early and so may the products of generators.
+     * @return            true if the elements are closed under composition.
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief getElement  the image of every city under one symmetry. Element zero is the identity.
+     * @param index       the index of the symmetry from zero up to size.
+     * @return            the id of the city each city maps to.
+     */
+    const std::vector<int>& getElement(int index) const;
+
+
+private:
+
+
+    int numVertices_;
+    std::vector<std::vector<int>> elements_;
+    bool isComplete_;
+
+
+    /**
+     * @brief refineClasses  splits cities into classes that no symmetry can mix. Cities start in
+     *                       classes by degree and split by the multiset of their neighbors' classes.
+     * @param graph          the graph of cities connected to other cities.
+     * @return               the class of every city. Symmetries map cities within their class.
+     */
+    static std::vector<int> refineClasses(const NetworkGraph& graph);
+
+    /**
+     * @brief isRoad  checks if two cities share a road with a binary search of sorted neighbors.
+     * @param graph   the graph of cities connected to other cities.
+     * @param from    the id of one city.
+     * @param to      the id of the other city.
+     * @return        true if the cities are neighbors.
+     */
+    static bool isRoad(const NetworkGraph& graph, int from, int to);
+
+    /**
+     * @brief isConsistent  checks that placing a city on an image keeps every road between it and
+     *                      the cities already placed, in both directions.
+     * @param graph         the graph of cities connected to other cities.
+     * @param city          the city we are placing.
+     * @param image         the city we are placing it on.
+     * @param images        the image of every placed city or -1.
+     * @param preimages     the city placed on every image or -1.
+     * @return              true if the placement agrees with every road so far.
+     */
+    static bool isConsistent(const NetworkGraph& graph,
+                             int city,
+                             int image,
+                             const std::vector<int>& images,
+                             const std::vector<int>& preimages);
+
+    /**
+     * @brief placeCities  backtracks over the images of the cities in order, keeping every
+     *                     complete placement as a symmetry.
+     * @param graph        the graph of cities connected to other cities.
+     * @param classes      the class of every city from refinement.
+     * @param order        the order in which we place cities.
+     * @param depth        the number of cities placed so far.
+     * @param images       the image of every placed city or -1.
+     * @param preimages    the city placed on every image or -1.
+     * @param maxSize      the most elements the group may hold.
+     * @param budget       the placements we may still try before we give up.
+     */
+    void placeCities(const NetworkGraph& graph,
+                     const std::vector<int>& classes,
+                     const std::vector<int>& order,
+                     int depth,
+                     std::vector<int>& images,
+                     std::vector<int>& preimages,
+                     int maxSize,
+                     long long& budget);
+
+    ALLOW_TEST_ACCESS();
+};
+
+} // namespace DancingLinks
+
+#endif // SYMMETRYGROUP_H
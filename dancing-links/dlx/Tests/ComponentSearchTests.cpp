@@ -0,0 +1,152 @@
+#include <atomic>
+#include "Src/ComponentSearch.h"
+#include "Src/DisasterLinks.h"
+#include "Src/DisasterTags.h"
+#include "Src/DisasterUtilities.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * *   Connected Component Tests   * * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("A network splits into its regions with items and options kept in order.") {
+    /*
+     *        A----C        B----D----E
+     *
+     *                 F
+     */
+    const std::map<std::string, std::set<std::string>> islands = makeMap({
+        {"A", {"C"}},
+        {"B", {"D"}},
+        {"D", {"E"}},
+        {"F", {}},
+    });
+    Dx::CoverNetwork network{Dx::NetworkGraph(islands)};
+    std::vector<Dx::CoverNetwork> components = network.getComponents();
+    EXPECT_EQUAL(components.size(), 3);
+
+    std::vector<std::string> first = {"A", "C"};
+    std::vector<std::string> second = {"B", "D", "E"};
+    std::vector<std::string> third = {"F"};
+    EXPECT(components[0].itemNames_ == first);
+    EXPECT(components[1].itemNames_ == second);
+    EXPECT(components[2].itemNames_ == third);
+    EXPECT(components[1].optionNames_ == second);
+    // D covers B, D, and E which are numbered again from zero within their region.
+    std::vector<int> offsets = {0, 2, 5, 7};
+    std::vector<int> items = {0, 1, 0, 1, 2, 1, 2};
+    EXPECT(components[1].offsets_ == offsets);
+    EXPECT(components[1].items_ == items);
+}
+
+STUDENT_TEST("The minimum of separate regions is the sum of the minimums of each region.") {
+    std::map<std::string, std::set<std::string>> grids;
+
+    // Two 4 x 4 grids that share no roads. Each one needs 4 supplies.
+    for (char island : {'X', 'Y'}) {
+        for (char row = 'A'; row <= 'D'; row++) {
+            for (int col = 1; col <= 4; col++) {
+                std::string prefix(1, island);
+                std::string city = prefix + row + std::to_string(col);
+                grids[city];
+                if (row != 'D') {
+                    grids[city].insert(prefix + char(row + 1) + std::to_string(col));
+                }
+                if (col != 4) {
+                    grids[city].insert(prefix + row + std::to_string(col + 1));
+                }
+            }
+        }
+    }
+    grids = makeMap(grids);
+
+    Dx::CoverNetwork network{Dx::NetworkGraph(grids)};
+    Dx::ComponentSearch<Dx::DisasterLinks> linksSearch(network, 2);
+    EXPECT_EQUAL(linksSearch.numComponents(), 2);
+    std::set<std::string> linksSupplies = {};
+    EXPECT_EQUAL(linksSearch.findMinimumSupplies(linksSupplies), 8);
+    EXPECT_EQUAL(linksSupplies.size(), 8);
+
+    Dx::ComponentSearch<Dx::DisasterTags> tagsSearch(network, 0);
+    std::set<std::string> tagsSupplies = {};
+    EXPECT_EQUAL(tagsSearch.findMinimumSupplies(tagsSupplies), 8);
+    for (const auto& [city, connections] : grids) {
+        EXPECT(checkCovered(city, grids, linksSupplies));
+        EXPECT(checkCovered(city, grids, tagsSupplies));
+    }
+}
+
+STUDENT_TEST("The optimal covers of separate regions are their lazy cross product.") {
+    /*
+     *        A----B----C        W----X
+     *                           |    |
+     *                           Z----Y
+     */
+    const std::map<std::string, std::set<std::string>> regions = makeMap({
+        {"A", {"B"}},
+        {"B", {"C"}},
+        {"W", {"X", "Z"}},
+        {"Y", {"X", "Z"}},
+    });
+    Dx::CoverNetwork network{Dx::NetworkGraph(regions)};
+    Dx::ComponentSearch<Dx::DisasterLinks> search(network, 0);
+    Dx::CoverProduct covers = search.getOptimalConfigurations();
+    // The line needs B and any two cities of the square cover it, so there are six covers.
+    EXPECT_EQUAL(covers.size(), 6);
+    std::set<std::set<std::string>> lazy = {};
+    for (long long i = 0; i < covers.size(); i++) {
+        lazy.insert(covers[i]);
+    }
+
+    Dx::DisasterLinks whole(regions);
+    std::vector<std::set<std::string>> listed = whole.getUniqueDisasterConfigurations(3);
+    std::set<std::set<std::string>> expected(listed.begin(), listed.end());
+    EXPECT_EQUAL(lazy, expected);
+    EXPECT_ERROR(covers[6]);
+
+    const std::map<std::string, std::set<std::string>> noCities = {};
+    Dx::CoverNetwork empty{Dx::NetworkGraph(noCities)};
+    Dx::ComponentSearch<Dx::DisasterTags> emptySearch(empty, 0);
+    Dx::CoverProduct none = emptySearch.getOptimalConfigurations();
+    EXPECT_EQUAL(none.size(), 1);
+    EXPECT(none[0].empty());
+}
+
+STUDENT_TEST("Limits given to separate regions stop every region and report the abort.") {
+    /*
+     *        A----B----C        W----X
+     *                           |    |
+     *                           Z----Y
+     */
+    const std::map<std::string, std::set<std::string>> regions = makeMap({
+        {"A", {"B"}},
+        {"B", {"C"}},
+        {"W", {"X", "Z"}},
+        {"Y", {"X", "Z"}},
+    });
+    Dx::CoverNetwork network{Dx::NetworkGraph(regions)};
+    Dx::ComponentSearch<Dx::DisasterTags> search(network, 2);
+    std::atomic<bool> cancel(true);
+    Dx::SearchLimits cancelled;
+    cancelled.cancel = &cancel;
+    cancelled.checkInterval = 1;
+
+    // An aborted region still reports the cover it had, so the network is covered regardless.
+    std::set<std::string> supplies = {};
+    EXPECT(search.findMinimumSupplies(supplies, cancelled) == Dx::SearchStatus::ABORTED);
+    for (const auto& [city, connections] : regions) {
+        EXPECT(checkCovered(city, regions, supplies));
+    }
+    Dx::CoverProduct covers({});
+    EXPECT(search.getOptimalConfigurations(covers, cancelled) == Dx::SearchStatus::ABORTED);
+    EXPECT_EQUAL(covers.size(), 1);
+
+    cancel = false;
+    supplies.clear();
+    EXPECT(search.findMinimumSupplies(supplies, cancelled) == Dx::SearchStatus::FOUND);
+    EXPECT_EQUAL(supplies.size(), 3);
+    EXPECT(search.getOptimalConfigurations(covers, cancelled) == Dx::SearchStatus::FOUND);
+    EXPECT_EQUAL(covers.size(), 6);
+}
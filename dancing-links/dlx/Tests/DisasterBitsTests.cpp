@@ -0,0 +1,113 @@
+#include "Src/DisasterBits.h"
+#include "Src/DisasterLinks.h"
+#include "Src/DisasterUtilities.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * *      Bitset Solver Tests       * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("Cities are numbered fewest options first so the most isolated is chosen first.") {
+    /*
+     *        A----B----C----D
+     *             |
+     *             E
+     */
+    const std::map<std::string, std::set<std::string>> roads = makeMap({
+        {"A", {"B"}},
+        {"B", {"C", "E"}},
+        {"C", {"D"}},
+    });
+    Dx::DisasterBits network(roads);
+    EXPECT_EQUAL(network.numCities_, 5);
+    EXPECT_EQUAL(network.cityWords_, 4);
+    // A, D, and E are covered by two options in that order, then C by three and B by four.
+    std::vector<int> offsets = {0, 2, 4, 6, 9, 13};
+    EXPECT(network.tryOffsets_ == offsets);
+    EXPECT_EQUAL(network.chooseIsolatedCity(0), 0);
+    // B covers the most cities so every city it covers tries it first.
+    EXPECT_EQUAL(network.supplyNames_[network.tryOptions_[0]], "B");
+    EXPECT_EQUAL(network.supplyNames_[network.tryOptions_[9]], "B");
+
+    std::set<std::string> supplies = {};
+    EXPECT(!network.isDisasterReady(1, supplies));
+    EXPECT(network.isDisasterReady(2, supplies));
+    for (const auto& [city, connections] : roads) {
+        EXPECT(checkCovered(city, roads, supplies));
+    }
+}
+
+STUDENT_TEST("Bitsets spanning many words find the same minimum as the links.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    // A 9 x 9 grid has 81 cities so the uncovered cities span two words.
+    char maxRow = 'I';
+    int  maxCol = 9;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            grid[row + std::to_string(col)];
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterLinks links(grid);
+    std::set<std::string> linksSupplies = {};
+    int optimum = links.findMinimumSupplies(linksSupplies);
+
+    Dx::DisasterBits bits(grid);
+    std::set<std::string> bitsSupplies = {};
+    EXPECT_EQUAL(bits.findMinimumSupplies(bitsSupplies), optimum);
+    EXPECT_EQUAL((int)bitsSupplies.size(), optimum);
+    for (const auto& [city, connections] : grid) {
+        EXPECT(checkCovered(city, grid, bitsSupplies));
+    }
+    std::set<std::string> tooFew = {};
+    EXPECT(!bits.isDisasterReady(optimum - 1, tooFew));
+    EXPECT(tooFew.empty());
+}
+
+STUDENT_TEST("The bitsets list every configuration the links list and unique ones only once.") {
+    /*
+     *        A----B----C
+     *        |    |    |
+     *        D----E----F----G
+     */
+    const std::map<std::string, std::set<std::string>> roads = makeMap({
+        {"A", {"B", "D"}},
+        {"B", {"C", "E"}},
+        {"C", {"F"}},
+        {"D", {"E"}},
+        {"E", {"F"}},
+        {"F", {"G"}},
+    });
+    Dx::DisasterLinks links(roads);
+    Dx::DisasterBits bits(roads);
+    for (int numSupplies = 1; numSupplies <= 3; numSupplies++) {
+        std::set<std::set<std::string>> all = bits.getAllDisasterConfigurations(numSupplies);
+        EXPECT_EQUAL(all, links.getAllDisasterConfigurations(numSupplies));
+
+        std::vector<std::set<std::string>> unique = bits.getUniqueDisasterConfigurations(
+            numSupplies
+        );
+        std::set<std::set<std::string>> distinct(unique.begin(), unique.end());
+        EXPECT_EQUAL(unique.size(), distinct.size());
+        std::vector<std::set<std::string>> expected = links.getUniqueDisasterConfigurations(
+            numSupplies
+        );
+        EXPECT_EQUAL(distinct, std::set<std::set<std::string>>(expected.begin(), expected.end()));
+        EXPECT_EQUAL(bits.countDisasterConfigurations(numSupplies), unique.size());
+    }
+    EXPECT(bits.getAllDisasterConfigurations(1).empty());
+    // A visitor that stops at once must leave no option forbidden for the next search.
+    EXPECT(!bits.visitDisasterConfigurations(3, [](const std::vector<int>&) { return false; }));
+    EXPECT_EQUAL(bits.countDisasterConfigurations(3),
+                 links.getUniqueDisasterConfigurations(3).size());
+}
@@ -0,0 +1,113 @@
+#include "DancingLinks.h"
+#include "Src/DisasterUtilities.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * *    Disaster Heuristic Tests    * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("A drop removes the greedy choice every later supply made redundant.") {
+    /*
+     * Greedy takes A because it covers the most, then needs B for 5 and C for 6. Once B and C are
+     * supplied they cover everything A did.
+     *
+     *      A: 1 2 3 4
+     *      B: 1 2     5
+     *      C:     3 4   6
+     */
+    Dx::CoverNetwork network({"1", "2", "3", "4", "5", "6"},
+                             {"A", "B", "C"},
+                             {0, 4, 7, 10},
+                             {0, 1, 2, 3, 0, 1, 4, 2, 3, 5});
+    Dx::DisasterHeuristic heuristic(network);
+    std::set<std::string> supplies = {};
+    EXPECT_EQUAL(heuristic.getSupplies(supplies), 2);
+    EXPECT_EQUAL(supplies, {"B", "C"});
+    EXPECT(heuristic.getCover() == std::vector<int>({1, 2}));
+    EXPECT(heuristic.isComplete());
+    Dx::DisasterHeuristic::HeuristicCounts counts = heuristic.getCounts();
+    EXPECT_EQUAL(counts.greedySupplies, 3);
+    EXPECT_EQUAL(counts.droppedSupplies, 1);
+    EXPECT_EQUAL(counts.exchanges, 0);
+}
+
+STUDENT_TEST("A 2-for-1 exchange shrinks a greedy cover that no drop can improve.") {
+    /*
+     * Greedy supplies E, then A for D, then C for itself. No supply is redundant, but B is only
+     * covered by E. Trading E for F still covers B and now covers C, so C is redundant.
+     *
+     *        D----A----E----B
+     *                  |   /
+     *                  |  /
+     *                  F
+     *                  |
+     *                  C
+     */
+    const std::map<std::string, std::set<std::string>> cities = makeMap({
+        {"A", {"D", "E"}},
+        {"B", {"E", "F"}},
+        {"C", {"F"}},
+        {"E", {"F"}},
+    });
+    Dx::DisasterHeuristic heuristic(cities);
+    std::set<std::string> supplies = {};
+    EXPECT_EQUAL(heuristic.getSupplies(supplies), 2);
+    EXPECT_EQUAL(supplies, {"A", "F"});
+    Dx::DisasterHeuristic::HeuristicCounts counts = heuristic.getCounts();
+    EXPECT_EQUAL(counts.greedySupplies, 3);
+    EXPECT_EQUAL(counts.droppedSupplies, 0);
+    EXPECT_EQUAL(counts.exchanges, 1);
+    for (const auto& city : cities) {
+        bool isCovered = supplies.count(city.first);
+        for (const std::string& neighbor : city.second) {
+            isCovered = isCovered || supplies.count(neighbor);
+        }
+        EXPECT(isCovered);
+    }
+}
+
+STUDENT_TEST("Solvers answer approximately at once and search only for covers that beat it.") {
+    std::map<std::string, std::set<std::string>> grid;
+    for (char row = 'A'; row <= 'F'; row++) {
+        for (int col = 1; col <= 6; col++) {
+            grid[row + std::to_string(col)];
+            if (row != 'F') {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != 6) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+    Dx::DisasterLinks links(grid);
+    Dx::DisasterTags tags(grid);
+    Dx::DisasterBits bits(grid);
+    std::set<std::string> approximate = {};
+    int heuristicSize = Dx::getApproximateOverlappingCover(links, approximate);
+    EXPECT_EQUAL(heuristicSize, approximate.size());
+    std::set<std::string> fromTags = {};
+    std::set<std::string> fromBits = {};
+    EXPECT_EQUAL(tags.findApproximateSupplies(fromTags), heuristicSize);
+    EXPECT_EQUAL(bits.findApproximateSupplies(fromBits), heuristicSize);
+    EXPECT_EQUAL(fromTags, approximate);
+    EXPECT_EQUAL(fromBits, approximate);
+    std::set<std::string> proof = {};
+    EXPECT(links.isDisasterReady(heuristicSize, proof));
+
+    std::set<std::string> best = {};
+    int optimum = links.findMinimumSupplies(best);
+    EXPECT(optimum <= heuristicSize);
+    EXPECT(!links.isDisasterReady(optimum - 1, proof));
+    best.clear();
+    EXPECT_EQUAL(tags.findMinimumSupplies(best), optimum);
+    best.clear();
+    EXPECT_EQUAL(bits.findMinimumSupplies(best), optimum);
+
+    Dx::CoverNetwork unreachable({"X", "Y"}, {"X"}, {0, 1}, {0});
+    EXPECT(!Dx::DisasterHeuristic(unreachable).isComplete());
+    Dx::DisasterLinks handBuilt(unreachable);
+    EXPECT_ERROR(handBuilt.findApproximateSupplies(best));
+}
@@ -1,4 +1,5 @@
 #include "Src/DisasterLinks.h"
+#include "Src/ParallelSearch.h"
 #include "Src/DisasterUtilities.h"
 #include "GenericOverloads.h"
 
@@ -18,7 +19,7 @@ bool operator!=(const DisasterLinks::cityItem& lhs, const DisasterLinks::cityIte
 }
 
 bool operator==(const DisasterLinks::cityHeader& lhs, const DisasterLinks::cityHeader& rhs) {
-    return lhs.name == rhs.name && lhs.left == rhs.left && lhs.right == rhs.right;
+    return lhs.left == rhs.left && lhs.right == rhs.right;
 }
 
 bool operator!=(const DisasterLinks::cityHeader& lhs, const DisasterLinks::cityHeader& rhs) {
@@ -32,7 +33,7 @@ std::ostream& operator<<(std::ostream& os, const DisasterLinks::cityItem& city)
 }
 
 std::ostream& operator<<(std::ostream& os, const DisasterLinks::cityHeader& city) {
-    os << "{ name: " << city.name << ", left: " << city.left << ", right: " << city.right << " }";
+    os << "{ left: " << city.left << ", right: " << city.right << " }";
     return os;
 }
 
@@ -52,7 +53,7 @@ std::ostream& operator<<(std::ostream&os, const std::vector<DisasterLinks::cityI
 std::ostream& operator<<(std::ostream&os, const std::vector<DisasterLinks::cityHeader>& grid) {
     os << "LOOKUP TABLE" << std::endl;
     for (const auto& item : grid) {
-        os << "{\"" << item.name << "\"," << item.left << "," << item.right << "}," << std::endl;
+        os << "{" << item.left << "," << item.right << "}," << std::endl;
     }
     os << std::endl;
     return os;
@@ -60,12 +61,13 @@ std::ostream& operator<<(std::ostream&os, const std::vector<DisasterLinks::cityH
 
 std::ostream& operator<<(std::ostream&os, const DisasterLinks& network) {
     os << "LOOKUP TABLE:" << std::endl;
-    for (const auto& header : network.table_) {
-        os << "{\"" << header.name << "\"," << header.left << "," << header.right << "},";
+    for (int i = 0; i < network.table_.size(); i++) {
+        os << "{\"" << network.cityNames_[i] << "\"," << network.table_[i].left << ","
+           << network.table_[i].right << "},";
     }
     os << std::endl;
     os << "DLX ARRAY:" << std::endl;
-    for (const auto& item : network.grid_) {
+    for (const auto& item : network.getGrid()) {
         if (item.topOrLen < 0) {
             os << std::endl;
         }
@@ -105,10 +107,10 @@ STUDENT_TEST("Initialize a small dancing links.") {
         {"C", {"A", "B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  3, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 0}
+        {3, 1},
+        {0, 2},
+        {1, 3},
+        {2, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         //        0               1A             2B            3C
@@ -123,7 +125,10 @@ STUDENT_TEST("Initialize a small dancing links.") {
     };
     Dx::DisasterLinks network(cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
+    // Names sit in their own array at the same index as the links of each city.
+    std::vector<std::string> names = {"", "A", "B", "C"};
+    EXPECT(network.cityNames_ == names);
 }
 
 STUDENT_TEST("Initialize larger dancing links.") {
@@ -141,13 +146,13 @@ STUDENT_TEST("Initialize larger dancing links.") {
         {"F", {"D"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         //        0                 1A             2B               3C               4D              5E             6F
@@ -162,7 +167,7 @@ STUDENT_TEST("Initialize larger dancing links.") {
     };
     Dx::DisasterLinks network(cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 }
 
 STUDENT_TEST("Simple Ethene Network initialization.") {
@@ -184,13 +189,13 @@ STUDENT_TEST("Simple Ethene Network initialization.") {
         {"F", {"B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         /* Network
@@ -228,7 +233,7 @@ STUDENT_TEST("Simple Ethene Network initialization.") {
     };
     Dx::DisasterLinks network (cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 }
 
 
@@ -251,10 +256,10 @@ STUDENT_TEST("Supplying A will only cover A and C. C remains available supply lo
         {"C", {"A", "B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  3, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 0}
+        {3, 1},
+        {0, 2},
+        {1, 3},
+        {2, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         //        0                 1A           2B            3C
@@ -267,17 +272,17 @@ STUDENT_TEST("Supplying A will only cover A and C. C remains available supply lo
     Dx::DisasterLinks network (cities);
 
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 
-    std::string supplyLocation = network.coverCity(9);
+    int supplyOption = network.coverCity(network.compactGrid_, 9);
 
-    EXPECT_EQUAL(supplyLocation, "A");
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "A");
 
     std::vector<Dx::DisasterLinks::cityHeader> headersCoverA = {
-        {"",  2, 2},
-        {"A", 0, 2},
-        {"B", 0, 0},
-        {"C", 2, 0}
+        {2, 2},
+        {0, 2},
+        {0, 0},
+        {2, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxCoverA = {
         /* Smaller network now.
@@ -296,7 +301,7 @@ STUDENT_TEST("Supplying A will only cover A and C. C remains available supply lo
               {INT_MIN,12,0,13,INT_MIN},
     };
     EXPECT_EQUAL(network.table_, headersCoverA);
-    EXPECT_EQUAL(network.grid_, dlxCoverA);
+    EXPECT_EQUAL(network.getGrid(), dlxCoverA);
 }
 
 STUDENT_TEST("Supplying B will only cover B and C. Make sure splicing from lookupTable works.") {
@@ -315,10 +320,10 @@ STUDENT_TEST("Supplying B will only cover B and C. Make sure splicing from looku
         {"C", {"A", "B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  3, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 0}
+        {3, 1},
+        {0, 2},
+        {1, 3},
+        {2, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         //        0                1A             2B            3C
@@ -330,17 +335,17 @@ STUDENT_TEST("Supplying B will only cover B and C. Make sure splicing from looku
     };
     Dx::DisasterLinks network (cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 
-    std::string supplyLocation = network.coverCity(12);
+    int supplyOption = network.coverCity(network.compactGrid_, 12);
 
-    EXPECT_EQUAL(supplyLocation, "B");
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "B");
 
     std::vector<Dx::DisasterLinks::cityHeader> headersCoverB = {
-        {"",  1, 1},
-        {"A", 0, 0},
-        {"B", 1, 3},
-        {"C", 1, 0}
+        {1, 1},
+        {0, 0},
+        {1, 3},
+        {1, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxCoverB = {
         /* Smaller network now.
@@ -360,7 +365,7 @@ STUDENT_TEST("Supplying B will only cover B and C. Make sure splicing from looku
               {INT_MIN,12,0,13,INT_MIN},
     };
     EXPECT_EQUAL(network.table_, headersCoverB);
-    EXPECT_EQUAL(network.grid_, dlxCoverB);
+    EXPECT_EQUAL(network.getGrid(), dlxCoverB);
 }
 
 
@@ -380,10 +385,10 @@ STUDENT_TEST("Supplying C will cover all. Make sure splicing from lookupTable wo
         {"C", {"A", "B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  3, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 0}
+        {3, 1},
+        {0, 2},
+        {1, 3},
+        {2, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         //        0                1A             2B            3C
@@ -395,17 +400,17 @@ STUDENT_TEST("Supplying C will cover all. Make sure splicing from lookupTable wo
     };
     Dx::DisasterLinks network (cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 
-    std::string supplyLocation = network.coverCity(5);
+    int supplyOption = network.coverCity(network.compactGrid_, 5);
 
-    EXPECT_EQUAL(supplyLocation, "C");
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "C");
 
     std::vector<Dx::DisasterLinks::cityHeader> headersOptionC = {
-        {"",  0, 0},
-        {"A", 0, 2},
-        {"B", 0, 3},
-        {"C", 0, 0}
+        {0, 0},
+        {0, 2},
+        {0, 3},
+        {0, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxOptionC = {
         /* Successful empty network.
@@ -426,7 +431,7 @@ STUDENT_TEST("Supplying C will cover all. Make sure splicing from lookupTable wo
         {INT_MIN,12,0,13,INT_MIN},
     };
     EXPECT_EQUAL(network.table_, headersOptionC);
-    EXPECT_EQUAL(network.grid_, dlxOptionC);
+    EXPECT_EQUAL(network.getGrid(), dlxOptionC);
 }
 
 
@@ -449,10 +454,10 @@ STUDENT_TEST("Supplying A will only cover A and C with one supply. Uncover to tr
         {"C", {"A", "B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  3, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 0}
+        {3, 1},
+        {0, 2},
+        {1, 3},
+        {2, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         //        0                1A             2B            3C
@@ -464,18 +469,18 @@ STUDENT_TEST("Supplying A will only cover A and C with one supply. Uncover to tr
     };
     Dx::DisasterLinks network (cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 
-    std::string supplyLocation = network.coverCity(9);
+    int supplyOption = network.coverCity(network.compactGrid_, 9);
 
-    EXPECT_EQUAL(supplyLocation, "A");
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "A");
 
 
     std::vector<Dx::DisasterLinks::cityHeader> headersCoverA = {
-        {"",  2, 2},
-        {"A", 0, 2},
-        {"B", 0, 0},
-        {"C", 2, 0}
+        {2, 2},
+        {0, 2},
+        {0, 0},
+        {2, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxCoverA = {
         /* Smaller network now.
@@ -494,12 +499,12 @@ STUDENT_TEST("Supplying A will only cover A and C with one supply. Uncover to tr
               {INT_MIN,12,0,13,INT_MIN},
     };
     EXPECT_EQUAL(network.table_, headersCoverA);
-    EXPECT_EQUAL(network.grid_, dlxCoverA);
+    EXPECT_EQUAL(network.getGrid(), dlxCoverA);
 
     // We can just check it against our original array. All state should be returned to normal.
-    network.uncoverCity(9);
+    network.uncoverCity(network.compactGrid_, 9);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 }
 
 STUDENT_TEST("Simple Ethene cover B, large item wipe out with D remaining an option.") {
@@ -521,13 +526,13 @@ STUDENT_TEST("Simple Ethene cover B, large item wipe out with D remaining an opt
         {"F", {"B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         /* Network
@@ -554,20 +559,20 @@ STUDENT_TEST("Simple Ethene cover B, large item wipe out with D remaining an opt
 
     Dx::DisasterLinks network (cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 
-    std::string supplyLocation = network.coverCity(8);
+    int supplyOption = network.coverCity(network.compactGrid_, 8);
 
-    EXPECT_EQUAL(supplyLocation, "B");
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "B");
 
     std::vector<Dx::DisasterLinks::cityHeader> headersCoverB = {
-        {"",  3, 1},
-        {"A", 0, 3},
-        {"B", 1, 3},
-        {"C", 1, 0},
-        {"D", 3, 5},
-        {"E", 3, 6},
-        {"F", 3, 0}
+        {3, 1},
+        {0, 3},
+        {1, 3},
+        {1, 0},
+        {3, 5},
+        {3, 6},
+        {3, 0}
     };
 
     std::vector<Dx::DisasterLinks::cityItem> dlxCoverB = {
@@ -592,10 +597,10 @@ STUDENT_TEST("Simple Ethene cover B, large item wipe out with D remaining an opt
               {INT_MIN,27,0,28,INT_MIN},
     };
     EXPECT_EQUAL(network.table_, headersCoverB);
-    EXPECT_EQUAL(network.grid_, dlxCoverB);
-    network.uncoverCity(8);
+    EXPECT_EQUAL(network.getGrid(), dlxCoverB);
+    network.uncoverCity(network.compactGrid_, 8);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 }
 
 
@@ -618,13 +623,13 @@ STUDENT_TEST("Simple Ethene cover A with option D.") {
         {"F", {"B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         /* Network
@@ -652,20 +657,20 @@ STUDENT_TEST("Simple Ethene cover A with option D.") {
     Dx::DisasterLinks network (cities);
 
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 
-    std::string supplyLocation = network.coverCity(13);
+    int supplyOption = network.coverCity(network.compactGrid_, 13);
 
-    EXPECT_EQUAL(supplyLocation, "D");
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "D");
 
     std::vector<Dx::DisasterLinks::cityHeader> headersCoverD = {
-        {"",  6, 5},
-        {"A", 0, 2},
-        {"B", 0, 3},
-        {"C", 0, 4},
-        {"D", 0, 5},
-        {"E", 0, 6},
-        {"F", 5, 0}
+        {6, 5},
+        {0, 2},
+        {0, 3},
+        {0, 4},
+        {0, 5},
+        {0, 6},
+        {5, 0}
     };
 
     std::vector<Dx::DisasterLinks::cityItem> dlxCoverD = {
@@ -690,11 +695,11 @@ STUDENT_TEST("Simple Ethene cover A with option D.") {
               {INT_MIN,27,0,28,INT_MIN},
     };
     EXPECT_EQUAL(network.table_, headersCoverD);
-    EXPECT_EQUAL(network.grid_, dlxCoverD);
+    EXPECT_EQUAL(network.getGrid(), dlxCoverD);
 
-    network.uncoverCity(13);
+    network.uncoverCity(network.compactGrid_, 13);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 }
 
 STUDENT_TEST("Test for a depth 2 cover and uncover. Two covers then two uncovers.") {
@@ -716,13 +721,13 @@ STUDENT_TEST("Test for a depth 2 cover and uncover. Two covers then two uncovers
         {"F", {"B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         /* Network
@@ -748,20 +753,20 @@ STUDENT_TEST("Test for a depth 2 cover and uncover. Two covers then two uncovers
     };
     Dx::DisasterLinks network (cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 
-    std::string supplyLocation = network.coverCity(18);
+    int supplyOption = network.coverCity(network.compactGrid_, 18);
 
-    EXPECT_EQUAL(supplyLocation, "A");
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "A");
 
     std::vector<Dx::DisasterLinks::cityHeader> headersCoverA = {
-        {"",  6, 2},
-        {"A", 0, 2},
-        {"B", 0, 3},
-        {"C", 2, 5},
-        {"D", 3, 5},
-        {"E", 3, 6},
-        {"F", 5, 0}
+        {6, 2},
+        {0, 2},
+        {0, 3},
+        {2, 5},
+        {3, 5},
+        {3, 6},
+        {5, 0}
     };
 
     std::vector<Dx::DisasterLinks::cityItem> dlxCoverA = {
@@ -786,20 +791,20 @@ STUDENT_TEST("Test for a depth 2 cover and uncover. Two covers then two uncovers
         {INT_MIN,27,0,28,INT_MIN},
     };
     EXPECT_EQUAL(network.table_, headersCoverA);
-    EXPECT_EQUAL(network.grid_, dlxCoverA);
+    EXPECT_EQUAL(network.getGrid(), dlxCoverA);
 
-    supplyLocation = network.coverCity(21);
+    supplyOption = network.coverCity(network.compactGrid_, 21);
 
-    EXPECT_EQUAL(supplyLocation, "C");
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "C");
 
     std::vector<Dx::DisasterLinks::cityHeader> headersCoverC = {
-        {"",  6, 2},
-        {"A", 0, 2},
-        {"B", 0, 5},
-        {"C", 2, 5},
-        {"D", 3, 5},
-        {"E", 2, 6},
-        {"F", 5, 0}
+        {6, 2},
+        {0, 2},
+        {0, 5},
+        {2, 5},
+        {3, 5},
+        {2, 6},
+        {5, 0}
     };
 
     std::vector<Dx::DisasterLinks::cityItem> dlxCoverC = {
@@ -824,13 +829,13 @@ STUDENT_TEST("Test for a depth 2 cover and uncover. Two covers then two uncovers
     };
 
     EXPECT_EQUAL(network.table_, headersCoverC);
-    EXPECT_EQUAL(network.grid_, dlxCoverC);
-    network.uncoverCity(21);
+    EXPECT_EQUAL(network.getGrid(), dlxCoverC);
+    network.uncoverCity(network.compactGrid_, 21);
     EXPECT_EQUAL(network.table_, headersCoverA);
-    EXPECT_EQUAL(network.grid_, dlxCoverA);
-    network.uncoverCity(18);
+    EXPECT_EQUAL(network.getGrid(), dlxCoverA);
+    network.uncoverCity(network.compactGrid_, 18);
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 
 }
 
@@ -878,13 +883,13 @@ STUDENT_TEST("Simple Ethene cover D and B to succeed.") {
         {"F", {"B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         /* Network
@@ -913,10 +918,10 @@ STUDENT_TEST("Simple Ethene cover D and B to succeed.") {
     EXPECT(!network.isDisasterReady(1, chosen));
     // Make sure that we cleanup our data structure between calls in case it is tested before destr.
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
     EXPECT(network.isDisasterReady(2, chosen));
     EXPECT_EQUAL(network.table_, networkHeaders);
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
 }
 
 STUDENT_TEST("Make sure data structure returns to original state after many calls in a row.") {
@@ -938,13 +943,13 @@ STUDENT_TEST("Make sure data structure returns to original state after many call
         {"F", {"B"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         /* Network
@@ -972,17 +977,59 @@ STUDENT_TEST("Make sure data structure returns to original state after many call
     std::set<std::string> chosen = {};
     for (int i = 50; i >= 0; i--) {
         if (i < 2) {
-            EXPECT(!network.isCovered(i, chosen));
+            EXPECT(!network.isDisasterReady(i, chosen));
         } else {
-            EXPECT(network.isCovered(i, chosen));
+            EXPECT(network.isDisasterReady(i, chosen));
         }
         chosen.clear();
         // No matter how many tests we do, the data structure should always restore itself.
-        EXPECT_EQUAL(network.grid_, dlxItems);
+        EXPECT_EQUAL(network.getGrid(), dlxItems);
         EXPECT_EQUAL(network.table_, networkHeaders);
     }
 }
 
+STUDENT_TEST("Small grids are built with 16 bit indices and nothing else.") {
+    /*
+     *        A----B----C----D----E
+     *             |
+     *             F
+     */
+    const std::map<std::string, std::set<std::string>> roads = makeMap({
+        {"A", {"B"}},
+        {"B", {"C", "F"}},
+        {"C", {"D"}},
+        {"D", {"E"}},
+    });
+    Dx::DisasterLinks network(roads);
+    EXPECT(network.grid_.empty());
+    EXPECT(!network.compactGrid_.empty());
+    const std::vector<Dx::DisasterLinks::cityItem> built = network.getGrid();
+    EXPECT_EQUAL(built.size(), network.compactGrid_.size());
+    EXPECT_EQUAL(built.back().topOrLen, INT_MIN);
+    std::set<std::string> supplies = {};
+    EXPECT(!network.isDisasterReady(1, supplies));
+    EXPECT(network.isDisasterReady(2, supplies));
+    EXPECT_EQUAL(network.findMinimumSupplies(supplies), 2);
+    EXPECT_EQUAL(network.getUniqueDisasterConfigurations(2).size(), 2);
+    EXPECT_EQUAL(network.getGrid(), built);
+    EXPECT(network.grid_.empty());
+}
+
+STUDENT_TEST("A grid too large for 16 bit indices is built and searched at full size.") {
+    // A road of 12000 towns builds about 60000 nodes. Every third town must be supplied.
+    std::map<std::string, std::set<std::string>> road = {};
+    for (int town = 0; town + 1 < 12000; town++) {
+        road[std::to_string(town)].insert(std::to_string(town + 1));
+    }
+    road = makeMap(road);
+    Dx::DisasterLinks network(road);
+    EXPECT(network.grid_.size() > 32767);
+    EXPECT(network.compactGrid_.empty());
+    std::set<std::string> supplies = {};
+    EXPECT(network.isDisasterReady(4000, supplies));
+    EXPECT_EQUAL(supplies.size(), 4000);
+}
+
 STUDENT_TEST("The straight line test. This will help us make sure we manage options correctly.") {
     /*
      *
@@ -998,13 +1045,13 @@ STUDENT_TEST("The straight line test. This will help us make sure we manage opti
         {"F", {"D"}},
     };
     std::vector<Dx::DisasterLinks::cityHeader> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterLinks::cityItem> dlxItems = {
         //        0                 1A             2B               3C               4D              5E             6F
@@ -1020,10 +1067,10 @@ STUDENT_TEST("The straight line test. This will help us make sure we manage opti
     Dx::DisasterLinks network(cities);
     std::set<std::string> chosen = {};
     EXPECT(!network.isDisasterReady(1, chosen));
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
     EXPECT_EQUAL(network.table_, networkHeaders);
     EXPECT(network.isDisasterReady(2, chosen));
-    EXPECT_EQUAL(network.grid_, dlxItems);
+    EXPECT_EQUAL(network.getGrid(), dlxItems);
     EXPECT_EQUAL(network.table_, networkHeaders);
 }
 
@@ -1470,6 +1517,163 @@ PROVIDED_TEST("Stress test: 6 x 6 grid, with output. (This should take at most a
     }
 }
 
+STUDENT_TEST("Lower bounds refute an 8 x 8 grid with too few supplies without a full search.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'H';
+    int  maxCol = 8;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterLinks network(grid);
+    std::set<std::string> locations;
+    // The 8 x 8 grid needs 16 supplies. Without bounds, proving 15 fails takes about a minute.
+    EXPECT(!network.isDisasterReady(15, locations));
+    Dx::DisasterLinks::BoundCuts cuts = network.getBoundCuts();
+    EXPECT(cuts.optionSize + cuts.packing > 0);
+
+    // The bounds are admissible so they never cut away the optimal covers.
+    EXPECT(network.isDisasterReady(16, locations));
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            EXPECT(checkCovered(row + std::to_string(col), grid, locations));
+        }
+    }
+}
+
+STUDENT_TEST("Minimum supplies finds the optimum of an 8 x 8 grid with one search.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'H';
+    int  maxCol = 8;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterLinks network(grid);
+    std::set<std::string> locations;
+    EXPECT_EQUAL(network.findMinimumSupplies(locations), 16);
+    EXPECT_EQUAL(locations.size(), 16);
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            EXPECT(checkCovered(row + std::to_string(col), grid, locations));
+        }
+    }
+}
+
+STUDENT_TEST("Minimum supplies handles a line of cities and an empty map.") {
+    const std::map<std::string, std::set<std::string>> line = makeMap({
+        {"A", {"B"}},
+        {"B", {"C"}},
+        {"C", {"D"}},
+        {"D", {"E"}},
+    });
+    Dx::DisasterLinks network(line);
+    std::set<std::string> locations;
+    EXPECT_EQUAL(network.findMinimumSupplies(locations), 2);
+    for (const std::string city : {"A", "B", "C", "D", "E"}) {
+        EXPECT(checkCovered(city, line, locations));
+    }
+
+    const std::map<std::string, std::set<std::string>> noCities = {};
+    Dx::DisasterLinks empty(noCities);
+    std::set<std::string> none;
+    EXPECT_EQUAL(empty.findMinimumSupplies(none), 0);
+    EXPECT(none.empty());
+}
+
+STUDENT_TEST("Nogoods skip sets of cities that failed before through another order of choices.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'H';
+    int  maxCol = 8;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterLinks network(grid);
+    uint64_t wholeNetwork = network.uncoveredKey_;
+    std::set<std::string> locations;
+    EXPECT(!network.isDisasterReady(15, locations));
+    Dx::NogoodTable::NogoodStats stats = network.getNogoodStats();
+    EXPECT(stats.hits > 0);
+    EXPECT(stats.stores > 0);
+    // Every city is uncovered again once the search is over so the hash is back where it began.
+    EXPECT_EQUAL(network.uncoveredKey_, wholeNetwork);
+
+    // Proofs from the failed search stay in the table and must not cut away the optimum.
+    EXPECT_EQUAL(network.findMinimumSupplies(locations), 16);
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            EXPECT(checkCovered(row + std::to_string(col), grid, locations));
+        }
+    }
+}
+
+STUDENT_TEST("Work stealing search covers a 6 x 6 grid and agrees with the serial search.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'F';
+    int  maxCol = 6;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterLinks network(grid);
+    std::set<std::string> locations;
+    EXPECT(network.isDisasterReady(10, locations, 4));
+    // The solver keeps the balance of its last parallel search for callers to inspect.
+    EXPECT_EQUAL(network.getWorkerNodes().size(), 4);
+    EXPECT(locations.size() <= 10);
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            EXPECT(checkCovered(row + std::to_string(col), grid, locations));
+        }
+    }
+
+    // The original network is left untouched so the serial search still works afterward.
+    locations.clear();
+    std::set<int> supplies;
+    Dx::ParallelSearch<Dx::DisasterLinks,int> search(network, 4);
+    EXPECT(!search.hasCover(9, supplies));
+    EXPECT(supplies.empty());
+    EXPECT_EQUAL(search.nodesPerWorker().size(), 4);
+    EXPECT(network.isDisasterReady(10, locations));
+}
+
 STUDENT_TEST("All possible configurations of a square.") {
     /*
      *
@@ -1539,6 +1743,100 @@ STUDENT_TEST("All possible configurations with 4 supplies are many.") {
     EXPECT_EQUAL(allFound,allConfigs);
 }
 
+STUDENT_TEST("Unique configurations are each generated once and match the filtered set.") {
+    /*
+     *
+     *   H--A     E--I
+     *      |     |
+     *      B--D--F
+     *      |     |
+     *      C     G
+     *
+     */
+    const std::map<std::string, std::set<std::string>> cities = {
+        {"A", {"H","B"}},
+        {"B", {"A","C","D"}},
+        {"C", {"B"}},
+        {"D", {"B","F"}},
+        {"E", {"F","I"}},
+        {"F", {"D","E","G"}},
+        {"G", {"F"}},
+        {"H", {"A"}},
+        {"I", {"E"}},
+    };
+    Dx::DisasterLinks grid(cities);
+    std::vector<std::set<std::string>> unique = grid.getUniqueDisasterConfigurations(4);
+    std::set<std::set<std::string>> filtered(unique.begin(), unique.end());
+    EXPECT_EQUAL(unique.size(), 12);
+    EXPECT_EQUAL(filtered.size(), unique.size());
+    EXPECT_EQUAL(filtered, grid.getAllDisasterConfigurations(4));
+    // Forbidden options must all be restored so a second search finds the same configurations.
+    EXPECT(grid.getUniqueDisasterConfigurations(4) == unique);
+    EXPECT(grid.getUniqueDisasterConfigurations(3).empty());
+}
+
+STUDENT_TEST("Counting configurations agrees with listing them at every supply count.") {
+    /*
+     *        A----B----C
+     *        |    |    |
+     *        D----E----F----G
+     */
+    const std::map<std::string, std::set<std::string>> cities = makeMap({
+        {"A", {"B", "D"}},
+        {"B", {"C", "E"}},
+        {"C", {"F"}},
+        {"D", {"E"}},
+        {"E", {"F"}},
+        {"F", {"G"}},
+    });
+    Dx::DisasterLinks network(cities);
+    for (int numSupplies = 0; numSupplies <= 4; numSupplies++) {
+        uint64_t listed = network.getUniqueDisasterConfigurations(numSupplies).size();
+        EXPECT_EQUAL(network.countDisasterConfigurations(numSupplies), listed);
+    }
+    EXPECT_EQUAL(network.countDisasterConfigurations(1), 0);
+    // Forbidden options must all be restored so counting again gives the same answer.
+    EXPECT_EQUAL(network.countDisasterConfigurations(3),
+                 network.getUniqueDisasterConfigurations(3).size());
+}
+
+STUDENT_TEST("A visitor sees every configuration as it is found and may stop the search.") {
+    /*
+     *        A----B----C
+     *        |    |    |
+     *        D----E----F----G
+     */
+    const std::map<std::string, std::set<std::string>> cities = makeMap({
+        {"A", {"B", "D"}},
+        {"B", {"C", "E"}},
+        {"C", {"F"}},
+        {"D", {"E"}},
+        {"E", {"F"}},
+        {"F", {"G"}},
+    });
+    Dx::DisasterLinks network(cities);
+    std::vector<std::set<std::string>> unique = network.getUniqueDisasterConfigurations(3);
+    EXPECT(unique.size() > 2);
+
+    std::vector<std::set<std::string>> streamed = {};
+    EXPECT(network.visitDisasterConfigurations(3, [&](const std::vector<int>& supplies) {
+        streamed.emplace_back();
+        for (int option : supplies) {
+            streamed.back().insert(network.getSupplyName(option));
+        }
+        return true;
+    }));
+    EXPECT(streamed == unique);
+
+    int seen = 0;
+    EXPECT(!network.visitDisasterConfigurations(3, [&](const std::vector<int>&) {
+        return ++seen < 2;
+    }));
+    EXPECT_EQUAL(seen, 2);
+    // Stopping early must leave every forbidden option restored for the next search.
+    EXPECT(network.getUniqueDisasterConfigurations(3) == unique);
+}
+
 STUDENT_TEST("Larger maps are more difficult to filter out duplicates.") {
     /*
      * This is a good test for when I am trying to avoid generating duplicates. Put a number
@@ -1616,3 +1914,79 @@ STUDENT_TEST("Larger maps are more difficult to filter out duplicates.") {
     };
     EXPECT_EQUAL(allFound,allConfigs);
 }
+
+STUDENT_TEST("A network built from a compact graph matches one built from the map.") {
+    /*
+     *        B----A----D
+     *              \  /
+     *               C
+     */
+    const std::map<std::string, std::set<std::string>> roads = {
+        {"A", {"B", "C", "D"}},
+        {"B", {"A"}},
+        {"C", {"A", "D"}},
+        {"D", {"A", "C"}},
+    };
+    // The same roads numbered by hand with each city's neighbors listed in any order.
+    Dx::NetworkGraph graph({"A", "B", "C", "D"}, {0, 3, 4, 6, 8}, {3, 1, 2, 0, 3, 0, 2, 0});
+    Dx::DisasterLinks fromMap(roads);
+    Dx::DisasterLinks fromGraph(graph);
+    EXPECT_EQUAL(fromGraph.table_, fromMap.table_);
+    EXPECT_EQUAL(fromGraph.getGrid(), fromMap.getGrid());
+    std::set<std::string> supplies;
+    EXPECT(fromGraph.isDisasterReady(1, supplies));
+    EXPECT(supplies == std::set<std::string>({"A"}));
+}
+
+STUDENT_TEST("Length buckets hand out the first shortest city and survive forbidden options.") {
+    /*
+     * Columns hold a city's own option and one per neighbor: B has 2, C and D have 3, A has 4.
+     *
+     *        B----A----D
+     *              \  /
+     *               C
+     */
+    const std::map<std::string, std::set<std::string>> roads = {
+        {"A", {"B", "C", "D"}},
+        {"B", {"A"}},
+        {"C", {"A", "D"}},
+        {"D", {"A", "C"}},
+    };
+    Dx::DisasterLinks network(roads);
+    EXPECT_EQUAL(network.cityNames_[network.chooseIsolatedCity()], "B");
+    const std::vector<Dx::DisasterLinks::cityHeader> built = network.lengthLinks_;
+
+    // Enumeration forbids options and moves cities to shorter buckets as it goes.
+    EXPECT(!network.visitDisasterConfigurations(2, [](const std::vector<int>&) { return false; }));
+    EXPECT_EQUAL(network.lengthLinks_, built);
+    EXPECT_EQUAL(network.countDisasterConfigurations(2),
+                 network.getUniqueDisasterConfigurations(2).size());
+    EXPECT_EQUAL(network.lengthLinks_, built);
+    EXPECT(network.movedFrom_.empty());
+    EXPECT_EQUAL(network.cityNames_[network.chooseIsolatedCity()], "B");
+}
+
+STUDENT_TEST("Ranking options by uncovered cities finds the same minimum and leaves no trace.") {
+    /*
+     *        A----B----C----D----E
+     */
+    const std::map<std::string, std::set<std::string>> roads = {
+        {"A", {"B"}},
+        {"B", {"A", "C"}},
+        {"C", {"B", "D"}},
+        {"D", {"C", "E"}},
+        {"E", {"D"}},
+    };
+    Dx::DisasterLinks network(roads);
+    const std::vector<Dx::DisasterLinks::cityHeader> built = network.table_;
+    network.setOptionOrder(Dx::DisasterLinks::OptionOrder::MOST_UNCOVERED);
+
+    std::set<std::string> supplies = {};
+    EXPECT_EQUAL(network.findMinimumSupplies(supplies), 2);
+    supplies.clear();
+    EXPECT(network.isDisasterReady(2, supplies));
+    EXPECT_EQUAL(supplies.size(), 2);
+    supplies.clear();
+    EXPECT(!network.isDisasterReady(1, supplies));
+    EXPECT_EQUAL(network.table_, built);
+}
@@ -0,0 +1,99 @@
+#include "Src/DisasterReduction.h"
+#include "Src/DisasterLinks.h"
+#include "Src/DisasterTags.h"
+#include "Src/DisasterUtilities.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * *   Domination Rule Tests   * * * * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("Pendant towns force their neighbors until nothing is left to search.") {
+    /*
+     *        A----B----C----D----E
+     */
+    const std::map<std::string, std::set<std::string>> line = makeMap({
+        {"A", {"B"}},
+        {"B", {"C"}},
+        {"C", {"D"}},
+        {"D", {"E"}},
+    });
+    Dx::DisasterReduction reduction(line);
+    EXPECT_EQUAL(reduction.getNumForced(), 2);
+    Dx::CoverNetwork reduced = reduction.getReducedNetwork();
+    EXPECT_EQUAL(reduced.numItems(), 0);
+    EXPECT_EQUAL(reduced.numOptions(), 0);
+
+    Dx::DisasterLinks network(reduced);
+    std::set<std::string> supplies = {};
+    EXPECT_EQUAL(network.findMinimumSupplies(supplies), 0);
+    reduction.restoreSupplies(supplies);
+    std::set<std::string> expected = {"B", "D"};
+    EXPECT_EQUAL(supplies, expected);
+}
+
+STUDENT_TEST("Dominated supply locations and cities are removed before the search.") {
+    /* D is only near A and B so supplying B covers everything D would. E and F are reached by
+     * the same supply locations, so once one of them is safe the other is too.
+     */
+    const std::map<std::string, std::set<std::string>> roads = makeMap({
+        {"A", {"B", "D"}},
+        {"B", {"C", "D", "E", "F"}},
+        {"C", {"F"}},
+        {"E", {"F", "C"}},
+    });
+    Dx::DisasterReduction reduction(roads);
+    Dx::DisasterReduction::ReductionCounts counts = reduction.getCounts();
+    EXPECT(counts.dominatedOptions > 0);
+    EXPECT(counts.dominatedCities > 0);
+
+    Dx::CoverNetwork reduced = reduction.getReducedNetwork();
+    Dx::DisasterTags network(reduced);
+    std::set<std::string> supplies = {};
+    int numSupplies = network.findMinimumSupplies(supplies) + reduction.getNumForced();
+    reduction.restoreSupplies(supplies);
+    EXPECT_EQUAL(numSupplies, 1);
+    EXPECT_EQUAL((int)supplies.size(), numSupplies);
+    for (const auto& [city, connections] : roads) {
+        EXPECT(checkCovered(city, roads, supplies));
+    }
+}
+
+STUDENT_TEST("A reduced grid with pendant towns needs exactly the supplies of the full grid.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'F';
+    int  maxCol = 6;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+        // Every row has a town hanging off its first city.
+        grid[std::string("P") + row].insert(row + std::string("1"));
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterLinks full(grid);
+    std::set<std::string> fullSupplies = {};
+    int optimum = full.findMinimumSupplies(fullSupplies);
+
+    Dx::DisasterReduction reduction(grid);
+    EXPECT(reduction.getNumForced() >= 6);
+    Dx::CoverNetwork reduced = reduction.getReducedNetwork();
+    EXPECT(reduced.numItems() < (int)grid.size());
+    Dx::DisasterLinks network(reduced);
+    std::set<std::string> supplies = {};
+    EXPECT_EQUAL(network.findMinimumSupplies(supplies) + reduction.getNumForced(), optimum);
+    reduction.restoreSupplies(supplies);
+    EXPECT_EQUAL((int)supplies.size(), optimum);
+    for (const auto& [city, connections] : grid) {
+        EXPECT(checkCovered(city, grid, supplies));
+    }
+}
@@ -1,4 +1,5 @@
 #include "Src/DisasterTags.h"
+#include "Src/ParallelSearch.h"
 #include "Src/DisasterUtilities.h"
 #include "GenericOverloads.h"
 
@@ -15,11 +16,11 @@ bool operator!=(const DisasterTags::city& lhs, const DisasterTags::city& rhs) {
     return !(lhs == rhs);
 }
 
-bool operator==(const DisasterTags::cityName& lhs, const DisasterTags::cityName& rhs) {
-    return lhs.name == rhs.name && lhs.left == rhs.left && lhs.right == rhs.right;
+bool operator==(const DisasterTags::cityHeader& lhs, const DisasterTags::cityHeader& rhs) {
+    return lhs.left == rhs.left && lhs.right == rhs.right;
 }
 
-bool operator!=(const DisasterTags::cityName& lhs, const DisasterTags::cityName& rhs) {
+bool operator!=(const DisasterTags::cityHeader& lhs, const DisasterTags::cityHeader& rhs) {
     return !(lhs == rhs);
 }
 
@@ -29,15 +30,15 @@ std::ostream& operator<<(std::ostream& os, const DisasterTags::city& person) {
     return os;
 }
 
-std::ostream& operator<<(std::ostream& os, const DisasterTags::cityName& name) {
-    os << "{ name: " << name.name << ", left: " << name.left << ", right: " << name.right << " }";
+std::ostream& operator<<(std::ostream& os, const DisasterTags::cityHeader& name) {
+    os << "{ left: " << name.left << ", right: " << name.right << " }";
     return os;
 }
 
-std::ostream& operator<<(std::ostream&os, const std::vector<DisasterTags::cityName>& links) {
+std::ostream& operator<<(std::ostream&os, const std::vector<DisasterTags::cityHeader>& links) {
     os << "LOOKUP TABLE" << std::endl;
     for (const auto& item : links) {
-        os << "{\"" << item.name << "\"," << item.left << "," << item.right << "}" << std::endl;
+        os << "{" << item.left << "," << item.right << "}" << std::endl;
     }
     os << std::endl;
     return os;
@@ -63,11 +64,11 @@ std::ostream& operator<<(std::ostream&os, const std::vector<DisasterTags::city>&
 
 std::ostream& operator<<(std::ostream&os, const DisasterTags& links) {
     os << "LOOKUP ARRAY" << std::endl;
-    for (const auto& header : links.table_) {
+    for (int i = 0; i < links.table_.size(); i++) {
         os << "{\""
-           << header.name << "\","
-           << header.left << ","
-           << header.right << "},"
+           << links.cityNames_[i] << "\","
+           << links.table_[i].left << ","
+           << links.table_[i].right << "},"
            << std::endl;
     }
     os << "DLX ARRAY" << std::endl;
@@ -113,11 +114,11 @@ STUDENT_TEST("Initialize a small dancing links.") {
         {"B", {"C"}},
         {"C", {"A", "B"}},
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",  3, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 0}
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {3, 1},
+        {0, 2},
+        {1, 3},
+        {2, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         // 0           1A        2B        3C
@@ -133,6 +134,9 @@ STUDENT_TEST("Initialize a small dancing links.") {
     Dx::DisasterTags network(cities);
     EXPECT_EQUAL(network.table_, networkHeaders);
     EXPECT_EQUAL(network.grid_, dlxItems);
+    // Names sit in their own array at the same index as the links of each city.
+    std::vector<std::string> names = {"", "A", "B", "C"};
+    EXPECT(network.cityNames_ == names);
 }
 
 STUDENT_TEST("Initialize larger dancing links.") {
@@ -149,14 +153,14 @@ STUDENT_TEST("Initialize larger dancing links.") {
         {"E", {"B", "C"}},
         {"F", {"D"}},
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         //  0            1A          2B          3C         4D           5E          6F
@@ -198,14 +202,14 @@ STUDENT_TEST("Simple Ethene Network initialization.") {
         {"E", {"B"}},
         {"F", {"B"}},
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         //  0            1A          2B         3C          4D         5E          6F
@@ -248,11 +252,11 @@ STUDENT_TEST("Cover uncover A should only cover A and C from header list.") {
         {"B", {"C"}},
         {"C", {"A", "B"}},
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",  3, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 0}
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {3, 1},
+        {0, 2},
+        {1, 3},
+        {2, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         // 0           1A        2B        3C
@@ -269,13 +273,13 @@ STUDENT_TEST("Cover uncover A should only cover A and C from header list.") {
     EXPECT_EQUAL(network.table_, networkHeaders);
     EXPECT_EQUAL(network.grid_, dlxItems);
 
-    std::string location = network.coverCity(9,1);
-    EXPECT_EQUAL(location, "A");
-    std::vector<Dx::DisasterTags::cityName> headersCoverA {
-        {"",  2, 2},
-        {"A", 0, 2},
-        {"B", 0, 0},
-        {"C", 2, 0}
+    int supplyOption = network.coverCity(9,1);
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "A");
+    std::vector<Dx::DisasterTags::cityHeader> headersCoverA {
+        {2, 2},
+        {0, 2},
+        {0, 0},
+        {2, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxCoverA = {
         // 0           1A        2B        3C
@@ -314,14 +318,14 @@ STUDENT_TEST("Recursive depth field prevents uncovering cities that should remai
         {"E", {"B"}},
         {"F", {"B"}},
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         //  0            1A          2B         3C          4D         5E          6F
@@ -344,16 +348,16 @@ STUDENT_TEST("Recursive depth field prevents uncovering cities that should remai
     EXPECT_EQUAL(network.table_, networkHeaders);
     EXPECT_EQUAL(network.grid_, dlxItems);
 
-    std::string location = network.coverCity(13,1);
-    EXPECT_EQUAL(location, "D");
-    std::vector<Dx::DisasterTags::cityName> headersCoverD = {
-        {"",  6, 5},
-        {"A", 0, 2},
-        {"B", 0, 3},
-        {"C", 0, 4},
-        {"D", 0, 5},
-        {"E", 0, 6},
-        {"F", 5, 0}
+    int supplyOption = network.coverCity(13,1);
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "D");
+    std::vector<Dx::DisasterTags::cityHeader> headersCoverD = {
+        {6, 5},
+        {0, 2},
+        {0, 3},
+        {0, 4},
+        {0, 5},
+        {0, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxCoverD = {
         //  0            1A          2B         3C          4D         5E          6F
@@ -375,16 +379,16 @@ STUDENT_TEST("Recursive depth field prevents uncovering cities that should remai
     EXPECT_EQUAL(network.table_, headersCoverD);
     EXPECT_EQUAL(network.grid_, dlxCoverD);
 
-    location = network.coverCity(10,2);
-    EXPECT_EQUAL(location, "B");
-    std::vector<Dx::DisasterTags::cityName> headersCoverB = {
-        {"",  0, 0},
-        {"A", 0, 2},
-        {"B", 0, 3},
-        {"C", 0, 4},
-        {"D", 0, 5},
-        {"E", 0, 6},
-        {"F", 0, 0}
+    supplyOption = network.coverCity(10,2);
+    EXPECT_EQUAL(network.supplyNames_[supplyOption], "B");
+    std::vector<Dx::DisasterTags::cityHeader> headersCoverB = {
+        {0, 0},
+        {0, 2},
+        {0, 3},
+        {0, 4},
+        {0, 5},
+        {0, 6},
+        {0, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxCoverB = {
         //  0            1A          2B         3C          4D         5E          6F
@@ -433,11 +437,11 @@ STUDENT_TEST("Can cover this map with one supply.") {
         {"B", {"C"}},
         {"C", {"A", "B"}},
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",  3, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 0}
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {3, 1},
+        {0, 2},
+        {1, 3},
+        {2, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         // 0           1A        2B        3C
@@ -478,14 +482,14 @@ STUDENT_TEST("Can cover Ethene with two supplies.") {
         {"E", {"B"}},
         {"F", {"B"}},
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         //  0            1A          2B         3C          4D         5E          6F
@@ -526,14 +530,14 @@ STUDENT_TEST("Passes Straight Line test with two supplies.") {
         {"E", {"B", "C"}},
         {"F", {"D"}},
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",  6, 1},
-        {"A", 0, 2},
-        {"B", 1, 3},
-        {"C", 2, 4},
-        {"D", 3, 5},
-        {"E", 4, 6},
-        {"F", 5, 0}
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {6, 1},
+        {0, 2},
+        {1, 3},
+        {2, 4},
+        {3, 5},
+        {4, 6},
+        {5, 0}
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         //  0            1A          2B          3C         4D           5E          6F
@@ -631,13 +635,13 @@ STUDENT_TEST("Supply 5 island cities when we must.") {
         {"D", {}},
         {"E", {}}
     };
-    std::vector<Dx::DisasterTags::cityName> networkHeaders = {
-        {"",5,1},
-        {"A",0,2},
-        {"B",1,3},
-        {"C",2,4},
-        {"D",3,5},
-        {"E",4,0},
+    std::vector<Dx::DisasterTags::cityHeader> networkHeaders = {
+        {5,1},
+        {0,2},
+        {1,3},
+        {2,4},
+        {3,5},
+        {4,0},
     };
     std::vector<Dx::DisasterTags::city> dlxItems = {
         {0,0,0,0},   {1,7,7,0},{1,9,9,0},{1,11,11,0},{1,13,13,0},{1,15,15,0},
@@ -941,6 +945,163 @@ PROVIDED_TEST("Stress test: 8 x 8 grid, with output. (This should take at most a
     }
 }
 
+STUDENT_TEST("Lower bounds refute an 8 x 8 grid with too few supplies without a full search.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'H';
+    int  maxCol = 8;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterTags network(grid);
+    std::set<std::string> locations;
+    // The 8 x 8 grid needs 16 supplies. Without bounds, proving 15 fails takes about a minute.
+    EXPECT(!network.hasDisasterCoverage(15, locations));
+    Dx::DisasterTags::BoundCuts cuts = network.getBoundCuts();
+    EXPECT(cuts.optionSize + cuts.packing > 0);
+
+    // The bounds are admissible so they never cut away the optimal covers.
+    EXPECT(network.hasDisasterCoverage(16, locations));
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            EXPECT(checkCovered(row + std::to_string(col), grid, locations));
+        }
+    }
+}
+
+STUDENT_TEST("Minimum supplies finds the optimum of an 8 x 8 grid with one search.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'H';
+    int  maxCol = 8;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterTags network(grid);
+    std::set<std::string> locations;
+    EXPECT_EQUAL(network.findMinimumSupplies(locations), 16);
+    EXPECT_EQUAL(locations.size(), 16);
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            EXPECT(checkCovered(row + std::to_string(col), grid, locations));
+        }
+    }
+}
+
+STUDENT_TEST("Minimum supplies handles a line of cities and an empty map.") {
+    const std::map<std::string, std::set<std::string>> line = makeMap({
+        {"A", {"B"}},
+        {"B", {"C"}},
+        {"C", {"D"}},
+        {"D", {"E"}},
+    });
+    Dx::DisasterTags network(line);
+    std::set<std::string> locations;
+    EXPECT_EQUAL(network.findMinimumSupplies(locations), 2);
+    for (const std::string city : {"A", "B", "C", "D", "E"}) {
+        EXPECT(checkCovered(city, line, locations));
+    }
+
+    const std::map<std::string, std::set<std::string>> noCities = {};
+    Dx::DisasterTags empty(noCities);
+    std::set<std::string> none;
+    EXPECT_EQUAL(empty.findMinimumSupplies(none), 0);
+    EXPECT(none.empty());
+}
+
+STUDENT_TEST("Nogoods skip sets of cities that failed before through another order of choices.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'H';
+    int  maxCol = 8;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterTags network(grid);
+    uint64_t wholeNetwork = network.uncoveredKey_;
+    std::set<std::string> locations;
+    EXPECT(!network.hasDisasterCoverage(15, locations));
+    Dx::NogoodTable::NogoodStats stats = network.getNogoodStats();
+    EXPECT(stats.hits > 0);
+    EXPECT(stats.stores > 0);
+    // Every city is uncovered again once the search is over so the hash is back where it began.
+    EXPECT_EQUAL(network.uncoveredKey_, wholeNetwork);
+
+    // Proofs from the failed search stay in the table and must not cut away the optimum.
+    EXPECT_EQUAL(network.findMinimumSupplies(locations), 16);
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            EXPECT(checkCovered(row + std::to_string(col), grid, locations));
+        }
+    }
+}
+
+STUDENT_TEST("Work stealing search covers a 6 x 6 grid and agrees with the serial search.") {
+    std::map<std::string, std::set<std::string>> grid;
+
+    char maxRow = 'F';
+    int  maxCol = 6;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+
+    Dx::DisasterTags network(grid);
+    std::set<std::string> locations;
+    EXPECT(network.hasDisasterCoverage(10, locations, 4));
+    // The solver keeps the balance of its last parallel search for callers to inspect.
+    EXPECT_EQUAL(network.getWorkerNodes().size(), 4);
+    EXPECT(locations.size() <= 10);
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            EXPECT(checkCovered(row + std::to_string(col), grid, locations));
+        }
+    }
+
+    // The original network is left untouched so the serial search still works afterward.
+    locations.clear();
+    std::set<int> supplies;
+    Dx::ParallelSearch<Dx::DisasterTags,int> search(network, 4);
+    EXPECT(!search.hasCover(9, supplies));
+    EXPECT(supplies.empty());
+    EXPECT_EQUAL(search.nodesPerWorker().size(), 4);
+    EXPECT(network.hasDisasterCoverage(10, locations));
+}
+
 STUDENT_TEST("All possible configurations of a square.") {
     /*
      *
@@ -1010,6 +1171,63 @@ STUDENT_TEST("All possible configurations with 4 supplies are many.") {
     EXPECT_EQUAL(allFound,allConfigs);
 }
 
+STUDENT_TEST("Unique configurations are each generated once and match the filtered set.") {
+    /*
+     *
+     *   H--A     E--I
+     *      |     |
+     *      B--D--F
+     *      |     |
+     *      C     G
+     *
+     */
+    const std::map<std::string, std::set<std::string>> cities = {
+        {"A", {"H","B"}},
+        {"B", {"A","C","D"}},
+        {"C", {"B"}},
+        {"D", {"B","F"}},
+        {"E", {"F","I"}},
+        {"F", {"D","E","G"}},
+        {"G", {"F"}},
+        {"H", {"A"}},
+        {"I", {"E"}},
+    };
+    Dx::DisasterTags grid(cities);
+    std::vector<std::set<std::string>> unique = grid.getUniqueDisasterConfigurations(4);
+    std::set<std::set<std::string>> filtered(unique.begin(), unique.end());
+    EXPECT_EQUAL(unique.size(), 12);
+    EXPECT_EQUAL(filtered.size(), unique.size());
+    EXPECT_EQUAL(filtered, grid.getAllDisasterConfigurations(4));
+    // Forbidden options must all be restored so a second search finds the same configurations.
+    EXPECT(grid.getUniqueDisasterConfigurations(4) == unique);
+    EXPECT(grid.getUniqueDisasterConfigurations(3).empty());
+}
+
+STUDENT_TEST("Counting configurations agrees with listing them at every supply count.") {
+    /*
+     *        A----B----C
+     *        |    |    |
+     *        D----E----F----G
+     */
+    const std::map<std::string, std::set<std::string>> cities = makeMap({
+        {"A", {"B", "D"}},
+        {"B", {"C", "E"}},
+        {"C", {"F"}},
+        {"D", {"E"}},
+        {"E", {"F"}},
+        {"F", {"G"}},
+    });
+    Dx::DisasterTags network(cities);
+    for (int numSupplies = 0; numSupplies <= 4; numSupplies++) {
+        uint64_t listed = network.getUniqueDisasterConfigurations(numSupplies).size();
+        EXPECT_EQUAL(network.countDisasterConfigurations(numSupplies), listed);
+    }
+    EXPECT_EQUAL(network.countDisasterConfigurations(1), 0);
+    // Forbidden options must all be restored so counting again gives the same answer.
+    EXPECT_EQUAL(network.countDisasterConfigurations(3),
+                 network.getUniqueDisasterConfigurations(3).size());
+}
+
 STUDENT_TEST("Larger maps are more difficult to filter out duplicates.") {
     /*
      * This is a good test for when I am trying to avoid generating duplicates. Put a number
@@ -1087,3 +1305,154 @@ STUDENT_TEST("Larger maps are more difficult to filter out duplicates.") {
     };
     EXPECT_EQUAL(allFound,allConfigs);
 }
+
+STUDENT_TEST("A network built from a compact graph matches one built from the map.") {
+    /*
+     *        B----A----D
+     *              \  /
+     *               C
+     */
+    const std::map<std::string, std::set<std::string>> roads = {
+        {"A", {"B", "C", "D"}},
+        {"B", {"A"}},
+        {"C", {"A", "D"}},
+        {"D", {"A", "C"}},
+    };
+    // The same roads numbered by hand with each city's neighbors listed in any order.
+    Dx::NetworkGraph graph({"A", "B", "C", "D"}, {0, 3, 4, 6, 8}, {3, 1, 2, 0, 3, 0, 2, 0});
+    Dx::DisasterTags fromMap(roads);
+    Dx::DisasterTags fromGraph(graph);
+    EXPECT_EQUAL(fromGraph.table_, fromMap.table_);
+    EXPECT_EQUAL(fromGraph.grid_, fromMap.grid_);
+    std::set<std::string> supplies;
+    EXPECT(fromGraph.hasDisasterCoverage(1, supplies));
+    EXPECT(supplies == std::set<std::string>({"A"}));
+}
+
+STUDENT_TEST("Useful options per city follow the supply tags and skip options covering one city.") {
+    /*
+     *        B----A----D
+     *              \  /
+     *               C
+     */
+    const std::map<std::string, std::set<std::string>> roads = {
+        {"A", {"B", "C", "D"}},
+        {"B", {"A"}},
+        {"C", {"A", "D"}},
+        {"D", {"A", "C"}},
+    };
+    Dx::DisasterTags network(roads);
+    // Every option reaches at least two cities before we supply anything.
+    const std::vector<int> initial = {0, 4, 2, 3, 3};
+    EXPECT(network.usefulOptions_ == initial);
+    EXPECT_EQUAL(network.cityNames_[network.chooseConstrainedCity()], "B");
+
+    // Supplying C leaves B as the only untagged city of both options that cover it.
+    int supplied = 0;
+    for (int i = network.grid_[3].down; i != 3 && !supplied; i = network.grid_[i].down) {
+        if (network.getSupplyName(network.coverCity(i, 1)) == "C") {
+            supplied = i;
+        } else {
+            network.uncoverCity(i);
+        }
+    }
+    EXPECT_EQUAL(network.usefulOptions_[2], 0);
+    EXPECT_EQUAL(network.cityNames_[network.chooseConstrainedCity()], "B");
+    int first = network.grid_[2].down;
+    EXPECT(!network.isDominatedOption(2, first));
+    EXPECT(network.isDominatedOption(2, network.grid_[first].down));
+    network.uncoverCity(supplied);
+    EXPECT(network.usefulOptions_ == initial);
+
+    std::set<std::string> supplies = {};
+    EXPECT_EQUAL(network.findMinimumSupplies(supplies), 1);
+    EXPECT(!network.hasDisasterCoverage(0, supplies));
+    EXPECT(network.usefulOptions_ == initial);
+}
+
+STUDENT_TEST("Ranking options by uncovered cities puts the option that reaches the most first.") {
+    /*
+     * Supplying E covers D and E, so the options of C now reach 3, 2, and 1 uncovered cities.
+     *
+     *        A----B----C----D----E
+     */
+    const std::map<std::string, std::set<std::string>> roads = {
+        {"A", {"B"}},
+        {"B", {"A", "C"}},
+        {"C", {"B", "D"}},
+        {"D", {"C", "E"}},
+        {"E", {"D"}},
+    };
+    Dx::DisasterTags network(roads);
+    network.setOptionOrder(Dx::DisasterTags::OptionOrder::MOST_UNCOVERED);
+    int supplied = 0;
+    for (int i = network.grid_[5].down; i != 5 && !supplied; i = network.grid_[i].down) {
+        if (network.getSupplyName(network.coverCity(i, 1)) == "E") {
+            supplied = i;
+        } else {
+            network.uncoverCity(i);
+        }
+    }
+    std::vector<int> ranked = {};
+    network.rankOptions(3, ranked);
+    std::vector<int> reach = {};
+    for (int option : ranked) {
+        reach.push_back(network.liveCities_[network.optionOf_[option]]);
+    }
+    EXPECT(reach == std::vector<int>({3, 2, 1}));
+    network.uncoverCity(supplied);
+
+    std::set<std::string> supplies = {};
+    EXPECT_EQUAL(network.findMinimumSupplies(supplies), 2);
+    supplies.clear();
+    EXPECT(network.hasDisasterCoverage(2, supplies));
+    EXPECT_EQUAL(supplies.size(), 2);
+}
+
+STUDENT_TEST("Symmetries of a grid leave the minimum and the count of configurations unchanged.") {
+    std::map<std::string, std::set<std::string>> grid;
+    char maxRow = 'D';
+    int  maxCol = 4;
+    for (char row = 'A'; row <= maxRow; row++) {
+        for (int col = 1; col <= maxCol; col++) {
+            if (row != maxRow) {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != maxCol) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+    Dx::NetworkGraph graph(grid);
+    Dx::DisasterTags plain(graph);
+    Dx::DisasterTags network(graph);
+    Dx::SymmetryGroup symmetries(graph);
+    EXPECT_EQUAL(symmetries.size(), 8);
+    network.setSymmetries(symmetries);
+    const std::vector<Dx::DisasterTags::cityHeader> atRest = network.table_;
+
+    std::set<std::string> supplies = {};
+    EXPECT_EQUAL(network.findMinimumSupplies(supplies), 4);
+    for (const auto& city : grid) {
+        EXPECT(checkCovered(city.first, grid, supplies));
+    }
+    supplies.clear();
+    EXPECT(!network.hasDisasterCoverage(3, supplies));
+    EXPECT(network.hasDisasterCoverage(4, supplies));
+
+    // At the minimum every configuration is minimal, and above it symmetries must not change a count.
+    uint64_t minimumCount = plain.countDisasterConfigurations(4);
+    EXPECT_EQUAL(plain.countMinimalConfigurations(4), minimumCount);
+    EXPECT_EQUAL(network.countMinimalConfigurations(4), minimumCount);
+    EXPECT_EQUAL(network.countMinimalConfigurations(5), plain.countMinimalConfigurations(5));
+    EXPECT_EQUAL(network.countMinimalConfigurations(3), 0);
+    EXPECT(network.table_ == atRest);
+    EXPECT_EQUAL(network.chosenKey_, 0);
+    EXPECT_EQUAL(network.forbiddenKey_, 0);
+
+    // Cities without roads may be swapped freely but the grid does not allow it.
+    Dx::NetworkGraph noRoads(graph.names_, std::vector<int>(graph.numVertices() + 1, 0), {});
+    EXPECT_ERROR(network.setSymmetries(Dx::SymmetryGroup(noRoads, 2)));
+    EXPECT_ERROR(network.setSymmetries(Dx::SymmetryGroup(3)));
+}
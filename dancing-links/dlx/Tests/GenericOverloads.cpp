@@ -1,4 +1,5 @@
 #include "GenericOverloads.h"
+#include "Src/DisasterUtilities.h"
 
 namespace std {
 
@@ -25,3 +26,20 @@ std::ostream& operator<<(std::ostream& os, const std::set<std::set<std::string>>
 }
 
 } // namespace std
+
+std::map<std::string, std::set<std::string>> makeGrid(int size) {
+    std::map<std::string, std::set<std::string>> grid = {};
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            std::string city = char('A' + row) + std::to_string(col);
+            grid[city] = {};
+            if (row + 1 < size) {
+                grid[city].insert(char('A' + row + 1) + std::to_string(col));
+            }
+            if (col + 1 < size) {
+                grid[city].insert(char('A' + row) + std::to_string(col + 1));
+            }
+        }
+    }
+    return makeMap(grid);
+}
@@ -1,5 +1,6 @@
 #ifndef GENERICOVERLOADS_H
 #define GENERICOVERLOADS_H
+#include <map>
 #include <string>
 #include <ostream>
 #include <set>
@@ -13,4 +14,10 @@ std::ostream& operator<<(std::ostream& os, const std::set<std::set<std::string>>
 
 } // namespace std
 
+/* Builds a square grid of cities with roads to the cities above, below, left, and right. Cities
+ * are named by a row letter and a column digit, so the sorted names number the city at row r and
+ * column c as r * size + c. Keep size at ten or less for the names to sort that way.
+ */
+std::map<std::string, std::set<std::string>> makeGrid(int size);
+
 #endif // GENERICOVERLOADS_H
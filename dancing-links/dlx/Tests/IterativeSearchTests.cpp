@@ -0,0 +1,315 @@
+#include <functional>
+#include "Src/IterativeSearch.h"
+#include "Src/DisasterLinks.h"
+#include "Src/DisasterTags.h"
+#include "Src/PartnerLinks.h"
+#include "Src/DisasterUtilities.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * * *    Iterative Search Tests    * * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("The explicit stack finds a cover exactly when the recursive searches do.") {
+    /*
+     *        A----B----C
+     *        |    |    |
+     *        D----E----F----G
+     */
+    const std::map<std::string, std::set<std::string>> cities = makeMap({
+        {"A", {"B", "D"}},
+        {"B", {"C", "E"}},
+        {"C", {"F"}},
+        {"D", {"E"}},
+        {"E", {"F"}},
+        {"F", {"G"}},
+    });
+    Dx::DisasterLinks links(cities);
+    Dx::DisasterTags tags(cities);
+    const std::vector<std::set<std::string>> atRest = tags.getUniqueDisasterConfigurations(3);
+    for (int numSupplies = 0; numSupplies <= 3; numSupplies++) {
+        std::set<std::string> recursive = {};
+        bool isCovered = links.isDisasterReady(numSupplies, recursive);
+        EXPECT_EQUAL(tags.hasDisasterCoverage(numSupplies, recursive), isCovered);
+
+        Dx::IterativeSearch<Dx::DisasterLinks,int> linksSearch(numSupplies, Dx::SearchMode::DECIDE);
+        Dx::IterativeSearch<Dx::DisasterTags,int> tagsSearch(numSupplies, Dx::SearchMode::DECIDE);
+        std::vector<int> linksCover = {};
+        std::vector<int> tagsCover = {};
+        EXPECT_EQUAL(linksSearch.findCover(links, linksCover), isCovered);
+        EXPECT_EQUAL(tagsSearch.findCover(tags, tagsCover), isCovered);
+        std::set<std::string> supplies = {};
+        for (int option : tagsCover) {
+            supplies.insert(tags.getSupplyName(option));
+        }
+        for (const auto& city : cities) {
+            EXPECT_EQUAL(checkCovered(city.first, cities, supplies), isCovered);
+        }
+        EXPECT_EQUAL(linksSearch.depth(), 0);
+    }
+    EXPECT(tags.getUniqueDisasterConfigurations(3) == atRest);
+
+    /*
+     *       A --- B --- C
+     *       |     |     |
+     *       F --- E --- D
+     */
+    const std::map<std::string, std::set<std::string>> ring = {
+        {"A", {"B", "F"}},
+        {"B", {"A", "C", "E"}},
+        {"C", {"B", "D"}},
+        {"D", {"C", "E"}},
+        {"E", {"B", "D", "F"}},
+        {"F", {"A", "E"}},
+    };
+    const std::map<std::string, std::set<std::string>> triangle = {
+        {"A", {"B", "C"}},
+        {"B", {"A", "C"}},
+        {"C", {"A", "B"}},
+    };
+    for (const auto& people : {ring, triangle}) {
+        Dx::PartnerLinks network(people);
+        std::set<Pair> recursive = {};
+        Dx::IterativeSearch<Dx::PartnerLinks,Pair> search(people.size(), Dx::SearchMode::DECIDE);
+        std::vector<Pair> pairs = {};
+        EXPECT_EQUAL(search.findCover(network, pairs), network.hasPerfectLinks(recursive));
+        EXPECT_EQUAL(std::set<Pair>(pairs.begin(), pairs.end()), recursive);
+    }
+}
+
+STUDENT_TEST("Visiting covers with the stack matches the unique enumerations of the solvers.") {
+    std::map<std::string, std::set<std::string>> grid;
+    for (char row = 'A'; row <= 'C'; row++) {
+        for (int col = 1; col <= 4; col++) {
+            grid[row + std::to_string(col)];
+            if (row != 'C') {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != 4) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+    Dx::DisasterTags network(grid);
+    for (int numSupplies = 2; numSupplies <= 4; numSupplies++) {
+        Dx::IterativeSearch<Dx::DisasterTags,int> search(numSupplies, Dx::SearchMode::UNIQUE);
+        std::vector<std::set<std::string>> found = {};
+        EXPECT(search.visitCovers(network, [&](const std::vector<int>& supplies) {
+            found.emplace_back();
+            for (int option : supplies) {
+                found.back().insert(network.getSupplyName(option));
+            }
+            return true;
+        }));
+        EXPECT(found == network.getUniqueDisasterConfigurations(numSupplies));
+    }
+
+    // A visitor that stops early leaves the network ready for the next search.
+    Dx::IterativeSearch<Dx::DisasterTags,int> search(4, Dx::SearchMode::UNIQUE);
+    int seen = 0;
+    EXPECT(!search.visitCovers(network, [&](const std::vector<int>&) {
+        return ++seen < 2;
+    }));
+    EXPECT_EQUAL(seen, 2);
+    EXPECT_EQUAL(search.depth(), 0);
+    EXPECT_EQUAL(network.countDisasterConfigurations(4),
+                 network.getUniqueDisasterConfigurations(4).size());
+
+    const std::map<std::string, std::set<std::string>> people = {
+        {"A", {"B", "F"}},
+        {"B", {"A", "C", "E"}},
+        {"C", {"B", "D"}},
+        {"D", {"C", "E"}},
+        {"E", {"B", "D", "F"}},
+        {"F", {"A", "E"}},
+    };
+    Dx::PartnerLinks matches(people);
+    Dx::IterativeSearch<Dx::PartnerLinks,Pair> matchSearch(people.size() / 2,
+                                                           Dx::SearchMode::UNIQUE);
+    std::vector<std::set<Pair>> matchings = {};
+    EXPECT(matchSearch.visitCovers(matches, [&](const std::vector<Pair>& pairs) {
+        matchings.emplace_back(pairs.begin(), pairs.end());
+        return true;
+    }));
+    EXPECT_EQUAL(matchings, matches.getAllPerfectLinks());
+}
+
+STUDENT_TEST("The stack searches find what the recursive searches they replaced found.") {
+    std::map<std::string, std::set<std::string>> grid;
+    for (char row = 'A'; row <= 'C'; row++) {
+        for (int col = 1; col <= 4; col++) {
+            grid[row + std::to_string(col)];
+            if (row != 'C') {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != 4) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+    Dx::DisasterTags tags(grid);
+    Dx::DisasterLinks links(grid);
+
+    // The recursions the enumerations used before the stack, built from the same cover operations.
+    std::function<void(int, std::vector<int>&, std::set<std::set<std::string>>&)> fillConfigurations
+            = [&](int numSupplies, std::vector<int>& supplies,
+                  std::set<std::set<std::string>>& allConfigurations) {
+        if (tags.table_[0].right == 0 && numSupplies >= 0) {
+            std::set<std::string> suppliedCities = {};
+            tags.nameSupplies(supplies, suppliedCities);
+            allConfigurations.insert(suppliedCities);
+            return;
+        }
+        if (numSupplies <= 0) {
+            return;
+        }
+        int chosenIndex = tags.chooseIsolatedCity();
+        for (int cur = tags.grid_[chosenIndex].down; cur != chosenIndex;
+                cur = tags.grid_[cur].down) {
+            supplies.push_back(tags.coverCity(cur, numSupplies));
+            fillConfigurations(numSupplies - 1, supplies, allConfigurations);
+            supplies.pop_back();
+            tags.uncoverCity(cur);
+        }
+    };
+    std::function<void(int, std::vector<int>&, std::vector<std::set<std::string>>&)> fillUnique
+            = [&](int numSupplies, std::vector<int>& supplies,
+                  std::vector<std::set<std::string>>& uniqueConfigurations) {
+        if (tags.table_[0].right == 0 && numSupplies >= 0) {
+            uniqueConfigurations.emplace_back();
+            tags.nameSupplies(supplies, uniqueConfigurations.back());
+            return;
+        }
+        if (numSupplies <= 0) {
+            return;
+        }
+        int chosenIndex = tags.chooseIsolatedCity();
+        for (int cur = tags.grid_[chosenIndex].down; cur != chosenIndex;
+                cur = tags.grid_[cur].down) {
+            supplies.push_back(tags.coverCity(cur, numSupplies));
+            fillUnique(numSupplies - 1, supplies, uniqueConfigurations);
+            supplies.pop_back();
+            tags.uncoverCity(cur);
+            tags.forbidOption(cur);
+        }
+        for (int cur = tags.grid_[chosenIndex].up; cur != chosenIndex; cur = tags.grid_[cur].up) {
+            tags.permitOption(cur);
+        }
+    };
+    int minimum = -1;
+    for (int numSupplies = 0; numSupplies <= 5; numSupplies++) {
+        std::vector<int> supplies = {};
+        std::set<std::set<std::string>> recursive = {};
+        fillConfigurations(numSupplies, supplies, recursive);
+        EXPECT(tags.getAllDisasterConfigurations(numSupplies) == recursive);
+        EXPECT(links.getAllDisasterConfigurations(numSupplies) == recursive);
+        if (minimum == -1 && !recursive.empty()) {
+            minimum = numSupplies;
+        }
+        std::vector<std::set<std::string>> recursiveUnique = {};
+        fillUnique(numSupplies, supplies, recursiveUnique);
+        EXPECT(tags.getUniqueDisasterConfigurations(numSupplies) == recursiveUnique);
+        EXPECT_EQUAL(tags.countDisasterConfigurations(numSupplies), recursiveUnique.size());
+    }
+
+    // The smallest number of supplies with any cover at all is the minimum the stack must find.
+    std::set<std::string> tagsCover = {};
+    std::set<std::string> linksCover = {};
+    EXPECT_EQUAL(tags.findMinimumSupplies(tagsCover), minimum);
+    EXPECT_EQUAL(links.findMinimumSupplies(linksCover), minimum);
+    std::vector<int> supplies = {};
+    std::set<std::set<std::string>> smallest = {};
+    fillConfigurations(minimum, supplies, smallest);
+    EXPECT(smallest.count(tagsCover));
+    EXPECT(smallest.count(linksCover));
+
+    /*
+     *       A --- B --- C
+     *       |     |     |
+     *       F --- E --- D
+     */
+    const std::map<std::string, std::map<std::string, int>> people = {
+        {"A", {{"B", 3}, {"F", 1}}},
+        {"B", {{"A", 3}, {"C", 2}, {"E", 4}}},
+        {"C", {{"B", 2}, {"D", 1}}},
+        {"D", {{"C", 1}, {"E", 5}}},
+        {"E", {{"B", 4}, {"D", 5}, {"F", 2}}},
+        {"F", {{"A", 1}, {"E", 2}}},
+    };
+    Dx::PartnerLinks matches(people);
+
+    // The recursions getAllPerfectLinks and getMaxWeightMatching used before the stack.
+    std::function<void(std::set<Pair>&, std::vector<std::set<Pair>>&)> fillPerfectMatchings
+            = [&](std::set<Pair>& soFar, std::vector<std::set<Pair>>& result) {
+        if (matches.table_[0].right == 0) {
+            result.push_back(soFar);
+            return;
+        }
+        int chosen = matches.choosePerson();
+        if (chosen == -1) {
+            return;
+        }
+        for (int cur = matches.links_[chosen].down; cur != chosen; cur = matches.links_[cur].down) {
+            Pair match = matches.coverPairing(cur);
+            soFar.insert(match);
+            fillPerfectMatchings(soFar, result);
+            matches.uncoverPairing(cur);
+            soFar.erase(match);
+        }
+    };
+    using Weights = std::pair<int,std::set<Pair>>;
+    std::function<void(Dx::PartnerLinks&, Weights&, Weights&)> fillWeights
+            = [&](Dx::PartnerLinks& network, Weights& soFar, Weights& winner) {
+        if (network.table_[0].right == 0) {
+            return;
+        }
+        int chosen = network.chooseWeightedPerson();
+        if (chosen == -1) {
+            return;
+        }
+        network.hidePerson(chosen);
+        fillWeights(network, soFar, winner);
+        network.unhidePerson(chosen);
+        for (int cur = network.links_[chosen].down; cur != chosen; cur = network.links_[cur].down) {
+            std::pair<int,Pair> match = network.coverWeightedPair(cur);
+            soFar.first += match.first;
+            soFar.second.insert(match.second);
+            fillWeights(network, soFar, winner);
+            if (soFar.first > winner.first) {
+                winner = soFar;
+            }
+            network.uncoverPairing(cur);
+            soFar.first -= match.first;
+            soFar.second.erase(match.second);
+        }
+    };
+    std::set<Pair> pairs = {};
+    std::vector<std::set<Pair>> recursiveMatchings = {};
+    fillPerfectMatchings(pairs, recursiveMatchings);
+    EXPECT_EQUAL(matches.getAllPerfectLinks(), recursiveMatchings);
+    EXPECT_EQUAL(matches.countPerfectLinks(), recursiveMatchings.size());
+
+    Weights soFar = {};
+    Weights winner = {};
+    fillWeights(matches, soFar, winner);
+    EXPECT_EQUAL(matches.getMaxWeightMatching(), winner.second);
+
+    // With no Perfect Matching the heaviest matching must leave someone out.
+    const std::map<std::string, std::map<std::string, int>> star = {
+        {"A", {{"B", 2}, {"C", 6}, {"D", 3}}},
+        {"B", {{"A", 2}}},
+        {"C", {{"A", 6}, {"E", 1}}},
+        {"D", {{"A", 3}, {"E", 4}}},
+        {"E", {{"C", 1}, {"D", 4}}},
+    };
+    Dx::PartnerLinks starMatches(star);
+    soFar = {};
+    winner = {};
+    fillWeights(starMatches, soFar, winner);
+    EXPECT_EQUAL(starMatches.getMaxWeightMatching(), winner.second);
+    EXPECT_EQUAL(winner.second, { {"A", "C"}, {"D", "E"} });
+}
@@ -0,0 +1,66 @@
+#include "Src/NetworkGraph.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * * * * *   Compact Graph Tests  * * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("Map networks are numbered in name order with sorted arcs and no links to self.") {
+    /*
+     *        B----A
+     *        |  /
+     *        | /
+     *        C    D
+     */
+    const std::map<std::string, std::set<std::string>> roads = {
+        {"A", {"B", "C"}},
+        {"B", {"A", "B", "C"}},
+        {"C", {"A", "B"}},
+        {"D", {}},
+    };
+    Dx::NetworkGraph graph(roads);
+    EXPECT_EQUAL(graph.numVertices(), 4);
+    EXPECT_EQUAL(graph.numArcs(), 6);
+    EXPECT(!graph.isWeighted());
+    std::vector<std::string> names = {"A", "B", "C", "D"};
+    std::vector<int> offsets = {0, 2, 4, 6, 6};
+    std::vector<int> neighbors = {1, 2, 0, 2, 0, 1};
+    EXPECT(graph.names_ == names);
+    EXPECT(graph.offsets_ == offsets);
+    EXPECT(graph.neighbors_ == neighbors);
+    EXPECT_EQUAL(graph.degree(1), 2);
+    EXPECT_EQUAL(graph.degree(3), 0);
+
+    const std::map<std::string, std::map<std::string,int>> weighted = {
+        {"A", {{"B", 3}, {"C", -1}}},
+        {"B", {{"A", 4}}},
+        {"C", {}},
+    };
+    Dx::NetworkGraph weightedGraph(weighted);
+    EXPECT(weightedGraph.isWeighted());
+    std::vector<int> weightedNeighbors = {1, 2, 0};
+    std::vector<int> weights = {3, -1, 4};
+    EXPECT(weightedGraph.neighbors_ == weightedNeighbors);
+    EXPECT(weightedGraph.weights_ == weights);
+}
+
+STUDENT_TEST("Hand built arrays are sorted with their weights and bad arrays are rejected.") {
+    Dx::NetworkGraph graph({"X", "Y", "Z"}, {0, 2, 3, 4}, {2, 1, 0, 0}, {7, 5, 5, 7});
+    EXPECT(graph.isWeighted());
+    std::vector<int> neighbors = {1, 2, 0, 0};
+    std::vector<int> weights = {5, 7, 5, 7};
+    EXPECT(graph.neighbors_ == neighbors);
+    EXPECT(graph.weights_ == weights);
+    EXPECT_EQUAL(graph.name(2), "Z");
+    EXPECT_EQUAL(graph.arcsBegin(1), 2);
+    EXPECT_EQUAL(graph.arcsEnd(1), 3);
+
+    EXPECT_ERROR(Dx::NetworkGraph({"X", "Y"}, {0, 1}, {1}));
+    EXPECT_ERROR(Dx::NetworkGraph({"X", "Y"}, {0, 1, 1}, {0}));
+    EXPECT_ERROR(Dx::NetworkGraph({"X", "Y"}, {0, 2, 2}, {1, 1}));
+    EXPECT_ERROR(Dx::NetworkGraph({"X", "Y"}, {0, 1, 2}, {1, 2}));
+    EXPECT_ERROR(Dx::NetworkGraph({"X", "Y"}, {0, 1, 2}, {1, 0}, {3}));
+    const std::map<std::string, std::set<std::string>> missing = {{"A", {"B"}}};
+    EXPECT_ERROR(Dx::NetworkGraph{missing});
+}
@@ -0,0 +1,45 @@
+#include "Src/NogoodTable.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * * * *   Nogood Table Tests   * * * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("A nogood refutes the same items with as many or fewer supplies only.") {
+    Dx::NogoodTable table(4);
+    table.prepare();
+    uint64_t key = Dx::NogoodTable::itemKey(1) ^ Dx::NogoodTable::itemKey(2);
+    EXPECT(!table.isInfeasible(key, 1));
+    table.recordInfeasible(key, 3);
+    EXPECT(table.isInfeasible(key, 3));
+    EXPECT(table.isInfeasible(key, 1));
+    EXPECT(!table.isInfeasible(key, 4));
+    EXPECT(!table.isInfeasible(key ^ Dx::NogoodTable::itemKey(3), 1));
+    Dx::NogoodTable::NogoodStats stats = table.getStats();
+    EXPECT_EQUAL(stats.hits, 2);
+    EXPECT_EQUAL(stats.misses, 3);
+    EXPECT_EQUAL(stats.stores, 1);
+}
+
+STUDENT_TEST("A full bucket keeps its strongest proof and the newest of the others.") {
+    // One bucket forces every key to compete for the same two entries.
+    Dx::NogoodTable table(1);
+    table.prepare();
+    uint64_t strong = Dx::NogoodTable::itemKey(1);
+    uint64_t weak = Dx::NogoodTable::itemKey(2);
+    uint64_t newest = Dx::NogoodTable::itemKey(3);
+    table.recordInfeasible(strong, 5);
+    table.recordInfeasible(weak, 2);
+    table.recordInfeasible(newest, 1);
+    EXPECT(table.isInfeasible(strong, 5));
+    EXPECT(table.isInfeasible(newest, 1));
+    EXPECT(!table.isInfeasible(weak, 2));
+    EXPECT_EQUAL(table.getStats().evictions, 1);
+
+    // A stronger proof takes the first entry and the old one moves down.
+    table.recordInfeasible(weak, 6);
+    EXPECT(table.isInfeasible(weak, 6));
+    EXPECT(table.isInfeasible(strong, 5));
+    EXPECT(!table.isInfeasible(newest, 1));
+}
@@ -1,4 +1,5 @@
 #include "Src/PartnerLinks.h"
+#include "Src/ParallelSearch.h"
 
 namespace DancingLinks {
 
@@ -13,11 +14,11 @@ bool operator!=(const PartnerLinks::personLink& lhs, const PartnerLinks::personL
     return !(lhs == rhs);
 }
 
-bool operator==(const PartnerLinks::personName& lhs, const PartnerLinks::personName& rhs) {
-    return lhs.name == rhs.name && lhs.left == rhs.left && lhs.right == rhs.right;
+bool operator==(const PartnerLinks::personHeader& lhs, const PartnerLinks::personHeader& rhs) {
+    return lhs.left == rhs.left && lhs.right == rhs.right;
 }
 
-bool operator!=(const PartnerLinks::personName& lhs, const PartnerLinks::personName& rhs) {
+bool operator!=(const PartnerLinks::personHeader& lhs, const PartnerLinks::personHeader& rhs) {
     return !(lhs == rhs);
 }
 
@@ -27,8 +28,8 @@ std::ostream& operator<<(std::ostream& os, const PartnerLinks::personLink& perso
     return os;
 }
 
-std::ostream& operator<<(std::ostream& os, const PartnerLinks::personName& name) {
-    os << "{ name: " << name.name << ", left: " << name.left << ", right: " << name.right << " }";
+std::ostream& operator<<(std::ostream& os, const PartnerLinks::personHeader& name) {
+    os << "{ left: " << name.left << ", right: " << name.right << " }";
     return os;
 }
 
@@ -44,18 +45,19 @@ std::ostream& operator<<(std::ostream&os, const std::vector<PartnerLinks::person
     return os;
 }
 
-std::ostream& operator<<(std::ostream&os, const std::vector<PartnerLinks::personName>& links) {
+std::ostream& operator<<(std::ostream&os, const std::vector<PartnerLinks::personHeader>& links) {
     os << "LOOKUP TABLE" << std::endl;
     for (const auto& item : links) {
-        os << "{\"" << item.name << "\"," << item.left << "," << item.right << "}" << std::endl;
+        os << "{" << item.left << "," << item.right << "}" << std::endl;
     }
     return os;
 }
 
 std::ostream& operator<<(std::ostream&os, const PartnerLinks& links) {
     os << "LOOKUP ARRAY" << std::endl;
-    for (const auto& header : links.table_) {
-        os << "{\"" << header.name << "\"," << header.left << "," << header.right << "},";
+    for (int i = 0; i < links.table_.size(); i++) {
+        os << "{\"" << links.personNames_[i] << "\"," << links.table_[i].left << ","
+           << links.table_[i].right << "},";
     }
     os << std::endl;
     os << "DLX ARRAY" << std::endl;
@@ -88,8 +90,8 @@ namespace Dx = DancingLinks;
 
 STUDENT_TEST("Empty is empty.") {
     const std::map<std::string, std::map<std::string,int>> provided = {};
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",0,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {0,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         {0,0,0},
@@ -115,8 +117,8 @@ STUDENT_TEST("Weighted matching initializes straight line correctly.") {
         {"E", {{"B", 5}}},
         {"F", {{"A", 3}, {"B",4}}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /* Standard Line. Two people on ends should have one connection.
@@ -146,6 +148,9 @@ STUDENT_TEST("Weighted matching initializes straight line correctly.") {
     Dx::PartnerLinks matches(provided);
     EXPECT_EQUAL(lookup, matches.table_);
     EXPECT_EQUAL(dlxItems, matches.links_);
+    // Names sit in their own array at the same index as the links of each person.
+    std::vector<std::string> names = {"", "A", "B", "C", "D", "E", "F"};
+    EXPECT(matches.personNames_ == names);
 }
 
 STUDENT_TEST("Weighted matching does not care about leaving others out.") {
@@ -163,8 +168,8 @@ STUDENT_TEST("Weighted matching does not care about leaving others out.") {
         {"B", {{"A",10}, {"C",2}}},
         {"C", {{"A",2},{"B", 2}}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",3,1},{"A",0,2},{"B",1,3},{"C",2,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {3,1},{0,2},{1,3},{2,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -210,8 +215,8 @@ STUDENT_TEST("Covering a person in weighted will only take that person's pairs o
         {"B", {{"A",10}, {"C",2}}},
         {"C", {{"A",2},{"B", 2}}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",3,1},{"A",0,2},{"B",1,3},{"C",2,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {3,1},{0,2},{1,3},{2,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -239,8 +244,8 @@ STUDENT_TEST("Covering a person in weighted will only take that person's pairs o
 
     matches.hidePerson(5);
 
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",3,2},{"A",0,2},{"B",0,3},{"C",2,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {3,2},{0,2},{0,3},{2,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -285,8 +290,8 @@ STUDENT_TEST("All weights are unique so we can know that we report the right wei
         {"C", {{"A", 4}, {"D",5}}},
         {"D", {{"B", 6}, {"C",5}}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",4,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {4,1},{0,2},{1,3},{2,4},{3,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -318,8 +323,8 @@ STUDENT_TEST("All weights are unique so we can know that we report the right wei
     EXPECT_EQUAL(match.first, 3);
     EXPECT_EQUAL(match.second, {"A","B"});
 
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",4,3},{"A",0,2},{"B",0,3},{"C",0,4},{"D",3,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {4,3},{0,2},{0,3},{0,4},{3,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /* Smaller links with A covered via option 1.
@@ -436,8 +441,8 @@ PROVIDED_TEST("maximumWeightMatching: Odd shap that requires us to pick opposite
         {"E", {{"C",1}}},
         {"F", {{"A",1}}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -495,8 +500,8 @@ PROVIDED_TEST("maximumWeightMatching: Another permutation of the same shape is f
         {"E", {{"D",1}}},
         {"F", {{"A",1}}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -555,8 +560,8 @@ PROVIDED_TEST("maximumWeightMatching: The network resets after every run.") {
         {"E", {{"C",1}}},
         {"F", {{"A",1}}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -697,8 +702,8 @@ PROVIDED_TEST("maximumWeightMatching: Large stress test (should take at most a s
 
 STUDENT_TEST("Empty is empty perfect matching.") {
     const std::map<std::string, std::set<std::string>> provided = {};
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",0,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {0,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         {0,0,0},
@@ -724,8 +729,8 @@ STUDENT_TEST("Line of six but tricky due to natural order.") {
         {"E", {"B"}},
         {"F", {"A", "B"}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /* Standard Line. Two people on ends should have one connection.
@@ -772,8 +777,8 @@ STUDENT_TEST("We will allow setup of worlds that are impossible to match.") {
         { "B", {"C"} },
         { "C", {"A"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",3,1},{"A",0,2},{"B",1,3},{"C",2,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {3,1},{0,2},{1,3},{2,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -818,8 +823,8 @@ STUDENT_TEST("Initialize a world that will have matching.") {
         { "E", {"C", "D"} },
         { "F", {"A", "B"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -874,8 +879,8 @@ STUDENT_TEST("std::setup works on a disconnected hexagon of people and reportes
         { "E", {"C", "D"} },
         { "F", {"B"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -923,8 +928,8 @@ STUDENT_TEST("Simple square any valid partners will work. Cover A.") {
         { "C",{"A","D"}},
         { "D",{"C","B"}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",4,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {4,1},{0,2},{1,3},{2,4},{3,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -955,8 +960,8 @@ STUDENT_TEST("Simple square any valid partners will work. Cover A.") {
     Pair match = matches.coverPairing(6);
     EXPECT_EQUAL(match, {"A","B"});
 
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",4,3},{"A",0,2},{"B",0,3},{"C",0,4},{"D",3,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {4,3},{0,2},{0,3},{0,4},{3,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /* Smaller links with A covered via option 1.
@@ -996,8 +1001,8 @@ STUDENT_TEST("There are no perfect pairings, any matching will fail.") {
         { "B", {"C"} },
         { "C", {"A"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",3,1},{"A",0,2},{"B",1,3},{"C",2,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {3,1},{0,2},{1,3},{2,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1025,8 +1030,8 @@ STUDENT_TEST("There are no perfect pairings, any matching will fail.") {
 
     Pair match = matches.coverPairing(5);
     EXPECT_EQUAL(match, {"A", "B"});
-    std::vector<Dx::PartnerLinks::personName> lookupA {
-        {"",3,3},{"A",0,2},{"B",0,3},{"C",0,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupA {
+        {3,3},{0,2},{0,3},{0,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1068,8 +1073,8 @@ STUDENT_TEST("We will quickly learn that A-B is a bad pairing that leaves C out.
         { "C", {"B"} },
         { "D", {"A","B"}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",4,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {4,1},{0,2},{1,3},{2,4},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1100,8 +1105,8 @@ STUDENT_TEST("We will quickly learn that A-B is a bad pairing that leaves C out.
 
     Pair match = matches.coverPairing(6);
     EXPECT_EQUAL(match, {"A", "B"});
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",4,3},{"A",0,2},{"B",0,3},{"C",0,4},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {4,3},{0,2},{0,3},{0,4},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1145,8 +1150,8 @@ STUDENT_TEST("A-D is a good pairing.") {
         { "C", {"B"} },
         { "D", {"A","B"}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",4,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {4,1},{0,2},{1,3},{2,4},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1177,8 +1182,8 @@ STUDENT_TEST("A-D is a good pairing.") {
 
     Pair match = matches.coverPairing(9);
     EXPECT_EQUAL(match, {"A", "D"});
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",3,2},{"A",0,2},{"B",0,3},{"C",2,0},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {3,2},{0,2},{0,3},{2,0},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1222,8 +1227,8 @@ STUDENT_TEST("Cover A in a world where everyone has two connections.") {
         { "E", {"C", "D"} },
         { "F", {"A", "B"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1260,8 +1265,8 @@ STUDENT_TEST("Cover A in a world where everyone has two connections.") {
     Pair match = matches.coverPairing(8);
     EXPECT_EQUAL(match, {"A","D"});
 
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",6,2},{"A",0,2},{"B",0,3},{"C",2,5},{"D",3,5},{"E",3,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {6,2},{0,2},{0,3},{2,5},{3,5},{3,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1308,8 +1313,8 @@ STUDENT_TEST("A-D then B-C solves the world.") {
         { "C", {"B"} },
         { "D", {"A","B"}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",4,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {4,1},{0,2},{1,3},{2,4},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1340,8 +1345,8 @@ STUDENT_TEST("A-D then B-C solves the world.") {
 
     Pair match = matches.coverPairing(9);
     EXPECT_EQUAL(match, {"A", "D"});
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",3,2},{"A",0,2},{"B",0,3},{"C",2,0},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {3,2},{0,2},{0,3},{2,0},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1368,8 +1373,8 @@ STUDENT_TEST("A-D then B-C solves the world.") {
 
     match = matches.coverPairing(12);
     EXPECT_EQUAL(match, {"B", "C"});
-    std::vector<Dx::PartnerLinks::personName> lookupCoverB {
-        {"",0,0},{"A",0,2},{"B",0,3},{"C",0,0},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverB {
+        {0,0},{0,2},{0,3},{0,0},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverB {
         /*
@@ -1416,8 +1421,8 @@ STUDENT_TEST("Simple square any valid partners will work. Cover A then uncover."
         { "C",{"A","D"}},
         { "D",{"C","B"}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",4,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {4,1},{0,2},{1,3},{2,4},{3,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1448,8 +1453,8 @@ STUDENT_TEST("Simple square any valid partners will work. Cover A then uncover."
     Pair match = matches.coverPairing(6);
     EXPECT_EQUAL(match, {"A","B"});
 
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",4,3},{"A",0,2},{"B",0,3},{"C",0,4},{"D",3,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {4,3},{0,2},{0,3},{0,4},{3,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /* Smaller links with A covered via option 1.
@@ -1494,8 +1499,8 @@ STUDENT_TEST("There are no perfect pairings, any matching will fail. Cover uncov
         { "B", {"C"} },
         { "C", {"A"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",3,1},{"A",0,2},{"B",1,3},{"C",2,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {3,1},{0,2},{1,3},{2,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1523,8 +1528,8 @@ STUDENT_TEST("There are no perfect pairings, any matching will fail. Cover uncov
 
     Pair match = matches.coverPairing(5);
     EXPECT_EQUAL(match, {"A", "B"});
-    std::vector<Dx::PartnerLinks::personName> lookupA {
-        {"",3,3},{"A",0,2},{"B",0,3},{"C",0,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupA {
+        {3,3},{0,2},{0,3},{0,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1570,8 +1575,8 @@ STUDENT_TEST("We will quickly learn that A-B is a bad pairing that leaves C out.
         { "C", {"B"} },
         { "D", {"A","B"}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",4,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {4,1},{0,2},{1,3},{2,4},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1602,8 +1607,8 @@ STUDENT_TEST("We will quickly learn that A-B is a bad pairing that leaves C out.
 
     Pair match = matches.coverPairing(6);
     EXPECT_EQUAL(match, {"A", "B"});
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",4,3},{"A",0,2},{"B",0,3},{"C",0,4},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {4,3},{0,2},{0,3},{0,4},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1647,8 +1652,8 @@ STUDENT_TEST("A-D is a good pairing. Cover then uncover.") {
         { "C", {"B"} },
         { "D", {"A","B"}},
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",4,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {4,1},{0,2},{1,3},{2,4},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1679,8 +1684,8 @@ STUDENT_TEST("A-D is a good pairing. Cover then uncover.") {
 
     Pair match = matches.coverPairing(9);
     EXPECT_EQUAL(match, {"A", "D"});
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",3,2},{"A",0,2},{"B",0,3},{"C",2,0},{"D",3,0}
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {3,2},{0,2},{0,3},{2,0},{3,0}
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1728,8 +1733,8 @@ STUDENT_TEST("Cover A in a world where everyone has two connections then uncover
         { "E", {"C", "D"} },
         { "F", {"A", "B"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1766,8 +1771,8 @@ STUDENT_TEST("Cover A in a world where everyone has two connections then uncover
     Pair match = matches.coverPairing(8);
     EXPECT_EQUAL(match, {"A","D"});
 
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",6,2},{"A",0,2},{"B",0,3},{"C",2,5},{"D",3,5},{"E",3,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {6,2},{0,2},{0,3},{2,5},{3,5},{3,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1820,8 +1825,8 @@ STUDENT_TEST("Depth two cover and uncover. Cover A then B then uncover B.") {
         { "E", {"C", "D"} },
         { "F", {"A", "B"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",6,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {6,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -1858,8 +1863,8 @@ STUDENT_TEST("Depth two cover and uncover. Cover A then B then uncover B.") {
     Pair match = matches.coverPairing(8);
     EXPECT_EQUAL(match, {"A","D"});
 
-    std::vector<Dx::PartnerLinks::personName> lookupCoverA {
-        {"",6,2},{"A",0,2},{"B",0,3},{"C",2,5},{"D",3,5},{"E",3,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverA {
+        {6,2},{0,2},{0,3},{2,5},{3,5},{3,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverA {
         /*
@@ -1893,8 +1898,8 @@ STUDENT_TEST("Depth two cover and uncover. Cover A then B then uncover B.") {
     match = matches.coverPairing(14);
     EXPECT_EQUAL(match, {"B","C"});
 
-    std::vector<Dx::PartnerLinks::personName> lookupCoverB {
-        {"",6,5},{"A",0,2},{"B",0,3},{"C",0,5},{"D",3,5},{"E",0,6},{"F",5,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookupCoverB {
+        {6,5},{0,2},{0,3},{0,5},{3,5},{0,6},{5,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxCoverB {
         /*
@@ -1961,8 +1966,8 @@ STUDENT_TEST("Largest shape I will do by hand. After successive calls the networ
         { "I", {"H", "J"} },
         { "J", {"A", "G", "I"} }
     };
-    std::vector<Dx::PartnerLinks::personName> lookup {
-        {"",10,1},{"A",0,2},{"B",1,3},{"C",2,4},{"D",3,5},{"E",4,6},{"F",5,7},{"G",6,8},{"H",7,9},{"I",8,10},{"J",9,0},
+    std::vector<Dx::PartnerLinks::personHeader> lookup {
+        {10,1},{0,2},{1,3},{2,4},{3,5},{4,6},{5,7},{6,8},{7,9},{8,10},{9,0},
     };
     std::vector<Dx::PartnerLinks::personLink> dlxItems {
         /*
@@ -2392,6 +2397,41 @@ PROVIDED_TEST("hasPerfectMatching stress test: positive example (should take und
 }
 
 
+STUDENT_TEST("Work stealing search agrees with the serial search on caterpillars and millipedes.") {
+    const int kRowSize = 10;
+
+    std::vector<Pair> links;
+    for (int i = 0; i < kRowSize - 1; i++) {
+        links.push_back({ std::to_string(i), std::to_string(i + 1) });
+    }
+    for (int i = 0; i < kRowSize; i++) {
+        links.push_back({ std::to_string(i), std::to_string(i + kRowSize) });
+    }
+
+    std::set<Pair> matching;
+    Dx::PartnerLinks millipede(fromLinks(links));
+    EXPECT(millipede.hasPerfectLinks(matching, 4));
+    EXPECT_EQUAL(millipede.getWorkerNodes().size(), 4);
+    EXPECT(isPerfectMatching(fromLinks(links), matching));
+
+    for (int i = 0; i < kRowSize; i++) {
+        links.push_back({ std::to_string(i), std::to_string(i + 2 * kRowSize) });
+    }
+    Dx::PartnerLinks caterpillar(fromLinks(links));
+    matching.clear();
+    Dx::ParallelSearch<Dx::PartnerLinks,Pair> search(caterpillar, 4);
+    EXPECT(!search.hasCover(3 * kRowSize / 2, matching));
+    EXPECT(matching.empty());
+
+    // Every node of the search is entered by exactly one worker, so the counts must all add up.
+    EXPECT_EQUAL(search.nodesPerWorker().size(), 4);
+    long long total = 0;
+    for (long long nodes : search.nodesPerWorker()) {
+        total += nodes;
+    }
+    EXPECT(total > 0);
+}
+
 /* * * * * * * * * * * * *     Bonus: Find All Perfect Matchings        * * * * * * * * * * * * * */
 
 
@@ -2458,3 +2498,97 @@ STUDENT_TEST("All possible pairings is huge, but all perfect matching configs is
     Dx::PartnerLinks network(provided);
     EXPECT_EQUAL(network.getAllPerfectLinks(), allMatches);
 }
+
+STUDENT_TEST("Counting perfect matchings agrees with listing them.") {
+    // Everyone may partner with everyone else so 7 * 5 * 3 * 1 perfect matchings exist.
+    std::map<std::string, std::set<std::string>> everyone = {};
+    for (char person = 'A'; person <= 'H'; person++) {
+        for (char partner = 'A'; partner <= 'H'; partner++) {
+            if (person != partner) {
+                everyone[std::string(1, person)].insert(std::string(1, partner));
+            }
+        }
+    }
+    Dx::PartnerLinks network(everyone);
+    EXPECT_EQUAL(network.countPerfectLinks(), 105);
+    EXPECT_EQUAL(network.getAllPerfectLinks().size(), 105);
+    EXPECT_EQUAL(network.countPerfectLinks(), 105);
+
+    everyone.erase("H");
+    for (auto& [person, partners] : everyone) {
+        partners.erase("H");
+    }
+    Dx::PartnerLinks odd(everyone);
+    EXPECT_EQUAL(odd.countPerfectLinks(), 0);
+}
+
+STUDENT_TEST("A visitor streams perfect matchings and may stop after the first one.") {
+    /*
+     *       A --- B
+     *       |     |
+     *       D --- C
+     */
+    const std::map<std::string, std::set<std::string>> provided = {
+        {"A", {"B", "D"}},
+        {"B", {"A", "C"}},
+        {"C", {"B", "D"}},
+        {"D", {"A", "C"}},
+    };
+    Dx::PartnerLinks network(provided);
+    std::vector<std::set<Pair>> streamed = {};
+    EXPECT(network.visitPerfectLinks([&](const std::vector<int>& pairings) {
+        streamed.emplace_back();
+        for (int pairing : pairings) {
+            streamed.back().insert(network.getPairing(pairing));
+        }
+        return true;
+    }));
+    EXPECT_EQUAL(streamed, network.getAllPerfectLinks());
+
+    std::set<Pair> first = {};
+    EXPECT(!network.visitPerfectLinks([&](const std::vector<int>& pairings) {
+        for (int pairing : pairings) {
+            first.insert(network.getPairing(pairing));
+        }
+        return false;
+    }));
+    EXPECT_EQUAL(first, streamed[0]);
+    EXPECT_EQUAL(network.countPerfectLinks(), 2);
+}
+
+STUDENT_TEST("A world built from a compact graph matches one built from either map.") {
+    /*
+     *        B----A----D
+     *              \  /
+     *               C
+     */
+    const std::map<std::string, std::set<std::string>> provided = {
+        {"A", {"B", "C", "D"}},
+        {"B", {"A"}},
+        {"C", {"A", "D"}},
+        {"D", {"A", "C"}},
+    };
+    Dx::NetworkGraph graph({"A", "B", "C", "D"}, {0, 3, 4, 6, 8}, {3, 1, 2, 0, 3, 0, 2, 0});
+    Dx::PartnerLinks fromMap(provided);
+    Dx::PartnerLinks fromGraph(graph);
+    EXPECT_EQUAL(fromGraph.table_, fromMap.table_);
+    EXPECT_EQUAL(fromGraph.links_, fromMap.links_);
+    std::set<Pair> pairs;
+    EXPECT(fromGraph.hasPerfectLinks(pairs));
+    EXPECT(pairs == std::set<Pair>({{"A", "B"}, {"C", "D"}}));
+
+    // A negative weight from either person leaves out only the pairing that person would make.
+    const std::map<std::string, std::map<std::string,int>> weighted = {
+        {"A", {{"B", 4}, {"C", -1}, {"D", 2}}},
+        {"B", {{"A", 4}}},
+        {"C", {{"A", 3}, {"D", 1}}},
+        {"D", {{"A", 2}, {"C", -1}}},
+    };
+    Dx::NetworkGraph weightedGraph({"A", "B", "C", "D"}, {0, 3, 4, 6, 8},
+                                   {1, 2, 3, 0, 0, 3, 0, 2}, {4, -1, 2, 4, 3, 1, 2, -1});
+    Dx::PartnerLinks weightedFromMap(weighted);
+    Dx::PartnerLinks weightedFromGraph(weightedGraph);
+    EXPECT_EQUAL(weightedFromGraph.table_, weightedFromMap.table_);
+    EXPECT_EQUAL(weightedFromGraph.links_, weightedFromMap.links_);
+    EXPECT_EQUAL(weightedFromGraph.numPairings_, 4);
+}
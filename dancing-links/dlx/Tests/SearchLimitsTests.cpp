@@ -0,0 +1,204 @@
+#include <atomic>
+#include <chrono>
+#include "Src/SearchLimits.h"
+#include "Src/DisasterBits.h"
+#include "Src/DisasterLinks.h"
+#include "Src/DisasterTags.h"
+#include "Src/SymmetryGroup.h"
+#include "Src/PartnerLinks.h"
+#include "Src/DisasterUtilities.h"
+#include "DancingLinks.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * * *    Search Limits Tests     * * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("A budget allows exactly the nodes it was given and then stays spent.") {
+    Dx::SearchLimits limits;
+    limits.maxNodes = 3;
+    Dx::SearchBudget budget(limits);
+    EXPECT(!budget.isSpent());
+    EXPECT(!budget.isSpent());
+    EXPECT(!budget.isSpent());
+    EXPECT(!budget.isAborted());
+    EXPECT(budget.isSpent());
+    EXPECT(budget.isAborted());
+    EXPECT(budget.isSpent());
+
+    Dx::SearchBudget unlimited;
+    for (int node = 0; node < 100000; node++) {
+        EXPECT(!unlimited.isSpent());
+    }
+    EXPECT_EQUAL(unlimited.getNodes(), 100000);
+}
+
+STUDENT_TEST("Node limits abort a disaster search without poisoning the nogoods it keeps.") {
+    const std::map<std::string, std::set<std::string>> grid = makeGrid(5);
+    Dx::DisasterLinks links(grid);
+    Dx::DisasterTags tags(grid);
+    Dx::DisasterBits bits(grid);
+    std::set<std::string> expected = {};
+    int minimum = Dx::DisasterLinks(grid).findMinimumSupplies(expected);
+
+    // Every supply we give out costs a node so no cover can be found with fewer nodes than that.
+    Dx::SearchLimits limits;
+    limits.maxNodes = minimum - 2;
+    Dx::SearchLimits proofLimits;
+    proofLimits.maxNodes = 20;
+    std::set<std::string> supplies = {};
+    EXPECT(links.isDisasterReady(minimum, supplies, limits) == Dx::SearchStatus::ABORTED);
+    EXPECT(tags.hasDisasterCoverage(minimum, supplies, limits) == Dx::SearchStatus::ABORTED);
+    EXPECT(bits.isDisasterReady(minimum, supplies, limits) == Dx::SearchStatus::ABORTED);
+    EXPECT(links.isDisasterReady(minimum - 1, supplies, proofLimits)
+           == Dx::SearchStatus::ABORTED);
+    EXPECT(tags.hasDisasterCoverage(minimum - 1, supplies, proofLimits)
+           == Dx::SearchStatus::ABORTED);
+    EXPECT(bits.isDisasterReady(minimum - 1, supplies, proofLimits)
+           == Dx::SearchStatus::ABORTED);
+    EXPECT(supplies.empty());
+
+    // Every subtree the aborted searches gave up on must still be searched in full.
+    Dx::SearchLimits unlimited;
+    EXPECT(links.isDisasterReady(minimum, supplies, unlimited) == Dx::SearchStatus::FOUND);
+    EXPECT_EQUAL(supplies.size(), minimum);
+    supplies.clear();
+    EXPECT(tags.hasDisasterCoverage(minimum, supplies, unlimited) == Dx::SearchStatus::FOUND);
+    supplies.clear();
+    EXPECT(bits.isDisasterReady(minimum, supplies, unlimited) == Dx::SearchStatus::FOUND);
+    supplies.clear();
+    EXPECT(links.isDisasterReady(minimum - 1, supplies, unlimited)
+           == Dx::SearchStatus::INFEASIBLE);
+    EXPECT(tags.hasDisasterCoverage(minimum - 1, supplies, unlimited)
+           == Dx::SearchStatus::INFEASIBLE);
+    EXPECT(bits.isDisasterReady(minimum - 1, supplies, unlimited)
+           == Dx::SearchStatus::INFEASIBLE);
+
+    // An aborted minimum search reports the best cover it had, which is never below the minimum.
+    std::set<std::string> best = {};
+    EXPECT(links.findMinimumSupplies(best, limits) == Dx::SearchStatus::ABORTED);
+    EXPECT(best.empty() || (int)best.size() >= minimum);
+    best.clear();
+    EXPECT(tags.findMinimumSupplies(best, unlimited) == Dx::SearchStatus::FOUND);
+    EXPECT_EQUAL(best.size(), minimum);
+    best.clear();
+    EXPECT(bits.findMinimumSupplies(best, unlimited) == Dx::SearchStatus::FOUND);
+    EXPECT_EQUAL(best.size(), minimum);
+}
+
+STUDENT_TEST("Cancellation and deadlines stop serial and threaded searches alike.") {
+    const std::map<std::string, std::set<std::string>> grid = makeGrid(5);
+    Dx::DisasterLinks links(grid);
+    Dx::DisasterTags tags(grid);
+    std::atomic<bool> cancel(true);
+    Dx::SearchLimits cancelled;
+    cancelled.cancel = &cancel;
+    Dx::SearchLimits late;
+    late.deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    std::set<std::string> supplies = {};
+    EXPECT(links.isDisasterReady(7, supplies, cancelled) == Dx::SearchStatus::ABORTED);
+    EXPECT(links.isDisasterReady(7, supplies, late) == Dx::SearchStatus::ABORTED);
+    EXPECT(links.isDisasterReady(7, supplies, 4, cancelled) == Dx::SearchStatus::ABORTED);
+    EXPECT(tags.hasDisasterCoverage(7, supplies, 4, late) == Dx::SearchStatus::ABORTED);
+    EXPECT(supplies.empty());
+    cancel = false;
+    EXPECT(links.isDisasterReady(7, supplies, 4, cancelled) == Dx::SearchStatus::FOUND);
+    EXPECT_EQUAL(supplies.size(), 7);
+
+    /*
+     *    A----B    D----E
+     *     \  /      \  /
+     *      C         F
+     */
+    const std::map<std::string, std::set<std::string>> triangles = {
+        {"A", {"B", "C"}}, {"B", {"A", "C"}}, {"C", {"A", "B"}},
+        {"D", {"E", "F"}}, {"E", {"D", "F"}}, {"F", {"D", "E"}},
+    };
+    Dx::PartnerLinks matches(triangles);
+    Dx::SearchLimits noNodes;
+    noNodes.maxNodes = 0;
+    std::set<Pair> pairs = {};
+    EXPECT(matches.hasPerfectLinks(pairs, noNodes) == Dx::SearchStatus::ABORTED);
+    EXPECT(matches.hasPerfectLinks(pairs, 2, noNodes) == Dx::SearchStatus::ABORTED);
+    EXPECT(matches.hasPerfectLinks(pairs, Dx::SearchLimits()) == Dx::SearchStatus::INFEASIBLE);
+    EXPECT(pairs.empty());
+}
+
+STUDENT_TEST("Limits stop a max weight search with the heaviest matching it finished.") {
+    /*
+     *       A --- B --- C
+     *       |     |     |
+     *       F --- E --- D
+     */
+    const std::map<std::string, std::map<std::string, int>> people = {
+        {"A", {{"B", 3}, {"F", 1}}},
+        {"B", {{"A", 3}, {"C", 2}, {"E", 4}}},
+        {"C", {{"B", 2}, {"D", 1}}},
+        {"D", {{"C", 1}, {"E", 5}}},
+        {"E", {{"B", 4}, {"D", 5}, {"F", 2}}},
+        {"F", {{"A", 1}, {"E", 2}}},
+    };
+    auto weightOf = [&](const std::set<Pair>& pairs) {
+        int weight = 0;
+        for (const Pair& pair : pairs) {
+            weight += people.at(pair.first()).at(pair.second());
+        }
+        return weight;
+    };
+    Dx::PartnerLinks weights(people);
+    const std::set<Pair> maximum = weights.getMaxWeightMatching();
+
+    std::atomic<bool> cancel(true);
+    Dx::SearchLimits cancelled;
+    cancelled.cancel = &cancel;
+    cancelled.checkInterval = 1;
+    std::set<Pair> pairs = {};
+    EXPECT(weights.getMaxWeightMatching(pairs, cancelled) == Dx::SearchStatus::ABORTED);
+    EXPECT(pairs.empty());
+
+    // Every node limit leaves a matching no heavier than the maximum and the links as they were.
+    for (long long nodes = 1; nodes <= 8; nodes++) {
+        Dx::SearchLimits limits;
+        limits.maxNodes = nodes;
+        pairs.clear();
+        EXPECT(Dx::getMaxWeightMatching(weights, pairs, limits) == Dx::SearchStatus::ABORTED);
+        EXPECT(weightOf(pairs) <= weightOf(maximum));
+    }
+    pairs.clear();
+    EXPECT(weights.getMaxWeightMatching(pairs, Dx::SearchLimits()) == Dx::SearchStatus::FOUND);
+    EXPECT_EQUAL(pairs, maximum);
+    EXPECT_EQUAL(weights.getMaxWeightMatching(), maximum);
+}
+
+STUDENT_TEST("Limits stop the count of minimal configurations with or without symmetries.") {
+    Dx::NetworkGraph graph(makeGrid(4));
+    Dx::DisasterTags plain(graph);
+    Dx::DisasterTags network(graph);
+    network.setSymmetries(Dx::SymmetryGroup(graph));
+    const std::vector<Dx::DisasterTags::cityHeader> atRest = network.table_;
+    const uint64_t minimal = plain.countMinimalConfigurations(5);
+    EXPECT_EQUAL(network.countMinimalConfigurations(5), minimal);
+    // The orbits take fewer nodes than the plain count so stop before the smaller of the two.
+    const long long needed = network.budget_.getNodes();
+
+    // Whatever node we stop at every option must be permitted and every city uncovered again.
+    for (long long nodes = 1; nodes < needed; nodes += 1 + needed / 16) {
+        Dx::SearchLimits limits;
+        limits.maxNodes = nodes;
+        uint64_t plainCount = 0;
+        uint64_t count = 0;
+        EXPECT(plain.countMinimalConfigurations(5, plainCount, limits) == Dx::SearchStatus::ABORTED);
+        EXPECT(network.countMinimalConfigurations(5, count, limits) == Dx::SearchStatus::ABORTED);
+        EXPECT(plainCount < minimal);
+        EXPECT(network.table_ == atRest);
+        EXPECT_EQUAL(network.chosenKey_, 0);
+        EXPECT_EQUAL(network.forbiddenKey_, 0);
+    }
+    uint64_t count = 0;
+    EXPECT(network.countMinimalConfigurations(5, count, Dx::SearchLimits())
+           == Dx::SearchStatus::FOUND);
+    EXPECT_EQUAL(count, minimal);
+    EXPECT_EQUAL(plain.countMinimalConfigurations(5), minimal);
+}
@@ -0,0 +1,84 @@
+#include "Src/SearchStats.h"
+#include "Src/DisasterLinks.h"
+#include "Src/DisasterTags.h"
+#include "Src/PartnerLinks.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * *    Search Statistics Tests     * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("Disaster searches count nodes by depth, updates, mems, and covers if enabled.") {
+    /*
+     *      A----B----C
+     */
+    const std::map<std::string, std::set<std::string>> path = {
+        {"A", {"B"}}, {"B", {"A", "C"}}, {"C", {"B"}},
+    };
+    Dx::DisasterLinks links(path);
+    Dx::DisasterTags tags(path);
+    std::set<std::string> supplies = {};
+    EXPECT(links.isDisasterReady(1, supplies));
+    EXPECT(tags.hasDisasterCoverage(1, supplies));
+    EXPECT_EQUAL(supplies, {"B"});
+    for (const Dx::SearchStats& stats : {links.getSearchStats(), tags.getSearchStats()}) {
+        if (Dx::SearchStats::isEnabled()) {
+            // One supply is one choice so no node lies deeper than the first level.
+            EXPECT_EQUAL(stats.nodesPerDepth.size(), 2);
+            EXPECT_EQUAL(stats.nodesPerDepth[0], 1);
+            EXPECT_EQUAL(stats.solutions, 1);
+            EXPECT(stats.updates > 0);
+            EXPECT(stats.mems > stats.updates);
+        } else {
+            EXPECT(stats.nodesPerDepth.empty());
+            EXPECT_EQUAL(stats.updates, 0);
+            EXPECT_EQUAL(stats.mems, 0);
+            EXPECT_EQUAL(stats.solutions, 0);
+        }
+    }
+
+    // Counts accumulate over searches until they are reset.
+    long long firstNodes = links.getSearchStats().getNodes();
+    EXPECT(links.isDisasterReady(1, supplies));
+    EXPECT_EQUAL(links.getSearchStats().getNodes(), 2 * firstNodes);
+    links.resetSearchStats();
+    EXPECT_EQUAL(links.getSearchStats().getNodes(), 0);
+    EXPECT_EQUAL(links.getSearchStats().mems, 0);
+}
+
+STUDENT_TEST("Perfect matchings of four friends fill a search tree of known shape if enabled.") {
+    /*
+     * Whoever we choose first has three partners and each choice leaves one pair to make.
+     *
+     *      A----B
+     *      | \/ |
+     *      | /\ |
+     *      C----D
+     */
+    const std::map<std::string, std::set<std::string>> friends = {
+        {"A", {"B", "C", "D"}},
+        {"B", {"A", "C", "D"}},
+        {"C", {"A", "B", "D"}},
+        {"D", {"A", "B", "C"}},
+    };
+    Dx::PartnerLinks matches(friends);
+    EXPECT_EQUAL(matches.countPerfectLinks(), 3);
+    const Dx::SearchStats& stats = matches.getSearchStats();
+    if (Dx::SearchStats::isEnabled()) {
+        EXPECT(stats.nodesPerDepth == std::vector<long long>({1, 3, 3}));
+        EXPECT_EQUAL(stats.solutions, 3);
+        EXPECT_EQUAL(stats.depth, 0);
+        EXPECT(stats.updates > 0);
+    } else {
+        EXPECT_EQUAL(stats.getNodes(), 0);
+    }
+    matches.resetSearchStats();
+    std::set<Pair> pairs = {};
+    EXPECT(matches.hasPerfectLinks(pairs));
+    if (Dx::SearchStats::isEnabled()) {
+        EXPECT(matches.getSearchStats().nodesPerDepth == std::vector<long long>({1, 1, 1}));
+        EXPECT_EQUAL(matches.getSearchStats().solutions, 1);
+    }
+}
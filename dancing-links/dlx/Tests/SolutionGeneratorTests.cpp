@@ -0,0 +1,118 @@
+#include "Src/SolutionGenerator.h"
+#include "Src/DisasterLinks.h"
+#include "Src/DisasterTags.h"
+#include "Src/PartnerLinks.h"
+#include "Src/DisasterUtilities.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * *    Solution Generator Tests    * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("Generated disaster configurations arrive one at a time in the unique order.") {
+    /*
+     *        A----B----C
+     *        |    |    |
+     *        D----E----F----G
+     */
+    const std::map<std::string, std::set<std::string>> cities = makeMap({
+        {"A", {"B", "D"}},
+        {"B", {"C", "E"}},
+        {"C", {"F"}},
+        {"D", {"E"}},
+        {"E", {"F"}},
+        {"F", {"G"}},
+    });
+    Dx::DisasterLinks links(cities);
+    Dx::DisasterTags tags(cities);
+    for (int numSupplies = 1; numSupplies <= 3; numSupplies++) {
+        Dx::SolutionGenerator<Dx::DisasterLinks,int> fromLinks(links, numSupplies);
+        Dx::SolutionGenerator<Dx::DisasterTags,int> fromTags(tags, numSupplies);
+        std::vector<std::set<std::string>> linksFound = {};
+        std::vector<std::set<std::string>> tagsFound = {};
+        std::vector<int> supplies = {};
+        while (fromLinks.next(supplies)) {
+            linksFound.emplace_back();
+            for (int option : supplies) {
+                linksFound.back().insert(links.getSupplyName(option));
+            }
+        }
+        while (fromTags.next(supplies)) {
+            tagsFound.emplace_back();
+            for (int option : supplies) {
+                tagsFound.back().insert(tags.getSupplyName(option));
+            }
+        }
+        EXPECT(fromLinks.isExhausted());
+        EXPECT(!fromLinks.next(supplies));
+        EXPECT(linksFound == links.getUniqueDisasterConfigurations(numSupplies));
+        EXPECT(tagsFound == tags.getUniqueDisasterConfigurations(numSupplies));
+    }
+}
+
+STUDENT_TEST("A generator may be abandoned part way and leaves its solver untouched.") {
+    std::map<std::string, std::set<std::string>> grid;
+    for (char row = 'A'; row <= 'D'; row++) {
+        for (int col = 1; col <= 4; col++) {
+            grid[row + std::to_string(col)];
+            if (row != 'D') {
+                grid[row + std::to_string(col)].insert((char(row + 1) + std::to_string(col)));
+            }
+            if (col != 4) {
+                grid[row + std::to_string(col)].insert((char(row) + std::to_string(col + 1)));
+            }
+        }
+    }
+    grid = makeMap(grid);
+    Dx::DisasterLinks network(grid);
+    std::vector<std::set<std::string>> all = network.getUniqueDisasterConfigurations(4);
+    EXPECT(all.size() > 1);
+    {
+        Dx::SolutionGenerator<Dx::DisasterLinks,int> generator(network, 4);
+        std::vector<int> supplies = {};
+        EXPECT(generator.next(supplies));
+        std::set<std::string> first = {};
+        for (int option : supplies) {
+            first.insert(network.getSupplyName(option));
+        }
+        EXPECT_EQUAL(first, all[0]);
+        EXPECT(!generator.isExhausted());
+    }
+    EXPECT(network.getUniqueDisasterConfigurations(4) == all);
+}
+
+STUDENT_TEST("Perfect matchings are generated in the same order they are listed.") {
+    /*
+     *       A --- B --- C
+     *       |     |     |
+     *       F --- E --- D
+     */
+    const std::map<std::string, std::set<std::string>> provided = {
+        {"A", {"B", "F"}},
+        {"B", {"A", "C", "E"}},
+        {"C", {"B", "D"}},
+        {"D", {"C", "E"}},
+        {"E", {"B", "D", "F"}},
+        {"F", {"A", "E"}},
+    };
+    Dx::PartnerLinks network(provided);
+    Dx::SolutionGenerator<Dx::PartnerLinks,Pair> generator(network, provided.size() / 2);
+    std::vector<std::set<Pair>> found = {};
+    std::vector<Pair> pairs = {};
+    while (generator.next(pairs)) {
+        found.emplace_back(pairs.begin(), pairs.end());
+    }
+    EXPECT_EQUAL(found.size(), 3);
+    EXPECT_EQUAL(found, network.getAllPerfectLinks());
+
+    const std::map<std::string, std::set<std::string>> triangle = {
+        {"A", {"B", "C"}},
+        {"B", {"A", "C"}},
+        {"C", {"A", "B"}},
+    };
+    Dx::PartnerLinks odd(triangle);
+    Dx::SolutionGenerator<Dx::PartnerLinks,Pair> none(odd, 2);
+    EXPECT(!none.next(pairs));
+}
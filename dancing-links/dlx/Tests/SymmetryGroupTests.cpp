@@ -0,0 +1,69 @@
+#include "Src/SymmetryGroup.h"
+#include "GenericOverloads.h"
+
+namespace Dx = DancingLinks;
+
+
+/* * * * * * * * * * * * * * * * * * * *  Symmetry Group Tests  * * * * * * * * * * * * * * * * * */
+
+
+STUDENT_TEST("Detection finds the eight symmetries of a grid and the two of a path.") {
+    Dx::NetworkGraph grid(makeGrid(4));
+    Dx::SymmetryGroup gridGroup(grid);
+    EXPECT_EQUAL(gridGroup.size(), 8);
+    EXPECT(gridGroup.isComplete());
+    EXPECT(gridGroup.getElement(0) == std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7,
+                                                         8, 9, 10, 11, 12, 13, 14, 15}));
+    for (int index = 0; index < gridGroup.size(); index++) {
+        const std::vector<int>& element = gridGroup.getElement(index);
+        for (int city = 0; city < grid.numVertices(); city++) {
+            for (int arc = grid.arcsBegin(city); arc < grid.arcsEnd(city); arc++) {
+                EXPECT(Dx::SymmetryGroup::isRoad(grid, element[city],
+                                                 element[grid.neighbor(arc)]));
+            }
+        }
+    }
+
+    /*
+     *        A----B----C----D
+     */
+    const std::map<std::string, std::set<std::string>> roads = {
+        {"A", {"B"}},
+        {"B", {"A", "C"}},
+        {"C", {"B", "D"}},
+        {"D", {"C"}},
+    };
+    Dx::SymmetryGroup pathGroup{Dx::NetworkGraph(roads)};
+    EXPECT_EQUAL(pathGroup.size(), 2);
+    EXPECT(pathGroup.getElement(1) == std::vector<int>({3, 2, 1, 0}));
+
+    // A group cut short at its limit holds only true symmetries but is not complete.
+    Dx::SymmetryGroup partial(grid, 3);
+    EXPECT_EQUAL(partial.size(), 3);
+    EXPECT(!partial.isComplete());
+}
+
+STUDENT_TEST("Generators close into their group and anything that breaks a road is rejected.") {
+    Dx::NetworkGraph grid(makeGrid(3));
+    std::vector<int> rotation(9);
+    std::vector<int> reflection(9);
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            rotation[row * 3 + col] = col * 3 + (2 - row);
+            reflection[row * 3 + col] = row * 3 + (2 - col);
+        }
+    }
+    Dx::SymmetryGroup rotations(grid, {rotation});
+    EXPECT_EQUAL(rotations.size(), 4);
+    EXPECT(rotations.isComplete());
+    Dx::SymmetryGroup all(grid, {rotation, reflection});
+    EXPECT_EQUAL(all.size(), 8);
+    EXPECT(all.isComplete());
+    EXPECT_EQUAL(Dx::SymmetryGroup(grid, {rotation, reflection}, 5).size(), 5);
+
+    std::vector<int> cornerAndCenter = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    std::swap(cornerAndCenter[0], cornerAndCenter[4]);
+    EXPECT_ERROR(Dx::SymmetryGroup(grid, {cornerAndCenter}));
+    EXPECT_ERROR(Dx::SymmetryGroup(grid, {{0, 1, 2}}));
+    EXPECT_ERROR(Dx::SymmetryGroup(grid, {{0, 0, 2, 3, 4, 5, 6, 7, 8}}));
+}